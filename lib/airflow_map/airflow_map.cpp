@@ -0,0 +1,125 @@
+#include "airflow_map.h"
+#include <math.h>
+#include <string.h>
+
+#define SAME_POINT_PCT 0.5f
+
+static const float HALF_PI_F = 1.5707963f;
+
+void airflow_map_clear(airflow_map_t* map) {
+    memset(map, 0, sizeof(*map));
+}
+
+// Impulsa virziens: +1 augošs, -1 dilstošs, 0 vēl nav zināms
+static int direction(float from, float to) {
+    return to > from ? 1 : (to < from ? -1 : 0);
+}
+
+bool airflow_map_valid(const airflow_map_t* map) {
+    if (map->count > AIRFLOW_MAP_MAX_POINTS) {
+        return false;
+    }
+    int trend = 0;
+    for (uint8_t i = 1; i < map->count; i++) {
+        const airflow_map_point_t* a = &map->points[i - 1];
+        const airflow_map_point_t* b = &map->points[i];
+        if (b->airflowPct <= a->airflowPct) {
+            return false;
+        }
+        const int step = direction(a->micros, b->micros);
+        if (step == 0 || (trend != 0 && step != trend)) {
+            return false;
+        }
+        trend = step;
+    }
+    return true;
+}
+
+bool airflow_map_set(airflow_map_t* map, float airflowPct, float micros) {
+    airflow_map_t candidate = *map;
+
+    uint8_t index = 0;
+    while (index < candidate.count && candidate.points[index].airflowPct < airflowPct - SAME_POINT_PCT) {
+        index++;
+    }
+    // Divi punkti var būt ±0.5 % robežās - aizstājam tuvāko
+    if (index + 1 < candidate.count &&
+        fabsf(candidate.points[index + 1].airflowPct - airflowPct) <
+            fabsf(candidate.points[index].airflowPct - airflowPct)) {
+        index++;
+    }
+
+    const bool replace = index < candidate.count &&
+                         fabsf(candidate.points[index].airflowPct - airflowPct) <= SAME_POINT_PCT;
+    if (!replace) {
+        if (candidate.count >= AIRFLOW_MAP_MAX_POINTS) {
+            return false;
+        }
+        memmove(&candidate.points[index + 1], &candidate.points[index],
+                (candidate.count - index) * sizeof(candidate.points[0]));
+        candidate.count++;
+        candidate.points[index].airflowPct = airflowPct;
+    }
+    // Aizstājot punkta plūsma paliek, mainās tikai impulss
+    candidate.points[index].micros = micros;
+
+    if (!airflow_map_valid(&candidate)) {
+        return false;
+    }
+    *map = candidate;
+    return true;
+}
+
+bool airflow_map_remove(airflow_map_t* map, float airflowPct) {
+    for (uint8_t i = 0; i < map->count; i++) {
+        if (fabsf(map->points[i].airflowPct - airflowPct) <= SAME_POINT_PCT) {
+            memmove(&map->points[i], &map->points[i + 1],
+                    (map->count - i - 1) * sizeof(map->points[0]));
+            map->count--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool airflow_map_active(const airflow_map_t* map) {
+    return map->count >= 2;
+}
+
+float airflow_map_micros(const airflow_map_t* map, float airflowPct) {
+    const airflow_map_point_t* p = map->points;
+    const uint8_t n = map->count;
+    if (n == 0) {
+        return 0.0f;
+    }
+    if (airflowPct <= p[0].airflowPct) {
+        return p[0].micros;
+    }
+    if (airflowPct >= p[n - 1].airflowPct) {
+        return p[n - 1].micros;
+    }
+    uint8_t i = 1;
+    while (p[i].airflowPct < airflowPct) {
+        i++;
+    }
+    const float frac = (airflowPct - p[i - 1].airflowPct) / (p[i].airflowPct - p[i - 1].airflowPct);
+    return p[i - 1].micros + frac * (p[i].micros - p[i - 1].micros);
+}
+
+void airflow_map_fill_butterfly(airflow_map_t* map, float closedMicros, float openMicros, uint8_t points) {
+    if (points < 2) {
+        points = 2;
+    }
+    if (points > AIRFLOW_MAP_MAX_POINTS) {
+        points = AIRFLOW_MAP_MAX_POINTS;
+    }
+    airflow_map_clear(map);
+    for (uint8_t i = 0; i < points; i++) {
+        const float flow = (float)i / (points - 1);
+        // Inversā funkcija: θ = acos(1 - plūsma)
+        const float opening = acosf(1.0f - flow) / HALF_PI_F;
+        map->points[i].airflowPct = flow * 100.0f;
+        map->points[i].micros = closedMicros + (openMicros - closedMicros) * opening;
+    }
+    map->count = points;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Airflow Map - damper gaisa plūsmas % -> servo impulsa (us) kalibrācijas tabula
+ *
+ * Regulators rēķina gaisa plūsmu procentos, bet vārsta plūsma nav lineāra
+ * pret servo leņķi: tauriņvārsts pirmajos grādos gandrīz nelaiž gaisu, bet
+ * pie 40-60 % tā pati leņķa maiņa dod lielāko plūsmas pieaugumu. Tabula
+ * pārvērš plūsmas % impulsā tā, lai regulators redz aptuveni lineāru
+ * izpildmehānismu (un kP derētu visā diapazonā).
+ *
+ * Punkti ir sakārtoti pēc plūsmas, impulss ir monotons (augošs vai dilstošs -
+ * atkarīgs no servo uzstādīšanas). Starp punktiem lineāra interpolācija,
+ * ārpus tiem - galējais punkts. Mazāk par 2 punktiem = tabula neaktīva.
+ *
+ * Struktūra ir POD - to var glabāt NVS ar putBytes().
+ */
+
+#define AIRFLOW_MAP_MAX_POINTS 11
+
+typedef struct {
+    float airflowPct;
+    float micros;
+} airflow_map_point_t;
+
+typedef struct {
+    uint8_t count;
+    airflow_map_point_t points[AIRFLOW_MAP_MAX_POINTS];
+} airflow_map_t;
+
+void airflow_map_clear(airflow_map_t* map);
+
+// Pievieno vai aizstāj tuvāko punktu (±0.5 %; tā plūsma paliek). false, ja
+// tabula pilna vai impulss pārkāptu monotonitāti
+bool airflow_map_set(airflow_map_t* map, float airflowPct, float micros);
+
+bool airflow_map_remove(airflow_map_t* map, float airflowPct);
+
+bool airflow_map_active(const airflow_map_t* map);
+
+// Impulss (us) dotajai plūsmai
+float airflow_map_micros(const airflow_map_t* map, float airflowPct);
+
+// No NVS nolasītas tabulas pārbaude (skaits, secība, monotonitāte)
+bool airflow_map_valid(const airflow_map_t* map);
+
+/**
+ * Teorētiska tauriņvārsta tabula: atvērtais laukums ∝ 1 - cos θ, θ = 0..90°.
+ * closedMicros un openMicros - impulsi pilnīgi aizvērtam un atvērtam vārstam.
+ */
+void airflow_map_fill_butterfly(airflow_map_t* map, float closedMicros, float openMicros, uint8_t points);
@@ -0,0 +1,73 @@
+#include "buzzer_pattern.h"
+#include <string.h>
+
+typedef struct {
+    const char* name;
+    const uint16_t* stepsMs;
+    uint8_t stepCount;
+} buzzer_pattern_t;
+
+// Pāra soļi skan, nepāra - klusums; pēc pēdējā soļa cikls sākas no jauna
+static const uint16_t OVER_TEMP_STEPS[] = {100, 100};
+static const uint16_t SENSOR_FAULT_STEPS[] = {500, 500};
+static const uint16_t BURNOUT_STEPS[] = {1000, 500, 1000, 500, 1000, 30000};
+static const uint16_t REFILL_STEPS[] = {150, 150, 150, 60000};
+
+#define STEPS(a) a, (uint8_t)(sizeof(a) / sizeof(a[0]))
+
+static const buzzer_pattern_t PATTERNS[BUZZER_PATTERN_COUNT] = {
+    {"parkarsana", STEPS(OVER_TEMP_STEPS)},
+    {"sensors", STEPS(SENSOR_FAULT_STEPS)},
+    {"izdegusi", STEPS(BURNOUT_STEPS)},
+    {"malka", STEPS(REFILL_STEPS)},
+};
+
+const char* buzzer_pattern_name(buzzer_pattern_id_t id) {
+    return id < BUZZER_PATTERN_COUNT ? PATTERNS[id].name : "klusums";
+}
+
+bool buzzer_pattern_from_name(const char* name, buzzer_pattern_id_t* id) {
+    for (uint8_t i = 0; i < BUZZER_PATTERN_COUNT; i++) {
+        if (strcmp(name, PATTERNS[i].name) == 0) {
+            *id = (buzzer_pattern_id_t)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+buzzer_pattern_id_t buzzer_pattern_select(uint8_t activeMask, uint8_t mutedMask) {
+    const uint8_t audible = activeMask & (uint8_t)~mutedMask;
+    for (uint8_t i = 0; i < BUZZER_PATTERN_COUNT; i++) {
+        if (audible & BUZZER_PATTERN_BIT(i)) {
+            return (buzzer_pattern_id_t)i;
+        }
+    }
+    return BUZZER_PATTERN_NONE;
+}
+
+void buzzer_player_init(buzzer_player_t* player) {
+    player->pattern = BUZZER_PATTERN_NONE;
+    player->step = 0;
+}
+
+bool buzzer_player_select(buzzer_player_t* player, buzzer_pattern_id_t id) {
+    if (id == player->pattern) {
+        return false;
+    }
+    player->pattern = id;
+    player->step = 0;
+    return true;
+}
+
+uint32_t buzzer_player_next(buzzer_player_t* player, bool* level) {
+    if (player->pattern >= BUZZER_PATTERN_COUNT) {
+        *level = false;
+        return 0;
+    }
+    const buzzer_pattern_t* pattern = &PATTERNS[player->pattern];
+    *level = (player->step & 1) == 0;
+    const uint32_t durationMs = pattern->stepsMs[player->step];
+    player->step = (uint8_t)((player->step + 1) % pattern->stepCount);
+    return durationMs;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Buzzer Pattern - nosauktu skaņas rakstu izvēle un soļu secība
+ *
+ * Katrs raksts ir cikliska ilgumu (ms) virkne: pāra soļi - skan, nepāra -
+ * klusums. Vienlaikus var būt aktīvi vairāki raksti; skan tas ar augstāko
+ * prioritāti (mazākais numurs), kas nav apklusināts. Apklusinājums attiecas
+ * uz konkrētu rakstu, tāpēc jauns, svarīgāks brīdinājums atkal skan.
+ *
+ * Bez Arduino atkarībām: izsaucējs pēc buzzer_player_next() uzstāda izeju
+ * un ieplāno nākamo soli (piem., ar vienreizēju taimeri).
+ */
+
+typedef enum {
+    BUZZER_PATTERN_OVER_TEMP = 0,   // Pārkaršana - augstākā prioritāte
+    BUZZER_PATTERN_SENSOR_FAULT,    // Nav derīga sensora rādījuma
+    BUZZER_PATTERN_BURNOUT,         // Krāsns izdegusi
+    BUZZER_PATTERN_REFILL,          // Jāpiekrauj malka
+    BUZZER_PATTERN_COUNT
+} buzzer_pattern_id_t;
+
+#define BUZZER_PATTERN_NONE BUZZER_PATTERN_COUNT
+
+#define BUZZER_PATTERN_BIT(id) ((uint8_t)(1u << (id)))
+
+typedef struct {
+    buzzer_pattern_id_t pattern;   // BUZZER_PATTERN_NONE = klusums
+    uint8_t step;
+} buzzer_player_t;
+
+const char* buzzer_pattern_name(buzzer_pattern_id_t id);
+bool buzzer_pattern_from_name(const char* name, buzzer_pattern_id_t* id);
+
+// Svarīgākais aktīvais, neapklusinātais raksts (vai BUZZER_PATTERN_NONE)
+buzzer_pattern_id_t buzzer_pattern_select(uint8_t activeMask, uint8_t mutedMask);
+
+void buzzer_player_init(buzzer_player_t* player);
+
+// Pāriet uz rakstu; ja tas mainās, sāk no pirmā soļa. true = mainījās
+bool buzzer_player_select(buzzer_player_t* player, buzzer_pattern_id_t id);
+
+// Nākamais solis: *level - izeja, atgriež soļa ilgumu ms (0 = klusums bez taimera)
+uint32_t buzzer_player_next(buzzer_player_t* player, bool* level);
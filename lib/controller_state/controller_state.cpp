@@ -0,0 +1,50 @@
+#include "controller_state.h"
+#include <atomic>
+#include <string.h>
+
+// Seqlock: nepāra secība = rakstīšana notiek, lasītājs mēģina vēlreiz
+static std::atomic<uint32_t> sequence(0);
+static controller_state_t published;
+
+static std::atomic<int> servoPosition(0);
+static std::atomic<bool> servoIsMoving(false);
+
+void controller_state_publish(const controller_state_t* state) {
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy(&published, state, sizeof(published));
+
+    std::atomic_thread_fence(std::memory_order_release);
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+bool controller_state_read(controller_state_t* out) {
+    uint32_t before;
+    uint32_t after;
+    do {
+        before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;  // Rakstītājs ir pusceļā (cits kodols) - mēģinām vēlreiz
+        }
+        memcpy(out, &published, sizeof(*out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    return before != 0;
+}
+
+void controller_state_set_servo(int position, bool moving) {
+    servoPosition.store(position, std::memory_order_relaxed);
+    servoIsMoving.store(moving, std::memory_order_release);
+}
+
+int controller_state_servo_position() {
+    return servoPosition.load(std::memory_order_relaxed);
+}
+
+bool controller_state_servo_moving() {
+    return servoIsMoving.load(std::memory_order_acquire);
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <stdint.h>
+#include "fire_detector.h"
+
+/**
+ * Controller State - regulatora stāvokļa momentuzņēmums starp uzdevumiem
+ *
+ * Kontroles uzdevums (vienīgais rakstītājs) pēc katra soļa publicē visu
+ * stāvokli vienā struktūrā. Servo uzdevums, displejs, telnet un Telegram
+ * to nolasa bez slēdzenēm un bez heap: seqlock garantē, ka lasītājs
+ * vienmēr saņem vienā solī publicētas vērtības, nevis pusi no iepriekšējā
+ * un pusi no nākamā.
+ *
+ * Servo faktiskā pozīcija un kustības statuss pieder servo uzdevumam, tāpēc
+ * tie ir atsevišķi atomiski mainīgie (controller_state_set_servo()).
+ */
+
+// Vārsta režīms. Uzraksti nāk no DAMPER_MODE_LABELS, nevis no String.
+typedef enum : uint8_t {
+    DAMPER_MODE_MANUAL = 0,   // Vārstu vada lietotājs
+    DAMPER_MODE_AUTO,         // PID regulators
+    DAMPER_MODE_FILL,         // Temperatūra krīt - jāpiekrauj malka
+    DAMPER_MODE_END,          // Kurināšana beigusies
+    DAMPER_MODE_TUNE,         // Autotune eksperiments (pid_autotune.h)
+    DAMPER_MODE_COUNT
+} damper_mode_t;
+
+constexpr const char* DAMPER_MODE_LABELS[DAMPER_MODE_COUNT] = {
+    "MANUAL",
+    "AUTO",
+    "FILL!",
+    "END!",
+    "TUNE",
+};
+
+constexpr const char* damper_mode_label(damper_mode_t mode) {
+    return mode < DAMPER_MODE_COUNT ? DAMPER_MODE_LABELS[mode] : "?";
+}
+
+// Temperatūras kanāli uz kopīgās OneWire kopnes (sk. temperature_sensor.h)
+typedef enum : uint8_t {
+    TEMP_CHANNEL_FLUE = 0,    // Dūmgāzes - PID ieeja
+    TEMP_CHANNEL_ROOM,        // Istaba
+    TEMP_CHANNEL_WATER,       // Ūdens apvalks
+    TEMP_CHANNEL_COUNT
+} temp_channel_t;
+
+// Telnet komandām un izvadam (ASCII)
+constexpr const char* TEMP_CHANNEL_LABELS[TEMP_CHANNEL_COUNT] = {
+    "dumi",
+    "istaba",
+    "udens",
+};
+
+constexpr const char* temp_channel_label(temp_channel_t channel) {
+    return channel < TEMP_CHANNEL_COUNT ? TEMP_CHANNEL_LABELS[channel] : "?";
+}
+
+typedef struct {
+    uint32_t step;                 // Regulatora soļa numurs
+    unsigned long timestampMs;     // Kad stāvoklis publicēts
+
+    float temperature;             // Regulatora pēdējais rādījums (°C, filtrēts)
+    float channelC[TEMP_CHANNEL_COUNT];  // Visi kanāli (°C, filtrēti)
+    uint8_t channelValidMask;      // 1 << kanāls, ja kanālam ir derīgs rādījums
+    int targetTemp;
+    float roomTargetC;             // Kaskādes istabas mērķis
+    bool cascadeActive;            // targetTemp nosaka istabas cilpa
+    int damper;                    // Mērķa pozīcija servo uzdevumam (0-100%)
+    damper_mode_t mode;
+    bool lowTempCheckActive;
+
+    float errP;
+    float errI;
+    float errD;
+    float pTerm;
+    float iTerm;
+    float dTerm;
+    float ffTerm;                  // Feed-forward daļa (%, pieskaitīta PID izejai)
+    float kpScale;                 // Pastiprinājumu grafika reizinātāji šajā solī
+    float tauIScale;
+
+    fire_phase_t firePhase;        // Kurināšanas fāze (fire_detector.h)
+    float trendCPerMin;            // Temperatūras slīpums
+} controller_state_t;
+
+// Rakstītājs: tikai kontroles uzdevums
+void controller_state_publish(const controller_state_t* state);
+
+// Lasītāji: jebkurš uzdevums. Atgriež false, ja vēl nekas nav publicēts.
+bool controller_state_read(controller_state_t* out);
+
+// Servo uzdevuma stāvoklis
+void controller_state_set_servo(int position, bool moving);
+int controller_state_servo_position();
+bool controller_state_servo_moving();
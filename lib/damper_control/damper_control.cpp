@@ -3,14 +3,28 @@
 #include <ESP32Servo.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/timers.h>
+#include <freertos/semphr.h>
+#include <atomic>
 #include "temperature.h" 
 #include "touch_button.h"
 #include "display_manager.h"
-#include "telnet.h"
+#include "logger.h"
+#include "recorder.h"
+#include "pid_controller.h"
+#include "controller_state.h"
+#include "fire_detector.h"
+#include "pid_autotune.h"
+#include "gain_schedule.h"
+#include "servo_motion.h"
+#include "airflow_map.h"
+#include "buzzer_pattern.h"
+#include "settings_storage.h"
 
 // Servo un kontroles mainīgie
 Servo mansServo;
-String messageDamp = "MANUAL";
+damper_mode_t damperMode = DAMPER_MODE_MANUAL;
 
 // Servo konfigurācija
 static bool servoAttached = false;
@@ -33,105 +47,253 @@ int oldDamper = 0;
 // Uzdevuma rokturis
 TaskHandle_t damperTaskHandle = NULL;
 
-// PID kontroliera parametri
+// PID kontroliera parametri (tauI un tauD sekundēs)
 float refillTrigger = 5000;
 float endTrigger = 10000;
 int kP = 25;
 float tauI = 1000;
 float tauD = 5;
 float kI = kP / tauI;
-float kD = kP / tauD;
+float kD = kP * tauD;
 
-// Temperatūras vēstures masīvs un PID mainīgie
-int TempHist[10] = {0};
-float errP = 0;
-float errI = 0;
-float errD = 0;
-float errOld = 0;
+// Kurināšanas fāžu detektors (viens rādījums katrā regulatora solī)
+static fire_detector_t fireDetector;
+static unsigned long lastRefuelMs = 0;     // Pēdējais IGNITION/REFUEL (0 = nav bijis)
 
-// Asinhronās servo kustības mainīgie
+// Feed-forward: damper priekšpozicionēšana pēc kāpuma un laika kopš piekraušanas
+float ffTrendGain = 30.0f;     // % aizvēršana uz °C/min kāpuma virs sliekšņa
+float ffRefillBoost = 0.0f;    // Papildu pastiprinājums uzreiz pēc piekraušanas (× ffTrendGain)
+float ffRefillTauS = 1200.0f;  // Pastiprinājuma dzišanas laika konstante (s)
+float ffTerm = 0;
+int woodFillRecentS = 120;   // Slīpuma (trenda) loga garums (s)
+int woodFillOlderS = 120;    // Iepriekšējā loga garums, ar ko REFUEL salīdzina (s)
+
+// PID mainīgie
+float errP = 0;   // Kļūda (targetTempC - temperature)
+float errI = 0;   // Uzkrātais temperatūras deficīts FILL!/END! noteikšanai
+float errD = 0;   // Filtrēts temperatūras atvasinājums (-dT/dt, °C/s)
+
+// PID regulators damper pozīcijai
+PidController damperPid(0, 100);
+static unsigned long lastControlTime = 0;
+
+// Tabulu nodošana uzdevumiem: loop() publicē visu jauno tabulu, uzdevums to
+// kopē sev; abi zem tableLock, lai kopijā nav puse vecās un puse jaunās tabulas.
+// Pirms startDamperControlTask() uzdevumu vēl nav, tāpēc bez slēdzenes
+static SemaphoreHandle_t tableLock = NULL;
+
+static void tableLockTake() {
+    if (tableLock != NULL) {
+        xSemaphoreTake(tableLock, portMAX_DELAY);
+    }
+}
+
+static void tableLockGive() {
+    if (tableLock != NULL) {
+        xSemaphoreGive(tableLock);
+    }
+}
+
+// Pastiprinājumu grafiks. gainSchedule raksta tikai damperControlSetGainSchedule()
+// no loop(); kontroles uzdevums strādā ar savu kopiju
+gain_schedule_t gainSchedule = {0};
+static gain_schedule_t activeGainSchedule = {0};
+static volatile bool gainScheduleChanged = true;
+static gain_schedule_point_t gainScale = {0, 1.0f, 1.0f};   // Pēdējā soļa reizinātāji
+
+// Autotune eksperiments; pieprasījumi nāk no telnet (loop()), izpilda kontroles uzdevums
+static pid_autotune_t autotune;
+static volatile float autotuneRequestPct = 0;   // > 0 = sākt ar šādu lēcienu
+static volatile bool autotuneAbortRequested = false;
+// Rezultātu kontroles uzdevums tikai novieto; kP/tauI un NVS maina loop()
+static volatile int autotuneResultKp = 0;
+static volatile float autotuneResultTauI = 0;
+static volatile bool autotuneResultReady = false;
+
+// Kaskāde: ārējā cilpa no istabas temperatūras kļūdas nosaka targetTempC.
+// kP ir °C dūmgāzu mērķa uz °C istabas kļūdas, tauI sekundēs
+bool cascadeEnabled = false;
+float roomTargetC = 21.0f;
+float cascadeKp = 4.0f;
+float cascadeTauI = 3600.0f;
+PidController roomPid(64, 80, 300.0f);
+static unsigned long lastCascadeTime = 0;
+static int cascadeTargetC = 0;      // Ko ārējā cilpa pēdējo reizi ierakstīja targetTempC
+static bool cascadeActive = false;  // Ārējā cilpa šobrīd nosaka mērķi
+
+// Kontroles uzdevums un sensora rinda
+TaskHandle_t controlTaskHandle = NULL;
+static QueueHandle_t sensorQueue = NULL;
+static float controlTemperature = 0;   // Pēdējais regulatora saņemtais rādījums (°C)
+static float controlChannelC[TEMP_CHANNEL_COUNT] = {0};  // Visi kanāli (istaba - kaskādei)
+static uint8_t controlChannelValid = 0;
+static bool controlHasSample = false;
+static temperature_sample_t traceSample;     // Pēdējais rādījums trasei (recorder.h)
+static bool traceSamplePending = false;
+
+// Kontroles uzdevuma perioda statistika
+static control_task_stats_t controlStats = {0};
+static unsigned long lastControlStepUs = 0;
+
+// Asinhronās servo kustības mainīgie (pieder servo uzdevumam)
+static servo_motion_t servoMotion;
+static bool servoMotionReady = false;
 static int targetDamper = 0;
-static int currentDamper = 0;
-bool servoMoving = false;
+static bool servoMoving = false;   // Citi lasa controller_state_servo_moving()
 static TickType_t lastMoveTime = 0;
-int servoStepInterval = 50;  // Servo kustības solis milisekundēs (var mainīt no iestatījumiem)
+static int lastServoTicks = -1;    // Pēdējais uzrakstītais impulss (LEDC soļos)
+static int8_t servoMoveDirection = 0;   // +1 vaļā, -1 ciet (backlash puse), 0 vēl nav kustējies
+static int lastSuppressedDamper = -1;
+static servo_actuator_stats_t servoStats = {0};
+int servoStepInterval = 10;  // Maksimālais ātrums: ms uz 1 % (var mainīt no iestatījumiem)
+int servoDeadbandPct = 2;    // Mazākas izmaiņas (izņemot galējās pozīcijas) servo nekustina
+float servoBacklashPct = 0;  // Sviras brīvkustība; virziena maiņā servo iet tālāk par pusi no tās
 
-// Zemas temperatūras pārbaudes mainīgie
-static unsigned long lowTempStartTime = 0;
+// Gaisa plūsmas tabula (airflow_map.h): damper % ir plūsma, tabula dod impulsu.
+// airflowMap raksta tikai damperControlSetAirflowMap() no loop(); servo uzdevums
+// strādā ar savu kopiju
+airflow_map_t airflowMap = {0};
+static airflow_map_t activeAirflowMap = {0};
+static volatile bool airflowMapChanged = true;
+
+// Vadītā kalibrācija (telnet "airflow kalib"): kamēr aktīva, servo uzdevums
+// tur servo uz airflowCalibrationMicros un regulatora mērķi neizpilda
+static const float AIRFLOW_CALIBRATION_POINTS[] = {0, 10, 25, 50, 75, 100};
+#define AIRFLOW_CALIBRATION_COUNT (sizeof(AIRFLOW_CALIBRATION_POINTS) / sizeof(AIRFLOW_CALIBRATION_POINTS[0]))
+static volatile bool airflowCalibrationActive = false;
+static volatile float airflowCalibrationMicros = 0;
+static uint8_t airflowCalibrationStep = 0;
+static airflow_map_t airflowCalibrationMap;
+static bool servoCalibrating = false;   // Servo uzdevuma puse: servo tur kalibrācijas impulsu
+
+// Zemas temperatūras pārbaude: krāsns auksta, detektors gaida kāpumu vai BURNOUT
 bool lowTempCheckActive = false;
-static int initialTemperature = 0; // Sākotnējā temperatūra, kad sākas pārbaude
-unsigned long LOW_TEMP_TIMEOUT = 240000; // 4 minūtes (4*60*1000 ms)
+unsigned long LOW_TEMP_TIMEOUT = 240000; // Cik ilgi auksta bez kāpuma līdz BURNOUT (4 min)
 
 int buzzer = 14;
 
-// Buzzer kontroles mainīgie
-bool isWarningActive = false;
-TaskHandle_t buzzerTaskHandle = NULL;
+// Buzzer: raksti (buzzer_pattern.h) tiek atskaņoti ar vienreizēju programmatūras
+// taimeri - katrs callback uzstāda izeju un ieplāno nākamo soli, klusumā
+// taimeris stāv. Pieprasījumi (loop(), kontroles uzdevums) maina tikai maskas;
+// atskaņotājs pieder taimera callback
+static std::atomic<uint8_t> buzzerActiveMask(0);
+static std::atomic<uint8_t> buzzerMutedMask(0);
+static buzzer_player_t buzzerPlayer;
+static TimerHandle_t buzzerTimer = NULL;
+static std::atomic<uint32_t> buzzerCallbacks(0);
+
+static void buzzerTimerCallback(TimerHandle_t timer) {
+    buzzerCallbacks++;
+    buzzer_player_select(&buzzerPlayer, buzzer_pattern_select(buzzerActiveMask, buzzerMutedMask));
+    bool level = false;
+    uint32_t durationMs = buzzer_player_next(&buzzerPlayer, &level);
+    digitalWrite(buzzer, level ? HIGH : LOW);
+    if (durationMs > 0) {
+        xTimerChangePeriod(timer, pdMS_TO_TICKS(durationMs), 0);
+    }
+}
+
+// Pamodina taimeri tikai tad, ja pēc masku maiņas jāskan citam rakstam
+static void buzzerUpdateMasks(uint8_t oldActive, uint8_t oldMuted) {
+    if (buzzerTimer != NULL &&
+        buzzer_pattern_select(oldActive, oldMuted) != buzzer_pattern_select(buzzerActiveMask, buzzerMutedMask)) {
+        xTimerChangePeriod(buzzerTimer, 1, 0);
+    }
+}
 
-// Buzzer kontroles funkcijas
 void initBuzzer() {
     pinMode(buzzer, OUTPUT);
     digitalWrite(buzzer, LOW);
+    buzzer_player_init(&buzzerPlayer);
+    if (buzzerTimer == NULL) {
+        buzzerTimer = xTimerCreate("Buzzer", 1, pdFALSE, NULL, buzzerTimerCallback);
+    }
 }
 
-// Buzzer uzdevuma funkcija, kas laiž nepārtrauktu skaņu
-void buzzerTask(void *pvParameters) {
-    while (1) {
-        if (isWarningActive) {
-            // Mainīgais signāls - 100ms skaņa, 100ms pauze
-            digitalWrite(buzzer, HIGH);
-            delay(100);  
-            digitalWrite(buzzer, LOW);
-            delay(100);
-        } else {
-            // Ja brīdinājums ir izslēgts, apstādinam signālu un gaidām
-            digitalWrite(buzzer, LOW);
-            vTaskDelay(pdMS_TO_TICKS(100));
-        }
+void buzzerSetPattern(buzzer_pattern_id_t pattern, bool active) {
+    const uint8_t bit = BUZZER_PATTERN_BIT(pattern);
+    const uint8_t oldActive = buzzerActiveMask;
+    const uint8_t oldMuted = buzzerMutedMask;
+    if (active) {
+        buzzerActiveMask |= bit;
+    } else {
+        // Nākamreiz raksts atkal skanēs, pat ja šoreiz bija apklusināts
+        buzzerActiveMask &= (uint8_t)~bit;
+        buzzerMutedMask &= (uint8_t)~bit;
     }
+    buzzerUpdateMasks(oldActive, oldMuted);
 }
 
-void startBuzzerSound() {
-    isWarningActive = true;
+void buzzerMute(bool muted) {
+    const uint8_t oldActive = buzzerActiveMask;
+    const uint8_t oldMuted = buzzerMutedMask;
+    buzzerMutedMask = muted ? (uint8_t)(oldMuted | oldActive) : 0;
+    buzzerUpdateMasks(oldActive, oldMuted);
 }
 
-void stopBuzzerSound() {
-    isWarningActive = false;
+buzzer_pattern_id_t buzzerCurrentPattern() {
+    return buzzer_pattern_select(buzzerActiveMask, buzzerMutedMask);
 }
 
-void playWarningSound() {
-    startBuzzerSound();
+void buzzerPrintStatus(Print &out) {
+    const uint8_t active = buzzerActiveMask;
+    const uint8_t muted = buzzerMutedMask;
+    out.print("Buzzer: ");
+    out.print(buzzer_pattern_name(buzzerCurrentPattern()));
+    out.print(" (taimera izsaukumi ");
+    out.print(buzzerCallbacks.load());
+    out.println(")");
+    for (uint8_t i = 0; i < BUZZER_PATTERN_COUNT; i++) {
+        if (active & BUZZER_PATTERN_BIT(i)) {
+            out.print("  ");
+            out.print(buzzer_pattern_name((buzzer_pattern_id_t)i));
+            out.println(muted & BUZZER_PATTERN_BIT(i) ? ": aktivs, apklusinats" : ": aktivs");
+        }
+    }
 }
 
-// Aprēķina vidējo vērtību masīva daļai
-int average(const int* arr, int start, int count) {
-    if (count <= 0) return 0;
-    
-    int sum = 0;
-    for (int i = start; i < start + count; ++i) {
-        sum += arr[i];
-    }
-    return sum / count;
+// Detektora konfigurācija no iestatījumiem (var mainīt ekrāns, telnet, NVS)
+// Izsauc tikai kontroles uzdevums, tāpēc logus nemaina paralēli update()
+static fire_detector_config_t fireDetectorConfig() {
+    fire_detector_config_t config = fire_detector_default_config(DAMPER_CONTROL_PERIOD_MS);
+    config.trendWindowS = (uint16_t)constrain(woodFillRecentS, 10, 400);
+    config.baselineWindowS = (uint16_t)constrain(woodFillOlderS, 10, 400);
+    config.coldTempC = temperatureMin;
+    config.burnoutHoldMs = LOW_TEMP_TIMEOUT;
+    return config;
 }
 
-// Pārbauda, vai tikko ir pievienota jauna malka
-// Atgriež true, ja pēdējo temperatūru vidējā vērtība ir augstāka nekā iepriekšējo
-bool WoodFilled(int CurrentTemp) {
-    // Pavirza vēstures datus uz priekšu
-    for (int i = 9; i > 0; --i) {
-        TempHist[i] = TempHist[i - 1];
+// Trases paraugs (recorder.h): ieeja (raw), ko regulators redzēja, un ko tas izlēma.
+// Vienu reizi uz rādījumu - pēc soļa vai pirms deep sleep, ja solis tajā aizgāja
+static void recordTraceSample() {
+    if (!traceSamplePending) {
+        return;
     }
-    TempHist[0] = CurrentTemp;
-
-    // Aprēķina jaunāko un vecāko mērījumu vidējās vērtības
-    int recent_avg = average(TempHist, 0, 5);
-    int older_avg = average(TempHist, 5, 5);
-
-    // Ja jaunākās temperatūras ir augstākas, tad malka ir papildināta
-    return recent_avg > older_avg;
+    traceSamplePending = false;
+    const temperature_sample_t* sample = &traceSample;
+    trace_sample_t trace;
+    trace.timeMs = sample->timestampMs;
+    trace.fields[TRACE_FIELD_FLUE_RAW] = sample->rawC16[TEMP_CHANNEL_FLUE];
+    trace.fields[TRACE_FIELD_FLUE] = sample->channelC16[TEMP_CHANNEL_FLUE];
+    trace.fields[TRACE_FIELD_ERR_P] = lroundf(errP * TEMP_C16_SCALE);
+    trace.fields[TRACE_FIELD_ERR_I] = lroundf(errI);
+    trace.fields[TRACE_FIELD_ERR_D] = lroundf(errD * 100.0f);
+    trace.fields[TRACE_FIELD_DAMPER] = damper;
+    trace.fields[TRACE_FIELD_ROOM_RAW] = sample->rawC16[TEMP_CHANNEL_ROOM];
+    trace.fields[TRACE_FIELD_MODE] = damperMode;
+    trace.fields[TRACE_FIELD_TARGET] = targetTempC;
+    trace.fields[TRACE_FIELD_VALID] = sample->validMask;
+    recorderAddSample(&trace);
 }
 
 void ieietDeepSleepArTouch() {
+    // Pēdējais ieraksts pirms miega - no tā var saprast, kāpēc krāsns apstājās
+    LOG_WARN("control", "Deep sleep: %s, %.2f C, errI %.0f (END pie %.0f), faze %s",
+             damper_mode_label(damperMode), controlTemperature, errI, endTrigger,
+             fire_phase_label(fireDetector.phase));
+    recordTraceSample();
+    recorderFlush();
+    loggerFlush();   // RAM buferi miegā pazustu
     touchSleepWakeUpEnable (2, thresholds);
     delay(500);
     esp_deep_sleep_start();
@@ -139,43 +301,269 @@ void ieietDeepSleepArTouch() {
 
 #include "lvgl_display.h" // Pievienojam, lai varētu piekļūt is_manual_damper_mode() funkcijai
 
+/**
+ * Padod regulatora rādījumu kurināšanas detektoram (katrā solī, ar fiksētu periodu)
+ * IGNITION/REFUEL nozīmē jaunu malku - uzkrātais deficīts tiek nodzēsts
+ */
+static void damperControlUpdateFire(float currentTemp) {
+    fire_detector_config_t config = fireDetectorConfig();
+    fire_detector_configure(&fireDetector, &config);
+
+    fire_event_type_t event = fire_detector_update(&fireDetector, millis(), currentTemp);
+    if (event == FIRE_EVENT_NONE) {
+        return;
+    }
+
+    LOG_INFO("fire", "%s (%.2f C, %.2f C/min)", fire_event_label(event),
+             fireDetector.meanC, fireDetector.slopeCPerMin);
+
+    if (is_manual_damper_mode() || errI >= endTrigger) {
+        return;
+    }
+
+    if (event == FIRE_EVENT_IGNITION || event == FIRE_EVENT_REFUEL) {
+        errI = 0;
+        lastRefuelMs = millis();
+    }
+}
+
+/**
+ * Feed-forward daļa, ko pieskaita PID izejai (negatīva = vērt ciet).
+ * PID reaģē tikai uz kļūdu, tāpēc pēc piekraušanas tas tur vārstu vaļā,
+ * līdz temperatūra jau ir mērķī, un tad aizcērt. Feed-forward aizver
+ * proporcionāli tam, par cik detektora slīpums pārsniedz kāpuma slieksni
+ * (regulēta plato troksnis vārstu nekustina), un tikai pēdējos
+ * FF_APPROACH_BAND_C grādos līdz mērķim. Jauna krava kāpumu turpina
+ * ilgāk, tāpēc pēc IGNITION/REFUEL pastiprinājums ir lielāks un
+ * eksponenciāli atgriežas pie ffTrendGain ar laika konstanti ffRefillTauS.
+ * Ārpus kāpuma feed-forward ir 0 - nobīde, ko integrālis lēnām kompensē,
+ * tikai pievienotu servo kustības.
+ */
+static float damperControlFeedForward(unsigned long now) {
+    float rise = fireDetector.slopeCPerMin - fireDetector.config.riseSlopeCPerMin;
+    float belowTarget = targetTempC - controlTemperature;
+    if (rise <= 0 || belowTarget >= FF_APPROACH_BAND_C) {
+        return 0;
+    }
+    // Tālu zem mērķa jaunai kravai vajag gaisu - aizveram tikai tuvojoties
+    float gain = ffTrendGain;
+    if (lastRefuelMs != 0 && ffRefillTauS > 0) {
+        float sinceRefuelS = (now - lastRefuelMs) / 1000.0f;
+        gain *= 1.0f + ffRefillBoost * expf(-sinceRefuelS / ffRefillTauS);
+    }
+    return -gain * rise;
+}
+
+/**
+ * Ārējā (istabas) cilpa. Izsauc katrā regulatora solī, bet rēķina ik pēc
+ * CASCADE_PERIOD_MS - istaba mainās stundās, dūmgāzes minūtēs.
+ * Kamēr iekšējā cilpa neregulē (MANUAL, FILL!, END!, zemas temperatūras
+ * pārbaude) vai istabas sensora nav, ārējā cilpa tikai seko targetTempC,
+ * lai integrālis neuzkrājas un pāreja atpakaļ ir bez lēciena.
+ */
+static void damperControlUpdateCascade() {
+    unsigned long now = millis();
+    if (lastCascadeTime != 0 && now - lastCascadeTime < CASCADE_PERIOD_MS) {
+        return;
+    }
+    float dt = (lastCascadeTime == 0) ? 0.0f : (now - lastCascadeTime) / 1000.0f;
+    lastCascadeTime = now;
+
+    roomPid.setTunings(cascadeKp, cascadeTauI, 0);
+    roomPid.setOutputLimits(temperaturemini2, maxTemp);
+
+    bool roomValid = (controlChannelValid & (1 << TEMP_CHANNEL_ROOM)) != 0;
+    float roomC = controlChannelC[TEMP_CHANNEL_ROOM];
+
+    // Mērķi mainījis lietotājs (roller, poga, Telegram) - turpinām no tā
+    if (cascadeActive && targetTempC != cascadeTargetC) {
+        LOG_INFO("cascade", "merki mainija lietotajs (%d C), turpinam no ta", targetTempC);
+        roomPid.track(roomTargetC, roomC, targetTempC);
+        cascadeTargetC = targetTempC;
+        return;
+    }
+
+    bool innerInControl = damperMode == DAMPER_MODE_AUTO && !lowTempCheckActive;
+    if (!cascadeEnabled || !roomValid || !innerInControl) {
+        cascadeActive = false;
+        roomPid.track(roomTargetC, roomValid ? roomC : roomTargetC, targetTempC);
+        return;
+    }
+    cascadeActive = true;
+
+    // Vesels grāds mainās tikai, ja izeja no tā attālinās par visu grādu -
+    // citādi katrs istabas 0.0625 °C solis pārbīdītu iekšējās cilpas mērķi
+    float output = roomPid.update(roomTargetC, roomC, dt);
+    if (fabsf(output - targetTempC) >= CASCADE_TARGET_STEP_C) {
+        targetTempC = constrain((int)lroundf(output), temperaturemini2, maxTemp);
+        display_manager_notify_target_temp_changed();
+        LOG_INFO("cascade", "istaba %.2f C (merkis %.2f C) -> dumgazu merkis %d C",
+                 roomC, roomTargetC, targetTempC);
+    }
+    cascadeTargetC = targetTempC;
+}
+
+// Autotune pieprasījumi no telnet - apstrādā kontroles uzdevums pirms soļa
+static void damperControlServiceAutotune(unsigned long now) {
+    if (autotuneAbortRequested) {
+        autotuneAbortRequested = false;
+        autotuneRequestPct = 0;
+        if (pid_autotune_running(&autotune)) {
+            pid_autotune_abort(&autotune);
+            damper = (int)lroundf(autotune.u0);
+            LOG_INFO("autotune", "partraukts");
+        }
+    }
+
+    float stepPct = autotuneRequestPct;
+    if (stepPct <= 0) {
+        return;
+    }
+    autotuneRequestPct = 0;
+
+    if (is_manual_damper_mode() || errI >= endTrigger ||
+        controlTemperature <= temperatureMin || controlTemperature >= warningTemperature) {
+        LOG_WARN("autotune", "nevar sakt - vajag AUTO rezimu un temperaturu starp min un bridinajuma robezu");
+        return;
+    }
+
+    pid_autotune_config_t config = pid_autotune_default_config(minDamper, maxDamper);
+    config.stepPct = stepPct;
+    config.minTempC = temperatureMin;
+    config.maxTempC = warningTemperature;
+    pid_autotune_start(&autotune, &config, now, damper);
+    LOG_INFO("autotune", "sakts no damper %d%%, lecien %.2f%%", damper, stepPct);
+}
+
+// Eksperiments beidzies: modelis -> kP/tauI, ko pielieto un saglabā
+// damperControlApplyAutotune() no loop() (tauD paliek)
+static void damperControlFinishAutotune() {
+    if (autotune.state != PID_AUTOTUNE_DONE) {
+        LOG_WARN("autotune", "neizdevas (%s), parametri nav mainiti", pid_autotune_result_label(autotune.result));
+        return;
+    }
+
+    const int newKp = constrain((int)lroundf(autotune.kp), AUTOTUNE_KP_MIN, AUTOTUNE_KP_MAX);
+    const float newTauI = constrain(autotune.tauI, AUTOTUNE_TAU_I_MIN_S, AUTOTUNE_TAU_I_MAX_S);
+    autotuneResultKp = newKp;
+    autotuneResultTauI = newTauI;
+    autotuneResultReady = true;
+
+    LOG_INFO("autotune", "K=%.2f C/%%, T=%.2f s, L=%.2f s -> kP=%d, tauI=%.2f s",
+             autotune.model.gainCPerPct, autotune.model.timeConstantS, autotune.model.deadTimeS, newKp, newTauI);
+}
+
+// Publicē regulatora stāvokli pārējiem uzdevumiem (sk. controller_state.h)
+static void publishControllerState() {
+    controller_state_t state;
+    state.step = controlStats.periods;
+    state.timestampMs = millis();
+    state.temperature = controlTemperature;
+    for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+        state.channelC[ch] = controlChannelC[ch];
+    }
+    state.channelValidMask = controlChannelValid;
+    state.targetTemp = targetTempC;
+    state.roomTargetC = roomTargetC;
+    state.cascadeActive = cascadeActive;
+    state.damper = damper;
+    state.mode = damperMode;
+    state.lowTempCheckActive = lowTempCheckActive;
+    state.errP = errP;
+    state.errI = errI;
+    state.errD = errD;
+    state.pTerm = damperPid.getPTerm();
+    state.iTerm = damperPid.getITerm();
+    state.dTerm = damperPid.getDTerm();
+    state.ffTerm = ffTerm;
+    state.kpScale = gainScale.kpScale;
+    state.tauIScale = gainScale.tauIScale;
+    state.firePhase = fireDetector.phase;
+    state.trendCPerMin = fireDetector.slopeCPerMin;
+    controller_state_publish(&state);
+
+    // Servo uzdevums guļ, kamēr nav jauna mērķa - pamodinām tikai pie izmaiņas
+    static int notifiedDamper = -1;
+    if (damperTaskHandle != NULL && damper != notifiedDamper) {
+        notifiedDamper = damper;
+        xTaskNotifyGive(damperTaskHandle);
+    }
+}
+
+/**
+ * Viens regulatora solis. Izsaucams ik pēc DAMPER_CONTROL_PERIOD_MS;
+ * PID izmanto faktisko laiku kopš iepriekšējā soļa
+ */
 void damperControlLoop() {
     int oldDamperValue = damper;
-    String oldMessage = messageDamp;
+    
+    // Iepriekšējais publicētais stāvoklis - režīma maiņas noteikšanai
+    controller_state_t previous;
+    controller_state_read(&previous);
+
+    unsigned long now = millis();
+    float dt = (lastControlTime == 0) ? 0.0f : (now - lastControlTime) / 1000.0f;
+    if (dt > DAMPER_CONTROL_MAX_DT_S) {
+        dt = DAMPER_CONTROL_MAX_DT_S; // Pēc ilgas aiztures (piem., bloķējošs TLS) neintegrējam visu pauzi
+    }
+    lastControlTime = now;
+
+    // Parametrus var mainīt iestatījumu ekrāns vai Telegram jebkurā brīdī.
+    // I daļa glabājas jau ar ki pareizināta, tāpēc grafika maiņa izeju nelec
+    if (gainScheduleChanged) {
+        tableLockTake();
+        gainScheduleChanged = false;
+        activeGainSchedule = gainSchedule;
+        tableLockGive();
+    }
+    gainScale = gain_schedule_eval(&activeGainSchedule, controlTemperature);
+    damperPid.setTunings(kP * gainScale.kpScale, tauI * gainScale.tauIScale, tauD);
+    damperPid.setOutputLimits(minDamper, maxDamper);
     
     // Izvadam pasreizejo temperaturu un minimalo temperaturu ik pec 30 sekundem
     static unsigned long lastDebugTime = 0;
     if (millis() - lastDebugTime > 30000) {
-        Telnet.print("DEBUG: Pasreizeja temperatura: ");
-        Telnet.print(temperature);
-        Telnet.print(" C, Minimala temperatura: ");
-        Telnet.print(temperatureMin);
-        Telnet.print(" C, lowTempCheckActive: ");
-        Telnet.println(lowTempCheckActive ? "true" : "false");
+        LOG_DEBUG("control", "Pasreizeja temperatura: %.2f C, Minimala temperatura: %d C, lowTempCheckActive: %s",
+                  controlTemperature, temperatureMin, lowTempCheckActive ? "true" : "false");
         lastDebugTime = millis();
     }
     
+    // Telnet autotune start/stop pieprasījumi
+    damperControlServiceAutotune(now);
+
+    ffTerm = 0;   // Tikai PID diapazonā (zemāk)
     // JAUNS: Pārbaudām vai esam manuālajā režīmā
     if (is_manual_damper_mode()) {
+        // Lietotājs pārņēma vārstu - eksperiments vairs nav derīgs
+        if (pid_autotune_running(&autotune)) {
+            pid_autotune_abort(&autotune);
+            damperControlFinishAutotune();
+        }
+
         // Manuālajā režīmā damper vērtība tiek uzstādīta no UI roller,
         // tāpēc šeit neveicam nekādas izmaiņas
-        messageDamp = "MANUAL";
+        damperMode = DAMPER_MODE_MANUAL;
+        
+        // PID seko manuālajai pozīcijai, lai pāreja uz AUTO būtu bez lēciena
+        damperPid.track(targetTempC, controlTemperature, damper);
     } 
-    else if (errI < endTrigger) {
-        // PID regulators - TIKAI ja nav zemas temperatūras režīms
-        if (!lowTempCheckActive) {
-            errP = targetTempC - temperature;
-            errI = errI + errP;
-            errD = errP - errOld;
-            errOld = errP;
+    else if (pid_autotune_running(&autotune)) {
+        // Vārstu tur eksperiments; PID seko, lai pēc tam turpinātu bez lēciena
+        damper = (int)lroundf(pid_autotune_update(&autotune, now, controlTemperature));
+        damper = constrain(damper, minDamper, maxDamper);
+        damperMode = DAMPER_MODE_TUNE;
+        damperPid.track(targetTempC, controlTemperature, damper);
+        if (!pid_autotune_running(&autotune)) {
+            damperControlFinishAutotune();
         }
-        
-        // Pārbauda, vai ir pievienota jauna malka
-        bool woodAdded = WoodFilled(temperature);
-        
-        // Ja ir pievienota jauna malka, atiestatām integrālo kļūdu
-        if (woodAdded) {
-            errI = 0;
+    }
+    else if (errI < endTrigger) {
+        // Deficīta uzskaite - TIKAI kamēr uguns dziest (DECAY) un nav zemas temperatūras režīms.
+        // Regulētā plato zem mērķa (piem., sensora noapaļošanas dēļ) deficīts neuzkrājas.
+        // Mērvienība ir "°C × 4 s nolasījums", lai saglabātie refillTrigger/endTrigger
+        // nezaudētu nozīmi
+        if (!lowTempCheckActive && fireDetector.phase == FIRE_PHASE_DECAY) {
+            errI += (targetTempC - controlTemperature) * dt / DAMPER_DEFICIT_SAMPLE_S;
         }
         
         // Uzlabota kontroles loģika ar precīziem nosacījumiem:
@@ -183,108 +571,94 @@ void damperControlLoop() {
         // - Ja temperatūra ir mazāka par minimālo (temperatureMin), damper = 0 (pilnībā aizvērts)
         // - PID aprēķins tiek veikts TIKAI diapazonā: temperatureMin < temperature < targetTempC
         
-        if (temperature >= targetTempC) {
+        if (controlTemperature >= targetTempC) {
             // Temperatūra ir virs vai vienāda ar mērķi - pilnībā aizveram damper
             damper = minDamper; // 0%
-            messageDamp = "AUTO"; // Statuss, kas norāda, ka sasniegta max temperatūra
+            damperMode = DAMPER_MODE_AUTO; // Statuss, kas norāda, ka sasniegta max temperatūra
+            damperPid.track(targetTempC, controlTemperature, damper);
             // Nepārtraucam zemas temperatūras pārbaudi šeit - tas tiek darīts tikai optimālajā diapazonā
         } 
-        else if (temperature <= temperatureMin) {
+        else if (controlTemperature <= temperatureMin) {
             // Temperatūra ir zem vai vienāda ar minimālo - pilnībā atveram damper
             damper = maxDamper; // 100%
-            messageDamp = "AUTO";
+            damperMode = DAMPER_MODE_AUTO;
+            damperPid.track(targetTempC, controlTemperature, damper);
             
-            // Aktivizējam 4 minūšu pārbaudi, ja tā vēl nav aktīva
+            // Zemas temperatūras pārbaude: detektors gaida kāpumu (IGNITION) vai BURNOUT
             if (!lowTempCheckActive) {
-                lowTempStartTime = millis();
-                initialTemperature = temperature; // Saglabājam sākotnējo temperatūru
                 lowTempCheckActive = true;
                 
-                // Sakam jaunu rindu un pievienojam laiku, lai butu redzams, kad tiesi zinojums paradijas
-                Telnet.println("");
-                Telnet.println("*****************************************************************");
-                Telnet.print("AKTIVIZETS [");
-                Telnet.print(millis()/1000);
-                Telnet.println(" s]: Zemas temperaturas parbaudes rezims");
-                Telnet.println("INFO: Zemas temperaturas parbaude sakta. Sakuma temperatura: " + String(temperature) + " C");
-                Telnet.println("INFO: Ja 4 minutu laika temperatura nepaaugstinasies par 3 C, ESP paries deep sleep rezima");
-                Telnet.println("*****************************************************************");
-                
-                // Parbaudam, vai varam ari izvadit uz Telneto portu (diagnostikai)
-                Telnet.println("INFO: Zemas temperaturas parbaude sakta. Sakuma temperatura: " + String(temperature) + " C");
-            } 
-            // Ja ir pagājušas 4 minūtes un temperatūra NAV palielinājusies vismaz par 3 grādiem
-            else if (millis() - lowTempStartTime > LOW_TEMP_TIMEOUT && temperature < (initialTemperature + 3)) {
+                LOG_INFO("control", "AKTIVIZETS zemas temperaturas parbaudes rezims: %.2f C, faze %s",
+                         controlTemperature, fire_phase_label(fireDetector.phase));
+                LOG_INFO("control", "Ja %lu min laika temperatura nesaks kapt, ESP paries deep sleep rezima",
+                         LOW_TEMP_TIMEOUT / 60000);
+            }
+            
+            if (fireDetector.phase == FIRE_PHASE_BURNOUT) {
                 damper = minDamper; // Iestatām damper uz aizvērtu pozīciju
-                messageDamp = "END!";
+                damperMode = DAMPER_MODE_END;
                 display_manager_notify_damper_changed();
                 
-                // Telnet zinojums par deep sleep sagatavosanu
-                Telnet.println("BRIDINAJUMS: 4 minutes pagajusas, bet temperatura nav paaugstinajusies par 3 C");
-                Telnet.println("Sakotneja temp: " + String(initialTemperature) + " C, Pasreizeja temp: " + String(temperature) + " C");
-                Telnet.println("Gatavojamies pariet deep sleep rezima...");
+                LOG_WARN("control", "Krasns izdegusi (BURNOUT): temperatura nekapj %lu min, %.2f C, slipums %.2f C/min",
+                         LOW_TEMP_TIMEOUT / 60000, controlTemperature, fireDetector.slopeCPerMin);
                 
                 // Gaidām līdz servo beidz kustību
-                if (!servoMoving) {
-                    // Telnet zinojums par deep sleep pareju
-                    Telnet.println("INFORMACIJA: Servo kustiba pabeigta. Damper pozicija: " + String(currentDamper) + "%");
-                    Telnet.println("BRIDINAJUMS: Temperatura nav pieaugusi pietiekami. Parejam deep sleep rezima pec 0.5s");
+                if (!controller_state_servo_moving()) {
+                    LOG_INFO("control", "Servo kustiba pabeigta. Damper pozicija: %d%%", controller_state_servo_position());
+                    publishControllerState();
+                    buzzerSetPattern(BUZZER_PATTERN_BURNOUT, true);   // Skan, kamēr gaidām
                     delay(1500); // Ļaujam lietotājam redzēt ziņojumu
                     ieietDeepSleepArTouch(); // Aizejam dziļajā miegā
                 }
             }
-            // Ja temperatūra ir paaugstinājusies vismaz par 3 grādiem, atceļam zemas temperatūras pārbaudi
-            else if (temperature >= (initialTemperature + 3)) {
-                // Telnet zinojums par veiksmīgu temperaturas paaugstinasanos
-                Telnet.println("");
-                Telnet.println("*****************************************************************");
-                Telnet.print("ATCELTS [");
-                Telnet.print(millis()/1000);
-                Telnet.println(" s]: Zemas temperaturas parbaudes rezims");
-                Telnet.println("INFORMACIJA: Temperatura veiksmigi paaugstinajusies par 3 C vai vairak!");
-                Telnet.println("Sakotneja temp: " + String(initialTemperature) + " C, Pasreizeja temp: " + String(temperature) + " C");
-                Telnet.println("Zemas temperaturas parbaude atcelta. Krasns darbojas normali.");
-                Telnet.println("*****************************************************************");
-                
-                // Atcelam zemas temperaturas parbaudi
-                lowTempCheckActive = false;
-                
-                // Dublejam zinojumu Telnetaja porta
-                Telnet.println("INFORMACIJA: Temperatura veiksmigi paaugstinajusies. Parbaude atcelta.");
-            }
         } 
         else {
-            // PID aprēķins TIKAI ja nav zemas temperatūras režīms
-            if (!lowTempCheckActive) {
-                // Šeit aprēķinam optimālo damper vērtību ar PID algoritmu
-                damper = kP * errP + kI * errI + kD * errD;
-                Telnet.println("Damper apreikina erP: " +String(errI));
-                // Ierobežojam vērtību noteiktajā diapazonā
-                damper = constrain(damper, minDamper, maxDamper);
-                messageDamp = "AUTO"; // Normāls automātiskais režīms
+            // Temperatūra ir virs minimālās - zemas temperatūras pārbaudei te vairs nav nozīmes.
+            // Agrāk tā palika aktīva un iesaldēja PID, ja krāsns iekurta no auksta stāvokļa
+            if (lowTempCheckActive) {
+                lowTempCheckActive = false;
+                LOG_INFO("control", "Temperatura virs minimalas. Zemas temperaturas parbaude atcelta.");
             }
+            
+            // Šeit aprēķinam optimālo damper vērtību ar PID algoritmu.
+            // PID robežas ir nobīdītas par feed-forward, lai anti-windup
+            // attiektos uz kopējo izeju, nevis tikai uz PID daļu
+            ffTerm = damperControlFeedForward(now);
+            damperPid.setOutputLimits(minDamper - ffTerm, maxDamper - ffTerm);
+            float pidOutput = damperPid.update(targetTempC, controlTemperature, dt);
+            damper = (int)lroundf(pidOutput + ffTerm);
+            // Ierobežojam vērtību noteiktajā diapazonā
+            damper = constrain(damper, minDamper, maxDamper);
+            damperMode = DAMPER_MODE_AUTO; // Normāls automātiskais režīms
         }
         
+        errP = damperPid.getError();
+        errD = damperPid.getDerivative();
+        
         // Papildu statusa ziņojuma atjaunināšana, ja nepieciešams papildināt malku
         // Šis pārraksta iepriekš iestatītos statusus, ja integrālā kļūda ir pārāk liela
-        if (errI > refillTrigger) { 
-            messageDamp = "FILL!";
+        // vai detektors redz ilgstošu kritumu zem mērķa (uguns dziest)
+        bool fireDecaying = fireDetector.phase == FIRE_PHASE_DECAY && controlTemperature < targetTempC;
+        if (errI > refillTrigger || fireDecaying) { 
+            damperMode = DAMPER_MODE_FILL;
         }
     } else {
         // Sistēma ir beigusi darboties (sasniegta maksimālā integrālā kļūda)
-        if (temperature < temperatureMin) {
+        if (controlTemperature < temperatureMin) {
             damper = zeroDamper;
-            messageDamp = "END!";
+            damperMode = DAMPER_MODE_END;
             
             // Paziņojam par izmaiņām un ieslēdzam deep sleep
             if (damper != oldDamperValue) {
                 display_manager_notify_damper_position_changed();
             }
             
-            if (messageDamp != oldMessage) {
+            if (damperMode != previous.mode) {
                 display_manager_notify_damper_changed();
             }
             
+            publishControllerState();
+            buzzerSetPattern(BUZZER_PATTERN_BURNOUT, true);
             delay(1500);
             ieietDeepSleepArTouch(); // Aizejam dziļajā miegā
         }
@@ -300,9 +674,520 @@ void damperControlLoop() {
         display_manager_notify_damper_position_changed();
     }
     
-    if (messageDamp != oldMessage) {
+    if (damperMode != previous.mode) {
+        LOG_INFO("control", "Rezims %s -> %s (%.2f C, errI %.0f, faze %s)", damper_mode_label(previous.mode),
+                 damper_mode_label(damperMode), controlTemperature, errI, fire_phase_label(fireDetector.phase));
         display_manager_notify_damper_changed();
+        buzzerSetPattern(BUZZER_PATTERN_REFILL, damperMode == DAMPER_MODE_FILL);
+        buzzerSetPattern(BUZZER_PATTERN_BURNOUT, damperMode == DAMPER_MODE_END);
+    }
+    
+    publishControllerState();
+}
+
+/**
+ * Nodod sensora rādījumu kontroles uzdevumam (izsauc SensorTask)
+ * Nekad nebloķē - ja rinda ir pilna, vecākais rādījums paliek rindā un jaunais tiek izmests
+ */
+bool damperControlPostSample(const temperature_sample_t* sample) {
+    if (sensorQueue == NULL) {
+        return false;
+    }
+    return xQueueSend(sensorQueue, sample, 0) == pdTRUE;
+}
+
+// Perioda statistika: |faktiskais periods - nominālais| histogrammā
+static void recordControlPeriod(unsigned long nowUs) {
+    if (lastControlStepUs != 0) {
+        uint32_t periodUs = nowUs - lastControlStepUs;
+        uint32_t nominalUs = DAMPER_CONTROL_PERIOD_MS * 1000UL;
+        uint32_t deviationUs = periodUs > nominalUs ? periodUs - nominalUs : nominalUs - periodUs;
+        uint32_t bin = deviationUs / CONTROL_JITTER_BIN_US;
+        if (bin >= CONTROL_JITTER_BINS) {
+            bin = CONTROL_JITTER_BINS - 1;
+        }
+        controlStats.jitterHist[bin]++;
+
+        if (controlStats.periods == 0 || periodUs < controlStats.minPeriodUs) {
+            controlStats.minPeriodUs = periodUs;
+        }
+        if (periodUs > controlStats.maxPeriodUs) {
+            controlStats.maxPeriodUs = periodUs;
+        }
+        if (periodUs > nominalUs + nominalUs / 2) {
+            controlStats.missedDeadlines++;
+        }
+        controlStats.periods++;
+    }
+    lastControlStepUs = nowUs;
+}
+
+/**
+ * Dūmgāzu kanāls nederīgs (SensorTask publicē SENSOR_FAILSAFE_TEMP) - skan
+ * "sensors" raksts, līdz kanāls atkal derīgs. Displeja brīdinājums to tikai rāda
+ */
+static void damperControlUpdateSensorFault() {
+    static bool flueFault = false;
+    const bool fault = (controlChannelValid & (1 << TEMP_CHANNEL_FLUE)) == 0;
+    if (fault == flueFault) {
+        return;
+    }
+    flueFault = fault;
+    if (fault) {
+        LOG_WARN("control", "Dumgazu sensors nederigs - regule pec drosas vertibas %.2f C", controlTemperature);
+    } else {
+        LOG_INFO("control", "Dumgazu sensors atkal derigs (%.2f C)", controlTemperature);
+    }
+    buzzerSetPattern(BUZZER_PATTERN_SENSOR_FAULT, fault);
+}
+
+/**
+ * Viena kontroles uzdevuma iterācija: paņem visus jaunos rādījumus no rindas
+ * un izpilda regulatora soli
+ */
+void damperControlTaskStep() {
+    unsigned long startUs = micros();
+    recordControlPeriod(startUs);
+
+    temperature_sample_t sample;
+    while (xQueueReceive(sensorQueue, &sample, 0) == pdTRUE) {
+        traceSample = sample;
+        traceSamplePending = true;
+        // Regulē pēc dūmgāzēm; drošā vērtība (nederīgs kanāls) arī ir ieeja, kā agrāk
+        for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+            controlChannelC[ch] = sample.channelC16[ch] / (float)TEMP_C16_SCALE;
+        }
+        controlChannelValid = sample.validMask;
+        controlTemperature = controlChannelC[TEMP_CHANNEL_FLUE];
+        controlHasSample = true;
+    }
+
+    // Līdz pirmajam rādījumam regulatoram nav ko regulēt
+    if (controlHasSample) {
+        damperControlUpdateSensorFault();
+        damperControlUpdateFire(controlTemperature);
+        damperControlUpdateCascade();
+        damperControlLoop();
+    }
+    recordTraceSample();
+
+    uint32_t execUs = micros() - startUs;
+    if (execUs > controlStats.maxExecUs) {
+        controlStats.maxExecUs = execUs;
+    }
+}
+
+/**
+ * FreeRTOS kontroles uzdevums ar deterministisku periodu (vTaskDelayUntil)
+ * Prioritāte ir augstāka par Arduino loop(), tāpēc Telegram TLS vai LVGL
+ * kadra zīmēšana to neaiztur
+ */
+void ControlTask(void *pvParameters) {
+    TickType_t lastWake = xTaskGetTickCount();
+    while (1) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(DAMPER_CONTROL_PERIOD_MS));
+        damperControlTaskStep();
+    }
+}
+
+bool damperControlRequestAutotune(float stepPct) {
+    if (stepPct <= 0 || is_manual_damper_mode()) {
+        return false;
+    }
+    autotuneRequestPct = stepPct;
+    return true;
+}
+
+void damperControlAbortAutotune() {
+    autotuneAbortRequested = true;
+}
+
+void damperControlApplyAutotune() {
+    if (!autotuneResultReady) {
+        return;
+    }
+    kP = autotuneResultKp;
+    tauI = autotuneResultTauI;
+    autotuneResultReady = false;
+    kI = kP / tauI;
+    kD = kP * tauD;
+    saveControlSettings();
+    LOG_INFO("autotune", "kP=%d, tauI=%.2f s pielietoti un saglabati", kP, tauI);
+}
+
+bool damperControlAutotuneRunning() {
+    return pid_autotune_running(&autotune);
+}
+
+void damperControlPrintAutotune(Print &out) {
+    out.print("Autotune: ");
+    out.print(pid_autotune_state_label(autotune.state));
+    if (autotune.state == PID_AUTOTUNE_FAILED) {
+        out.print(" (");
+        out.print(pid_autotune_result_label(autotune.result));
+        out.print(")");
+    }
+    if (pid_autotune_running(&autotune)) {
+        out.print(", ");
+        out.print((millis() - autotune.startMs) / 1000);
+        out.print(" s, damper ");
+        out.print(autotune.u0);
+        out.print(" -> ");
+        out.print(autotune.u1);
+        out.print(" %, radijumi ");
+        out.print(autotune.sampleCount);
+    }
+    out.println("");
+    if (autotune.state == PID_AUTOTUNE_DONE) {
+        out.print("  Modelis: K ");
+        out.print(autotune.model.gainCPerPct);
+        out.print(" C/%, T ");
+        out.print(autotune.model.timeConstantS);
+        out.print(" s, L ");
+        out.print(autotune.model.deadTimeS);
+        out.print(" s, izmaina ");
+        out.print(autotune.model.deltaC);
+        out.print(" C, drift ");
+        out.print(autotune.model.driftCPerMin);
+        out.println(" C/min");
+        out.print("  Aprekinats: kP ");
+        out.print(autotune.kp);
+        out.print(", tauI ");
+        out.print(autotune.tauI);
+        out.println(" s");
+    }
+    out.print("  Pasreiz: kP ");
+    out.print(kP);
+    out.print(", tauI ");
+    out.print(tauI);
+    out.print(" s, tauD ");
+    out.print(tauD);
+    out.println(" s");
+}
+
+servo_actuator_stats_t damperControlGetServoStats() {
+    return servoStats;
+}
+
+void damperControlResetServoStats() {
+    memset(&servoStats, 0, sizeof(servoStats));
+    servoStats.sinceMs = millis();
+}
+
+void damperControlPrintServoStats(Print &out) {
+    servo_actuator_stats_t stats = servoStats;
+    float hours = (millis() - stats.sinceMs) / 3600000.0f;
+    out.print("Servo: deadband ");
+    out.print(servoDeadbandPct);
+    out.print(" %, backlash ");
+    out.print(servoBacklashPct);
+    out.print(" %, atrums ");
+    out.print(1000.0f / constrain(servoStepInterval, 1, 1000));
+    out.println(" %/s");
+    out.print("  Kustibas: ");
+    out.print(stats.moves);
+    out.print(", cels ");
+    out.print(stats.travelPct);
+    out.print(" %, pieslegsanas ");
+    out.print(stats.attachCycles);
+    out.print(", virziena mainas ");
+    out.println(stats.reversals);
+    out.print("  Apvienoti kustibas laika: ");
+    out.print(stats.coalesced);
+    out.print(", deadband ignoreti: ");
+    out.println(stats.suppressed);
+    if (hours > 0) {
+        out.print("  Stunda: ");
+        out.print(stats.moves / hours);
+        out.print(" kustibas, ");
+        out.print(stats.travelPct / hours);
+        out.print(" % cels, ");
+        out.print(stats.attachCycles / hours);
+        out.println(" pieslegsanas");
+    }
+}
+
+void damperControlSetGainSchedule(const gain_schedule_t* schedule) {
+    tableLockTake();
+    gainSchedule = *schedule;
+    gainScheduleChanged = true;
+    tableLockGive();
+}
+
+void damperControlPrintGainSchedule(Print &out) {
+    if (gainSchedule.count == 0) {
+        out.println("Pastiprinajumu grafiks: tukss (kP, tauI visur bez reizinataja)");
+    } else {
+        out.println("Pastiprinajumu grafiks (temp C: kP x, tauI x):");
+        for (uint8_t i = 0; i < gainSchedule.count; i++) {
+            const gain_schedule_point_t* p = &gainSchedule.points[i];
+            out.print("  ");
+            out.print(p->tempC);
+            out.print(" C: kP x");
+            out.print(p->kpScale);
+            out.print(" (");
+            out.print(kP * p->kpScale);
+            out.print("), tauI x");
+            out.print(p->tauIScale);
+            out.print(" (");
+            out.print(tauI * p->tauIScale);
+            out.println(" s)");
+        }
+    }
+    controller_state_t state;
+    controller_state_read(&state);
+    out.print("  Pasreiz pie ");
+    out.print(state.temperature);
+    out.print(" C: kP ");
+    out.print(kP * state.kpScale);
+    out.print(", tauI ");
+    out.print(tauI * state.tauIScale);
+    out.println(" s");
+}
+
+void damperControlSetAirflowMap(const airflow_map_t* map) {
+    tableLockTake();
+    airflowMap = *map;
+    airflowMapChanged = true;
+    tableLockGive();
+    if (damperTaskHandle != NULL) {
+        xTaskNotifyGive(damperTaskHandle);
+    }
+}
+
+static void airflowCalibrationMove(float micros) {
+    airflowCalibrationMicros = constrain(micros, (float)minUs, (float)maxUs);
+    if (damperTaskHandle != NULL) {
+        xTaskNotifyGive(damperTaskHandle);
+    }
+}
+
+// Sākuma impulss katram solim: esošā tabula vai lineārā ģeometrija
+static float airflowCalibrationGuess(float airflowPct) {
+    return airflow_map_active(&airflowMap) ? airflow_map_micros(&airflowMap, airflowPct)
+                                           : damperOpeningToMicros(airflowPct);
+}
+
+void damperControlStartAirflowCalibration() {
+    airflow_map_clear(&airflowCalibrationMap);
+    airflowCalibrationStep = 0;
+    airflowCalibrationActive = true;
+    airflowCalibrationMove(airflowCalibrationGuess(AIRFLOW_CALIBRATION_POINTS[0]));
+}
+
+bool damperControlAirflowCalibrationActive() {
+    return airflowCalibrationActive;
+}
+
+void damperControlJogAirflowCalibration(int deltaUs) {
+    if (airflowCalibrationActive) {
+        airflowCalibrationMove(airflowCalibrationMicros + deltaUs);
+    }
+}
+
+bool damperControlAcceptAirflowCalibration() {
+    if (!airflowCalibrationActive) {
+        return false;
+    }
+    if (!airflow_map_set(&airflowCalibrationMap, AIRFLOW_CALIBRATION_POINTS[airflowCalibrationStep],
+                         airflowCalibrationMicros)) {
+        return false;   // Impulss nav monotons - jāpieregulē
+    }
+    airflowCalibrationStep++;
+    if (airflowCalibrationStep < AIRFLOW_CALIBRATION_COUNT) {
+        airflowCalibrationMove(airflowCalibrationGuess(AIRFLOW_CALIBRATION_POINTS[airflowCalibrationStep]));
+        return true;
+    }
+    airflowCalibrationActive = false;
+    damperControlSetAirflowMap(&airflowCalibrationMap);
+    return true;
+}
+
+void damperControlStopAirflowCalibration() {
+    airflowCalibrationActive = false;
+    if (damperTaskHandle != NULL) {
+        xTaskNotifyGive(damperTaskHandle);
+    }
+}
+
+void damperControlPrintAirflowMap(Print &out) {
+    if (airflowCalibrationActive) {
+        out.print("Kalibracija: solis ");
+        out.print(airflowCalibrationStep + 1);
+        out.print("/");
+        out.print((int)AIRFLOW_CALIBRATION_COUNT);
+        out.print(" - iestatiet ");
+        out.print(AIRFLOW_CALIBRATION_POINTS[airflowCalibrationStep], 0);
+        out.print(" % gaisa plusmu, servo ");
+        out.print(airflowCalibrationMicros, 0);
+        out.println(" us ('airflow +N/-N', 'airflow ok', 'airflow stop')");
+        return;
+    }
+    if (!airflow_map_active(&airflowMap)) {
+        out.print("Gaisa plusmas tabula: nav (lineara geometrija, ");
+        out.print(damperOpeningToMicros(0), 0);
+        out.print("-");
+        out.print(damperOpeningToMicros(100), 0);
+        out.println(" us)");
+        return;
+    }
+    out.println("Gaisa plusmas tabula (plusma %: impulss us):");
+    for (uint8_t i = 0; i < airflowMap.count; i++) {
+        out.print("  ");
+        out.print(airflowMap.points[i].airflowPct, 1);
+        out.print(" %: ");
+        out.print(airflowMap.points[i].micros, 0);
+        out.println(" us");
+    }
+}
+
+control_task_stats_t damperControlGetStats() {
+    return controlStats;
+}
+
+void damperControlResetStats() {
+    memset(&controlStats, 0, sizeof(controlStats));
+    controlStats.sinceMs = millis();
+    lastControlStepUs = 0;
+}
+
+// Perioda novirzes procentile no histogrammas (histogrammas joslas augšējā robeža)
+uint32_t damperControlJitterPercentileUs(uint8_t percentile) {
+    if (controlStats.periods == 0) {
+        return 0;
+    }
+    uint32_t threshold = ((uint64_t)controlStats.periods * percentile + 99) / 100;
+    uint32_t cumulative = 0;
+    for (uint32_t bin = 0; bin < CONTROL_JITTER_BINS; bin++) {
+        cumulative += controlStats.jitterHist[bin];
+        if (cumulative >= threshold) {
+            return (bin + 1) * CONTROL_JITTER_BIN_US;
+        }
+    }
+    return CONTROL_JITTER_BINS * CONTROL_JITTER_BIN_US;
+}
+
+void damperControlPrintStats(Print &out) {
+    control_task_stats_t stats = damperControlGetStats();
+    out.println("Kontroles uzdevuma perioda statistika:");
+    out.print("  Nominalais periods: ");
+    out.print(DAMPER_CONTROL_PERIOD_MS);
+    out.println(" ms");
+    out.print("  Periodi: ");
+    out.println(stats.periods);
+    out.print("  Min/max periods: ");
+    out.print(stats.minPeriodUs);
+    out.print(" / ");
+    out.print(stats.maxPeriodUs);
+    out.println(" us");
+    out.print("  Novirze p50/p99 (lidz): ");
+    out.print(damperControlJitterPercentileUs(50));
+    out.print(" / ");
+    out.print(damperControlJitterPercentileUs(99));
+    out.println(" us");
+    out.print("  Nokavetie termini (>1.5x periods): ");
+    out.println(stats.missedDeadlines);
+    out.print("  Max izpildes laiks: ");
+    out.print(stats.maxExecUs);
+    out.println(" us");
+
+    float elapsedS = (millis() - stats.sinceMs) / 1000.0f;
+    out.print("Servo uzdevums: ");
+    out.print(elapsedS > 0 ? stats.servoWakeups / elapsedS : 0.0f);
+    out.print(" pamosanas/s, bez kustibas ");
+    out.print(elapsedS > 0 ? stats.servoIdleWakeups / elapsedS : 0.0f);
+    out.print("/s (");
+    out.print(stats.servoWakeups);
+    out.print(" / ");
+    out.print(stats.servoIdleWakeups);
+    out.println(")");
+}
+
+// Kustības ierobežojumi: servoStepInterval (ms uz 1 %) nosaka maksimālo ātrumu
+static servo_motion_config_t servoMotionConfig() {
+    servo_motion_config_t config;
+    config.maxVelocityPctPerS = 1000.0f / constrain(servoStepInterval, 1, 1000);
+    config.accelerationPctPerS2 = SERVO_ACCEL_PCT_PER_S2;
+    return config;
+}
+
+/**
+ * Lineārā ģeometrija: vārsta atvērums % -> servo impulss (us). Leņķis paliek
+ * float (agrāk map() noapaļoja līdz veselam grādam - ~23 soļi visam gājienam)
+ */
+float damperOpeningToMicros(float openingPct) {
+    float angle = servoOffset + openingPct / 100.0f * (servoAngle / servoCalibration);
+    return minUs + (angle - minAngle) * (maxUs - minUs) / (float)(maxAngle - minAngle);
+}
+
+float damperMicrosToOpening(float micros) {
+    float angle = minAngle + (micros - minUs) * (maxAngle - minAngle) / (float)(maxUs - minUs);
+    return (angle - servoOffset) * servoCalibration / servoAngle * 100.0f;
+}
+
+static int microsToServoTicks(float micros) {
+    return (int)lroundf(micros * (1 << mansServo.readTimerWidth()) / SERVO_PWM_PERIOD_US);
+}
+
+/**
+ * Damper % (gaisa plūsma) -> impulss LEDC taimera soļos. Ar kalibrētu tabulu
+ * impulsu dod tā, citādi lineārā ģeometrija
+ */
+static int damperToServoTicks(float position) {
+    float us = airflow_map_active(&activeAirflowMap) ? airflow_map_micros(&activeAirflowMap, position)
+                                                     : damperOpeningToMicros(position);
+    return microsToServoTicks(us);
+}
+
+// Damper pozīcija no servo pozīcijas: svira atpaliek par pusi no brīvkustības
+static float servoDamperPosition() {
+    float position = servoMotion.position - servoMoveDirection * servoBacklashPct / 2.0f;
+    return constrain(position, 0.0f, 100.0f);
+}
+
+static void attachServo() {
+    if (!servoAttached) {
+        mansServo.setTimerWidth(SERVO_TIMER_WIDTH_BITS);
+        mansServo.attach(servoPort);
+        servoAttached = true;
+        servoStats.attachCycles++;
+        lastServoTicks = -1;
+    }
+}
+
+static void detachServo() {
+    if (servoAttached) {
+        mansServo.detach();
+        servoAttached = false;
+    }
+}
+
+/**
+ * Kalibrācijas laikā servo tur lietotāja izvēlēto impulsu. Pēc kalibrācijas
+ * servo atgriežas pozīcijā, kas atbilst plānotāja pozīcijai jaunajā tabulā
+ */
+static bool serviceAirflowCalibration() {
+    if (airflowCalibrationActive) {
+        servoCalibrating = true;
+        attachServo();
+        int ticks = microsToServoTicks(airflowCalibrationMicros);
+        if (ticks != lastServoTicks) {
+            mansServo.writeTicks(ticks);
+            lastServoTicks = ticks;
+        }
+        return true;
     }
+    if (servoCalibrating) {
+        servoCalibrating = false;
+        if (!servoMoving) {
+            attachServo();
+            mansServo.writeTicks(damperToServoTicks(servoMotion.position));
+            vTaskDelay(pdMS_TO_TICKS(500));   // Lai servo paspēj aizbraukt pirms atslēgšanas
+            detachServo();
+        }
+        lastServoTicks = -1;
+    }
+    return false;
 }
 
 /**
@@ -312,74 +1197,157 @@ void damperControlLoop() {
 void setDamperTarget(int newTarget) {
     // Mainām mērķi tikai ja tas ir atšķirīgs no pašreizējā
     if (newTarget != targetDamper) {
+        // Backlash: servo mērķis ir par pusi brīvkustības tālāk kustības virzienā,
+        // tāpēc virziena maiņā servo vispirms izbrauc brīvkustību
+        float current = servoDamperPosition();
+        int8_t direction = newTarget > current ? 1 : (newTarget < current ? -1 : servoMoveDirection);
+        if (direction != 0 && servoMoveDirection != 0 && direction != servoMoveDirection) {
+            servoStats.reversals++;
+        }
+        servoMoveDirection = direction;
         targetDamper = newTarget;
-        servoMoving = true;
+        bool wasMoving = servoMoving;
+        servo_motion_set_target(&servoMotion, newTarget + direction * servoBacklashPct / 2.0f);
+        servoMoving = servoMotion.moving;
+        if (servoMoving && !wasMoving) {
+            servoStats.moves++;
+        }
         
         // Pieslēdzam servo tikai tad, kad tas ir nepieciešams
-        if (!servoAttached) {
-            mansServo.attach(servoPort);
-            servoAttached = true;
+        if (servoMoving) {
+            attachServo();
         }
     }
 }
 
+/**
+ * Vai pieprasījumu izpildīt. Mazas izmaiņas (deadband) servo nekustina -
+ * PID integrālis tās uzkrāj, līdz izmaiņa ir pietiekama. Galējās pozīcijas
+ * (pilnīgi ciet/vaļā) izpilda vienmēr
+ */
+static bool servoRequestAccepted(int requested) {
+    if (requested <= minDamper || requested >= maxDamper) {
+        return true;
+    }
+    if (abs(requested - targetDamper) >= servoDeadbandPct) {
+        return true;
+    }
+    if (requested != lastSuppressedDamper) {
+        lastSuppressedDamper = requested;
+        servoStats.suppressed++;
+    }
+    return false;
+}
+
 /**
  * Servo motora kustības apstrādes funkcija
- * Pakāpeniski kustina servo uz mērķa pozīciju
+ * Kustina servo pa trapecveida ātruma profilu (servo_motion.h); jaunu
+ * mērķi pieņem arī kustības laikā. Atgriež true, ja kustība turpinās un
+ * nākamais solis vajadzīgs pēc SERVO_STEP_PERIOD_MS
  */
-void moveServoToDamper() {
-    // Ja ir jauns mērķis un servo nav kustībā, sākam jaunu kustību
-    if ((damper != targetDamper) && !servoMoving && (currentDamper != damper)) {
-        // Telnet zinojums par servo kustibas sakumu
-        Telnet.println("INFO: Sakam servo kustibu no " + String(currentDamper) + "% uz " + String(damper) + "% poziciju");
-        setDamperTarget(damper);
+bool moveServoToDamper() {
+    TickType_t now = xTaskGetTickCount();
+    bool wasMoving = servoMoving;
+    controlStats.servoWakeups++;
+    if (!servoMotionReady) {
+        servo_motion_config_t config = servoMotionConfig();
+        servo_motion_init(&servoMotion, &config, targetDamper);
+        servoMotionReady = true;
+        lastMoveTime = now;
+    }
+    servo_motion_config_t config = servoMotionConfig();
+    servo_motion_configure(&servoMotion, &config);
+    if (airflowMapChanged) {
+        tableLockTake();
+        airflowMapChanged = false;
+        activeAirflowMap = airflowMap;
+        tableLockGive();
+        lastServoTicks = -1;
+    }
+    if (serviceAirflowCalibration()) {
+        controlStats.servoIdleWakeups++;
+        return false;
     }
+
+    // Mērķa pozīciju ņemam no regulatora publicētā stāvokļa
+    controller_state_t state;
+    controller_state_read(&state);
+    int requested = state.damper;
     
-    // Kustinām servo, ievērojot soļu intervālu
-    if (servoMoving && (xTaskGetTickCount() - lastMoveTime > pdMS_TO_TICKS(servoStepInterval))) {
-        int diff = targetDamper - currentDamper;
-        
-        if (abs(diff) > 0) {
-            // Vienmērīga kustība ar vienu soli vienā reizē
-            currentDamper += (diff > 0) ? 1 : -1;
-            
-            // Pārveidojam procentuālo pozīciju par leņķi
-            int angle = map(currentDamper, 0, 100, 
-                           servoOffset, 
-                           servoOffset + servoAngle / servoCalibration);
-            
-            // Pārveidojam leņķi mikrosekundēs
-            int us = map(angle, minAngle, maxAngle, minUs, maxUs);
-            
-            // Iestatām servo pozīciju
-            mansServo.writeMicroseconds(us);
-            lastMoveTime = xTaskGetTickCount();
+    if (requested != targetDamper && servoRequestAccepted(requested)) {
+        // Žurnālā servo kustības sākums vai mērķa maiņa
+        // Kustības laikā jauns mērķis tiek apvienots ar esošo kustību
+        if (servoMoving) {
+            servoStats.coalesced++;
+            LOG_DEBUG("servo", "Merkis mainits kustibas laika: %d%% -> %d%% (pozicija %.1f%%)",
+                     targetDamper, requested, servoDamperPosition());
         } else {
-            // Mērķis sasniegts
-            servoMoving = false;
-            oldDamper = currentDamper;
-            display_manager_notify_damper_position_changed();
-            
-            // Telnet zinojums par servo kustibas pabeigsanu
-            Telnet.println("INFO: Servo kustiba pabeigta. Damper pozicija: " + String(currentDamper) + "%");
-            
-            // Atslēdzam servo, lai taupītu enerģiju
-            if (servoAttached) {
-                mansServo.detach();
-                servoAttached = false;
-            }
+            LOG_DEBUG("servo", "Sakam kustibu no %d%% uz %d%% poziciju", targetDamper, requested);
         }
+        setDamperTarget(requested);
+        controller_state_set_servo(lroundf(servoDamperPosition()), servoMoving);
+    }
+    
+    // Faktiskais laiks kopš iepriekšējā soļa; pēc aiztures nelecam.
+    // Pirmais solis pēc miega ir viens periods, nevis viss miega laiks
+    float dtS = wasMoving ? (now - lastMoveTime) * portTICK_PERIOD_MS / 1000.0f
+                          : SERVO_STEP_PERIOD_MS / 1000.0f;
+    lastMoveTime = now;
+    if (!servoMoving) {
+        controlStats.servoIdleWakeups++;
+        return false;
+    }
+    if (dtS > SERVO_MAX_DT_S) {
+        dtS = SERVO_MAX_DT_S;
+    }
+
+    float previousPosition = servoMotion.position;
+    bool stillMoving = servo_motion_update(&servoMotion, dtS);
+    servoStats.travelPct += fabsf(servoMotion.position - previousPosition);
+    int ticks = damperToServoTicks(servoMotion.position);
+    if (ticks != lastServoTicks) {
+        mansServo.writeTicks(ticks);
+        lastServoTicks = ticks;
+    }
+    if (stillMoving) {
+        controller_state_set_servo(lroundf(servoDamperPosition()), servoMoving);
+        return true;
     }
+
+    // Mērķis sasniegts
+    servoMoving = false;
+    oldDamper = targetDamper;
+    controller_state_set_servo(targetDamper, servoMoving);
+    display_manager_notify_damper_position_changed();
+    
+    LOG_DEBUG("servo", "Kustiba pabeigta. Damper pozicija: %d%%", targetDamper);
+    
+    // Atslēdzam servo, lai taupītu enerģiju
+    detachServo();
+    return false;
 }
 
 /**
- * FreeRTOS uzdevuma funkcija, kas pastāvīgi apstrādā servo kustības
- * Darbojas atsevišķā kodolā ar zemu prioritāti
+ * Atgriež servo faktisko pozīciju (0-100%), kamēr damper ir tikai mērķis
+ */
+int getCurrentDamperPosition() {
+    return controller_state_servo_position();
+}
+
+/**
+ * FreeRTOS servo uzdevums. Kustības laikā mostas tieši ik pēc
+ * SERVO_STEP_PERIOD_MS (vTaskDelayUntil), bez kustības guļ uz uzdevuma
+ * paziņojumu, ko dod publishControllerState() pie jauna mērķa
  */
 void DamperTask(void *pvParameters) {
+    TickType_t lastWake = xTaskGetTickCount();
     while (1) {
-        moveServoToDamper();
-        vTaskDelay(pdMS_TO_TICKS(10)); // 10ms = 100Hz refresh rate
+        if (moveServoToDamper()) {
+            vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SERVO_STEP_PERIOD_MS));
+        } else {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            lastWake = xTaskGetTickCount();
+        }
     }
 }
 
@@ -391,55 +1359,34 @@ void startDamperControlTask() {
     // Inicializējam buzzer
     initBuzzer();
     
-    // Pievienojam uzdevumu otrajam kodolam ar zemu prioritāti
+    // Sensora rinda starp updateTemperature() un kontroles uzdevumu
+    sensorQueue = xQueueCreate(SENSOR_QUEUE_LENGTH, sizeof(temperature_sample_t));
+    tableLock = xSemaphoreCreateMutex();
+    fire_detector_config_t fireConfig = fireDetectorConfig();
+    fire_detector_init(&fireDetector, &fireConfig);
+    
+    // Sākuma stāvoklis, lai servo uzdevumam ir ko lasīt jau pirms pirmā regulatora soļa
+    publishControllerState();
+    
+    // Kontroles uzdevums tajā pašā kodolā kā loop(), bet ar augstāku prioritāti
     xTaskCreatePinnedToCore(
-        DamperTask,          // Uzdevuma funkcija
-        "DamperTask",        // Uzdevuma nosaukums
-        2048,                // Steka izmērs
+        ControlTask,         // Uzdevuma funkcija
+        "ControlTask",       // Uzdevuma nosaukums
+        4096,                // Steka izmērs
         NULL,                // Parametri (nav)
-        1,                   // Prioritāte (zema)
-        &damperTaskHandle,   // Uzdevuma rokturis
+        3,                   // Prioritāte (virs loop() = 1)
+        &controlTaskHandle,  // Uzdevuma rokturis
         1                    // Kodola numurs (1 = otrs kodols)
     );
     
-    // Pievienojam buzzer uzdevumu otrajam kodolam
+    // Pievienojam uzdevumu otrajam kodolam ar zemu prioritāti
     xTaskCreatePinnedToCore(
-        buzzerTask,          // Uzdevuma funkcija
-        "BuzzerTask",        // Uzdevuma nosaukums
-        1024,                // Steka izmērs
+        DamperTask,          // Uzdevuma funkcija
+        "DamperTask",        // Uzdevuma nosaukums
+        3072,                // Steka izmērs (žurnāla rindu formatē uz steka)
         NULL,                // Parametri (nav)
         1,                   // Prioritāte (zema)
-        &buzzerTaskHandle,   // Uzdevuma rokturis
+        &damperTaskHandle,   // Uzdevuma rokturis
         1                    // Kodola numurs (1 = otrs kodols)
     );
 }
-
-/**
- * Pārbauda, vai ir pagājušas 4 minūtes ar zemu temperatūru un ieej deep sleep, ja nepieciešams
- * Šo funkciju izsauc updateTemperature() ik pēc 3 sekundēm
- */
-void checkLowTempDeepSleep() {
-    // Pārbaudām vai ir aktīvs zemas temperatūras režīms
-    if (lowTempCheckActive) {
-        // Pārbaudām, vai ir pagājušas 4 minūtes un temperatūra nav paaugstinājusies
-        if (millis() - lowTempStartTime > LOW_TEMP_TIMEOUT && 
-            temperature < (initialTemperature + 3) && !servoMoving) {
-            // Telnet ziņojumi pirms deep sleep
-            Telnet.println("");
-            Telnet.println("*****************************************************************");
-            Telnet.print("IZPILDAS [");
-            Telnet.print(millis()/1000);
-            Telnet.println(" s]: Zemas temperaturas parbaudes timeout");
-            Telnet.println("BRIDINAJUMS: 4 minutes pagajusas, bet temperatura nav paaugstinajusies par 3 C");
-            Telnet.println("Sakotneja temp: " + String(initialTemperature) + " C, Pasreizeja temp: " + String(temperature) + " C");
-            Telnet.println("BRIDINAJUMS: Temperatura nav pieaugusi pietiekami. Parejam deep sleep rezima pec 0.5s");
-            Telnet.println("*****************************************************************");
-            
-            // Ļaujam lietotājam redzēt ziņojumu
-            delay(500);
-            
-            // Aizejam dziļajā miegā
-            ieietDeepSleepArTouch();
-        }
-    }
-}
\ No newline at end of file
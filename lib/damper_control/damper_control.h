@@ -1,21 +1,132 @@
 #pragma once
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "pid_controller.h"
+#include "controller_state.h"
+#include "gain_schedule.h"
+#include "airflow_map.h"
+#include "buzzer_pattern.h"
+
+// Regulatora solis tiek izpildīts ar fiksētu periodu neatkarīgi no tempReadIntervalMs
+#define DAMPER_CONTROL_PERIOD_MS 1000
+#define DAMPER_CONTROL_MAX_DT_S  10.0f   // Lielāku pauzi neintegrējam
+#define DAMPER_DEFICIT_SAMPLE_S  4.0f    // errI mērvienība: °C × 4 s (agrākais nolasījuma intervāls)
+
+// Kaskādes ārējā cilpa (istaba -> targetTempC)
+#define CASCADE_PERIOD_MS      60000
+#define CASCADE_TARGET_STEP_C  1.0f    // targetTempC mainās tikai pa veselu grādu
+
+// Feed-forward aizver tikai pēdējos grādos līdz mērķim (pilnā mērā pie mērķa)
+#define FF_APPROACH_BAND_C 6.0f
+
+// Autotune rezultāta robežas (pid_autotune.h)
+#define AUTOTUNE_KP_MIN       1
+#define AUTOTUNE_KP_MAX       200
+#define AUTOTUNE_TAU_I_MIN_S  60.0f
+#define AUTOTUNE_TAU_I_MAX_S  5000.0f
+
+// Servo kustības profils (servo_motion.h); maksimālo ātrumu nosaka servoStepInterval
+#define SERVO_ACCEL_PCT_PER_S2  1000.0f   // Līdz 100 %/s 0.1 s laikā
+#define SERVO_MAX_DT_S          0.1f      // Pēc servo uzdevuma aiztures nelecam
+#define SERVO_STEP_PERIOD_MS    10        // Kustības solis; bez kustības uzdevums guļ
+#define SERVO_PWM_PERIOD_US     20000.0f  // 50 Hz
+#define SERVO_TIMER_WIDTH_BITS  14        // ESP32-S3 LEDC maksimums pie 50 Hz
+
+#define SENSOR_QUEUE_LENGTH 4
+
+// Kontroles uzdevuma perioda novirzes histogramma: 100 us joslas līdz 12.7 ms
+#define CONTROL_JITTER_BIN_US 100
+#define CONTROL_JITTER_BINS   128
+
+// Rādījumi visā ķēdē ir °C × 16 (DS18B20 12 bitu solis 0.0625 °C)
+#define TEMP_C16_SCALE 16
+
+// Viena nolasīšanas kārta, ko SensorTask nodod kontroles uzdevumam un loop()
+typedef struct {
+    int16_t channelC16[TEMP_CHANNEL_COUNT];   // Filtrēts (mediāna + EMA)
+    int16_t rawC16[TEMP_CHANNEL_COUNT];       // Tieši no scratchpad
+    uint8_t validMask;                        // 1 << kanāls, ja rādījums derīgs
+    unsigned long timestampMs;
+} temperature_sample_t;
+
+// Servo nolietojuma skaitītāji kopš palaišanas vai "servo reset"
+typedef struct {
+    uint32_t moves;               // Kustības no miera stāvokļa
+    float travelPct;              // Servo ceļš (%, ar backlash)
+    uint32_t attachCycles;        // Servo pieslēgšanas
+    uint32_t reversals;           // Virziena maiņas
+    uint32_t coalesced;           // Jauni mērķi, kas apvienoti ar notiekošu kustību
+    uint32_t suppressed;          // Pieprasījumi deadband robežās
+    unsigned long sinceMs;
+} servo_actuator_stats_t;
+
+typedef struct {
+    uint32_t periods;
+    uint32_t minPeriodUs;
+    uint32_t maxPeriodUs;
+    uint32_t maxExecUs;
+    uint32_t missedDeadlines;
+    uint32_t jitterHist[CONTROL_JITTER_BINS];
+    uint32_t servoWakeups;        // Servo uzdevuma pamošanās
+    uint32_t servoIdleWakeups;    // ... no tām bez kustības
+    unsigned long sinceMs;        // Kopš pēdējās nodzēšanas
+} control_task_stats_t;
 
 void damperControlInit();
 void damperControlLoop();
-int average(const int* arr, int start, int count);
-bool WoodFilled(int CurrentTemp);
-void moveServoToDamper();
+void damperControlTaskStep();
+bool damperControlPostSample(const temperature_sample_t* sample);
+
+// Autotune (telnet "autotune"): lēciena eksperiments -> kP/tauI -> NVS.
+// Rezultātu pielieto un saglabā damperControlApplyAutotune(), ko sauc loop()
+bool damperControlRequestAutotune(float stepPct);
+void damperControlAbortAutotune();
+void damperControlApplyAutotune();
+bool damperControlAutotuneRunning();
+void damperControlPrintAutotune(Print &out);
+
+// Servo nolietojums (telnet "servo")
+servo_actuator_stats_t damperControlGetServoStats();
+void damperControlResetServoStats();
+void damperControlPrintServoStats(Print &out);
+
+// Pastiprinājumu grafiks (telnet "gains"): jauno tabulu sagatavo lokāli un
+// publicē ar damperControlSetGainSchedule(); kontroles uzdevums to paņem nākamajā solī
+void damperControlSetGainSchedule(const gain_schedule_t* schedule);
+void damperControlPrintGainSchedule(Print &out);
+
+// Gaisa plūsmas tabula (telnet "airflow"): jauno tabulu sagatavo lokāli un
+// publicē ar damperControlSetAirflowMap(). Kalibrācija soli pa solim iziet plūsmas
+// punktus; lietotājs ar jog pieregulē impulsu, "ok" apstiprina
+void damperControlSetAirflowMap(const airflow_map_t* map);
+void damperControlPrintAirflowMap(Print &out);
+void damperControlStartAirflowCalibration();
+bool damperControlAirflowCalibrationActive();
+void damperControlJogAirflowCalibration(int deltaUs);
+bool damperControlAcceptAirflowCalibration();   // false = impulss nav monotons
+void damperControlStopAirflowCalibration();
+
+// Lineārā servo ģeometrija (servoOffset, servoAngle): atvērums % <-> impulss us
+float damperOpeningToMicros(float openingPct);
+float damperMicrosToOpening(float micros);
+
+// Kontroles uzdevuma jitter statistika (telnet komanda "jitter")
+control_task_stats_t damperControlGetStats();
+uint32_t damperControlJitterPercentileUs(uint8_t percentile);
+void damperControlResetStats();
+void damperControlPrintStats(Print &out);
+bool moveServoToDamper();   // true = kustība turpinās
+int getCurrentDamperPosition();
 void startDamperControlTask();
 void ieietDeepSleepArTouch();
-void checkLowTempDeepSleep();
 
-// Buzzer funkcijas
+// Buzzer: nosaukti raksti ar prioritāti (buzzer_pattern.h), bez kustības CPU netērē
 void initBuzzer();
-void playWarningSound();
-void startBuzzerSound();
-void stopBuzzerSound();
-void buzzerTask(void *pvParameters);
+void buzzerSetPattern(buzzer_pattern_id_t pattern, bool active);
+void buzzerMute(bool muted);   // true - apklusina šobrīd aktīvos rakstus, false - atceļ
+buzzer_pattern_id_t buzzerCurrentPattern();
+void buzzerPrintStatus(Print &out);
 
 
 extern int damper;
@@ -29,21 +140,40 @@ extern float kI;  // PID integrāla koeficients
 extern float kD;  // PID diferenciālā koeficients
 extern float endTrigger;
 extern float refillTrigger;
-extern String messageDamp;
-extern bool servoMoving;
+extern damper_mode_t damperMode;
 extern float errP;
 extern float errI;
 extern float errD;
-extern float errOld;
+extern int woodFillRecentS;
+extern int woodFillOlderS;
+extern PidController damperPid;
+extern TaskHandle_t damperTaskHandle;   // Servo uzdevums (paziņojums pie jauna mērķa)
+
+// Feed-forward (pieskaita PID izejai pirms constrain)
+extern float ffTrendGain;    // % uz °C/min kāpuma virs sliekšņa
+extern float ffRefillBoost;  // Pastiprinājuma pieaugums pēc piekraušanas (×)
+extern float ffRefillTauS;   // Tā dzišanas laika konstante (s)
+extern float ffTerm;        // Pēdējā soļa vērtība (%)
+
+// kP/tauI reizinātāji pēc temperatūras (gain_schedule.h)
+extern gain_schedule_t gainSchedule;
+
+// Kaskāde (istabas temperatūra -> dūmgāzu mērķis)
+extern bool cascadeEnabled;
+extern float roomTargetC;
+extern float cascadeKp;    // °C dūmgāzu mērķa uz °C istabas kļūdas
+extern float cascadeTauI;  // Ārējās cilpas integrāla laika konstante (s)
 
 // Servo parametri
 extern int servoAngle;  // Servo motora maksimālais leņķis
 extern int servoOffset;  // Servo pozīcijas nobīde
-extern int servoStepInterval;  // Servo kustības solis milisekundēs
+extern int servoStepInterval;  // Maksimālais servo ātrums: ms uz 1 %
+extern int servoDeadbandPct;   // Mazāku izmaiņu servo neizpilda (%)
+extern float servoBacklashPct; // Sviras brīvkustība (%)
+extern airflow_map_t airflowMap;  // Gaisa plūsma % -> impulss (tukša = lineāri)
 
-// Buzzer pins un statuss
+// Buzzer pins
 extern int buzzer;
-extern bool isWarningActive;
 
 // Zemas temperatūras pārbaudes statuss
 extern bool lowTempCheckActive;
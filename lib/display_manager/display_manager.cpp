@@ -114,7 +114,7 @@ void display_manager_update() {
         dm_state.force_damper_update = false;
     }
     
-    // Separate handling for damper status (only when messageDamp changes)
+    // Separate handling for damper status (only when damperMode changes)
     if (dm_state.force_damper_status_update || dm_state.force_all_update) {
         lvgl_display_update_damper_status();
         dm_state.force_damper_status_update = false;
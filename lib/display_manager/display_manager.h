@@ -34,7 +34,7 @@ void display_manager_set_update_intervals(
 
 // Event notification functions (call when data changes)
 void display_manager_notify_temperature_changed();
-void display_manager_notify_damper_changed();          // For messageDamp changes
+void display_manager_notify_damper_changed();          // For damperMode changes
 void display_manager_notify_damper_position_changed();  // For damper position changes
 void display_manager_notify_target_temp_changed();
 void display_manager_notify_time_synced();             // Call when NTP time is synchronized
@@ -0,0 +1,199 @@
+#include "fire_detector.h"
+#include <string.h>
+#include <math.h>
+
+static const char* const PHASE_LABELS[FIRE_PHASE_COUNT] = {
+    "UNKNOWN", "COLD", "RISING", "STEADY", "DECAY", "BURNOUT",
+};
+
+static const char* const EVENT_LABELS[FIRE_EVENT_COUNT] = {
+    "NONE", "IGNITION", "REFUEL", "PEAK", "DECAY", "BURNOUT",
+};
+
+fire_detector_config_t fire_detector_default_config(uint16_t samplePeriodMs) {
+    fire_detector_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.samplePeriodMs = samplePeriodMs;
+    config.trendWindowS = 120;
+    config.baselineWindowS = 120;
+    config.riseSlopeCPerMin = 0.5f;
+    config.fallSlopeCPerMin = -0.2f;
+    config.refuelRiseC = 1.0f;
+    config.coldTempC = 40.0f;
+    config.confirmMs = 60000;
+    config.decayConfirmMs = 300000;
+    config.burnoutHoldMs = 240000;
+    return config;
+}
+
+static void apply_windows(fire_detector_t* d) {
+    temp_history_t* h = &d->history;
+    uint16_t trend = temp_history_samples_for_ms(h, (unsigned long)d->config.trendWindowS * 1000UL);
+    uint16_t baseline = temp_history_samples_for_ms(h, (unsigned long)d->config.baselineWindowS * 1000UL);
+    if (trend + baseline >= TEMP_HISTORY_CAPACITY) {
+        baseline = TEMP_HISTORY_CAPACITY - 1 - trend;
+    }
+
+    if (d->trendWindow < 0) {
+        d->trendWindow = temp_history_add_window(h, trend, 0);
+        d->baselineWindow = temp_history_add_window(h, baseline, trend);
+        return;
+    }
+
+    const temp_history_window_t& t = h->windows[d->trendWindow];
+    const temp_history_window_t& b = h->windows[d->baselineWindow];
+    if (t.length != trend || b.length != baseline || b.offset != trend) {
+        temp_history_set_window(h, d->trendWindow, trend, 0);
+        temp_history_set_window(h, d->baselineWindow, baseline, trend);
+    }
+}
+
+void fire_detector_init(fire_detector_t* detector, const fire_detector_config_t* config) {
+    memset(detector, 0, sizeof(*detector));
+    detector->config = *config;
+    detector->trendWindow = -1;
+    detector->baselineWindow = -1;
+    detector->phase = FIRE_PHASE_UNKNOWN;
+    detector->candidate = FIRE_PHASE_UNKNOWN;
+    temp_history_init(&detector->history, config->samplePeriodMs);
+    apply_windows(detector);
+}
+
+void fire_detector_configure(fire_detector_t* detector, const fire_detector_config_t* config) {
+    // Parauga periodu pēc init nemaina - vēsture jau ir šajā solī
+    const uint16_t period = detector->config.samplePeriodMs;
+    detector->config = *config;
+    detector->config.samplePeriodMs = period;
+    apply_windows(detector);
+}
+
+static void log_event(fire_detector_t* d, fire_event_type_t type, unsigned long nowMs) {
+    fire_event_t* e = &d->events[d->eventHead];
+    e->type = type;
+    e->timestampMs = nowMs;
+    e->temperatureC = d->meanC;
+    e->slopeCPerMin = d->slopeCPerMin;
+    d->eventHead = (uint8_t)((d->eventHead + 1) % FIRE_DETECTOR_EVENT_LOG);
+    if (d->eventCount < FIRE_DETECTOR_EVENT_LOG) {
+        d->eventCount++;
+    }
+    d->eventTotals[type]++;
+}
+
+// Nākamā fāze pēc pašreizējā trenda (bez confirmMs)
+static fire_phase_t next_phase(const fire_detector_t* d, bool baselineReady) {
+    const fire_detector_config_t& c = d->config;
+    const bool rising = d->slopeCPerMin >= c.riseSlopeCPerMin;
+    const bool falling = d->slopeCPerMin <= c.fallSlopeCPerMin;
+    const bool cold = d->meanC <= c.coldTempC;
+
+    switch (d->phase) {
+        case FIRE_PHASE_UNKNOWN:
+            // Pirmā klasifikācija (piem., pēc pamošanās krāsns vidū) - bez notikuma
+            if (rising) return FIRE_PHASE_RISING;
+            if (cold) return FIRE_PHASE_COLD;
+            return falling ? FIRE_PHASE_DECAY : FIRE_PHASE_STEADY;
+
+        case FIRE_PHASE_COLD:
+        case FIRE_PHASE_BURNOUT:
+            return rising ? FIRE_PHASE_RISING : d->phase;
+
+        case FIRE_PHASE_RISING:
+            return rising ? FIRE_PHASE_RISING : FIRE_PHASE_STEADY;
+
+        case FIRE_PHASE_STEADY:
+        case FIRE_PHASE_DECAY:
+            // Jauna malka: kāpums, kas redzams arī vidējos (ne tikai trokšņa slīpumā)
+            if (rising && baselineReady && d->meanC - d->baselineMeanC >= c.refuelRiseC) {
+                return FIRE_PHASE_RISING;
+            }
+            if (cold && !rising) return FIRE_PHASE_COLD;
+            return falling ? FIRE_PHASE_DECAY : FIRE_PHASE_STEADY;
+
+        default:
+            return d->phase;
+    }
+}
+
+static fire_event_type_t transition_event(fire_phase_t from, fire_phase_t to) {
+    switch (to) {
+        case FIRE_PHASE_RISING:
+            if (from == FIRE_PHASE_COLD || from == FIRE_PHASE_BURNOUT) return FIRE_EVENT_IGNITION;
+            if (from == FIRE_PHASE_STEADY || from == FIRE_PHASE_DECAY) return FIRE_EVENT_REFUEL;
+            return FIRE_EVENT_NONE;
+        case FIRE_PHASE_STEADY:
+            return from == FIRE_PHASE_RISING ? FIRE_EVENT_PEAK : FIRE_EVENT_NONE;
+        case FIRE_PHASE_DECAY:
+            return from == FIRE_PHASE_STEADY ? FIRE_EVENT_DECAY : FIRE_EVENT_NONE;
+        default:
+            return FIRE_EVENT_NONE;
+    }
+}
+
+fire_event_type_t fire_detector_update(fire_detector_t* detector, unsigned long nowMs, float temperatureC) {
+    fire_detector_t* d = detector;
+    temp_history_push(&d->history, (int16_t)lroundf(temperatureC * FIRE_DETECTOR_SCALE));
+
+    temp_window_stats_t trend;
+    if (!temp_history_window_stats(&d->history, d->trendWindow, &trend)) {
+        return FIRE_EVENT_NONE;
+    }
+    d->meanC = trend.mean / FIRE_DETECTOR_SCALE;
+    d->slopeCPerMin = trend.slopePerS * 60.0f / FIRE_DETECTOR_SCALE;
+
+    temp_window_stats_t baseline;
+    const bool baselineReady = temp_history_window_stats(&d->history, d->baselineWindow, &baseline);
+    if (baselineReady) {
+        d->baselineMeanC = baseline.mean / FIRE_DETECTOR_SCALE;
+    }
+
+    fire_event_type_t event = FIRE_EVENT_NONE;
+    const fire_phase_t next = next_phase(d, baselineReady);
+
+    if (next == d->phase) {
+        d->candidate = d->phase;
+    } else if (d->phase == FIRE_PHASE_UNKNOWN) {
+        d->phase = next;
+        d->candidate = next;
+        d->phaseSinceMs = nowMs;
+    } else if (next != d->candidate) {
+        d->candidate = next;
+        d->candidateSinceMs = nowMs;
+    } else if (nowMs - d->candidateSinceMs >= (next == FIRE_PHASE_DECAY ? d->config.decayConfirmMs : d->config.confirmMs)) {
+        event = transition_event(d->phase, next);
+        d->phase = next;
+        // Fāze sākās, kad nosacījums parādījās, nevis kad tas apstiprināts
+        d->phaseSinceMs = d->candidateSinceMs;
+    }
+
+    // Izdegšana: auksta krāsns bez kāpuma burnoutHoldMs laikā
+    if (event == FIRE_EVENT_NONE && d->phase == FIRE_PHASE_COLD &&
+        nowMs - d->phaseSinceMs >= d->config.burnoutHoldMs) {
+        d->phase = FIRE_PHASE_BURNOUT;
+        d->candidate = FIRE_PHASE_BURNOUT;
+        d->phaseSinceMs = nowMs;
+        event = FIRE_EVENT_BURNOUT;
+    }
+
+    if (event != FIRE_EVENT_NONE) {
+        log_event(d, event, nowMs);
+    }
+    return event;
+}
+
+bool fire_detector_event(const fire_detector_t* detector, uint8_t index, fire_event_t* out) {
+    if (index >= detector->eventCount) {
+        return false;
+    }
+    const uint8_t pos = (uint8_t)((detector->eventHead + FIRE_DETECTOR_EVENT_LOG - 1 - index) % FIRE_DETECTOR_EVENT_LOG);
+    *out = detector->events[pos];
+    return true;
+}
+
+const char* fire_phase_label(fire_phase_t phase) {
+    return phase < FIRE_PHASE_COUNT ? PHASE_LABELS[phase] : "?";
+}
+
+const char* fire_event_label(fire_event_type_t type) {
+    return type < FIRE_EVENT_COUNT ? EVENT_LABELS[type] : "?";
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <stdint.h>
+#include "temp_history.h"
+
+/**
+ * Fire Detector - kurināšanas fāžu un notikumu noteikšana pēc temperatūras slīpuma
+ *
+ * Katrā regulatora solī saņem vienu rādījumu. Slīpumu (°C/min) rēķina ar
+ * mazāko kvadrātu metodi pār trendWindowS logu (temp_history), tāpēc viens
+ * sensora lēciens neizraisa notikumu. Fāzes maiņai jāpastāv confirmMs.
+ *
+ *   COLD --kāpums--> RISING --plato--> STEADY <--kritums--> DECAY
+ *     ^  (IGNITION)    ^     (PEAK)           (DECAY)        |
+ *     |                +------ kāpums (REFUEL) ---------------+
+ *     +-- burnoutHoldMs zem coldTempC bez kāpuma --> BURNOUT
+ *
+ * STEADY ir arī regulēts stāvoklis pie mērķa (PID tur temperatūru).
+ *
+ * Bez Arduino atkarībām - to pašu kodu host rīks (src/native/fire_main.cpp)
+ * palaiž pret sintētiskām un ierakstītām trasēm.
+ */
+
+#define FIRE_DETECTOR_EVENT_LOG 16   // Pēdējie notikumi
+#define FIRE_DETECTOR_SCALE     16   // Vēsturē glabā °C × 16 (DS18B20 12 bitu solis)
+
+typedef enum : uint8_t {
+    FIRE_PHASE_UNKNOWN = 0,   // Trenda logs vēl nav pilns
+    FIRE_PHASE_COLD,          // Zem coldTempC, nekas nekāpj
+    FIRE_PHASE_RISING,        // Iekuršana vai jauna malka
+    FIRE_PHASE_STEADY,        // Plato (pēc kāpuma vai regulēts pie mērķa)
+    FIRE_PHASE_DECAY,         // Temperatūra krīt
+    FIRE_PHASE_BURNOUT,       // Izdegusi
+    FIRE_PHASE_COUNT
+} fire_phase_t;
+
+typedef enum : uint8_t {
+    FIRE_EVENT_NONE = 0,
+    FIRE_EVENT_IGNITION,      // Kāpums no auksta stāvokļa
+    FIRE_EVENT_REFUEL,        // Kāpums pēc plato/krituma
+    FIRE_EVENT_PEAK,          // Kāpums beidzies
+    FIRE_EVENT_DECAY,         // Plato pārgājis kritumā
+    FIRE_EVENT_BURNOUT,
+    FIRE_EVENT_COUNT
+} fire_event_type_t;
+
+typedef struct {
+    fire_event_type_t type;
+    unsigned long timestampMs;
+    float temperatureC;       // Trenda loga vidējā temperatūra
+    float slopeCPerMin;
+} fire_event_t;
+
+typedef struct {
+    uint16_t samplePeriodMs;
+    uint16_t trendWindowS;          // Slīpuma logs
+    uint16_t baselineWindowS;       // Logs pirms trenda loga (REFUEL salīdzinājumam)
+    float riseSlopeCPerMin;         // Virs šī - kāpums
+    float fallSlopeCPerMin;         // Zem šī - kritums (negatīvs)
+    float refuelRiseC;              // REFUEL: trenda vidējais - bāzes vidējais
+    float coldTempC;                // Zem šīs temperatūras krāsns ir auksta
+    unsigned long confirmMs;        // Cik ilgi jāpastāv jaunai fāzei
+    unsigned long decayConfirmMs;   // DECAY - ilgāk, lai regulēšanas svārstības nebūtu kritums
+    unsigned long burnoutHoldMs;    // Cik ilgi COLD bez kāpuma līdz BURNOUT
+} fire_detector_config_t;
+
+typedef struct {
+    fire_detector_config_t config;
+    temp_history_t history;
+    int trendWindow;
+    int baselineWindow;
+
+    fire_phase_t phase;
+    fire_phase_t candidate;           // Fāze, kas gaida confirmMs
+    unsigned long candidateSinceMs;
+    unsigned long phaseSinceMs;
+
+    float meanC;                      // Pēdējā trenda loga statistika
+    float slopeCPerMin;
+    float baselineMeanC;
+
+    fire_event_t events[FIRE_DETECTOR_EVENT_LOG];
+    uint8_t eventHead;
+    uint8_t eventCount;
+    uint32_t eventTotals[FIRE_EVENT_COUNT];
+} fire_detector_t;
+
+fire_detector_config_t fire_detector_default_config(uint16_t samplePeriodMs);
+void fire_detector_init(fire_detector_t* detector, const fire_detector_config_t* config);
+
+// Maina konfigurāciju; vēstures logus pārrēķina tikai, ja mainās to garumi
+void fire_detector_configure(fire_detector_t* detector, const fire_detector_config_t* config);
+
+// Jauns rādījums. Atgriež šajā solī radušos notikumu vai FIRE_EVENT_NONE.
+fire_event_type_t fire_detector_update(fire_detector_t* detector, unsigned long nowMs, float temperatureC);
+
+// index 0 = jaunākais notikums. Atgriež false, ja tāda nav.
+bool fire_detector_event(const fire_detector_t* detector, uint8_t index, fire_event_t* out);
+
+const char* fire_phase_label(fire_phase_t phase);
+const char* fire_event_label(fire_event_type_t type);
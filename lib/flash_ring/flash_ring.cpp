@@ -0,0 +1,217 @@
+#include "flash_ring.h"
+#include <string.h>
+
+#define ERASED_U16 0xFFFFu
+#define ERASED_U32 0xFFFFFFFFu
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+} flash_ring_header_t;
+
+static uint32_t sectorAddress(const flash_ring_t* ring, uint16_t sector, uint32_t offset) {
+    return ring->baseOffset + (uint32_t)sector * FLASH_RING_SECTOR_SIZE + offset;
+}
+
+static bool readHeader(const flash_ring_t* ring, uint16_t sector, flash_ring_header_t* header) {
+    return ring->io.read(ring->io.ctx, sectorAddress(ring, sector, 0), header, sizeof(*header)) &&
+           header->magic == ring->magic && header->sequence != 0 && header->sequence != ERASED_U32;
+}
+
+// Izdzēš sektoru un ieraksta galveni - tas kļūst par jaunāko
+static bool openSector(flash_ring_t* ring, uint16_t sector, uint32_t sequence) {
+    const flash_ring_header_t header = {ring->magic, sequence};
+    ring->erases++;
+    if (!ring->io.erase(ring->io.ctx, sectorAddress(ring, sector, 0), FLASH_RING_SECTOR_SIZE) ||
+        !ring->io.write(ring->io.ctx, sectorAddress(ring, sector, 0), &header, sizeof(header))) {
+        ring->errors++;
+        return false;
+    }
+    ring->headSector = sector;
+    ring->headSequence = sequence;
+    ring->writeOffset = FLASH_RING_HEADER_SIZE;
+    return true;
+}
+
+static bool openNextSector(flash_ring_t* ring) {
+    const uint16_t next = (uint16_t)((ring->headSector + 1) % ring->sectorCount);
+    if (!openSector(ring, next, ring->headSequence + 1)) {
+        return false;
+    }
+    if (ring->usedSectors < ring->sectorCount) {
+        ring->usedSectors++;
+    }
+    return true;
+}
+
+// Vai no offset līdz sektora beigām viss ir dzēsts (0xFF)
+static bool sectorTailErased(const flash_ring_t* ring, uint16_t sector, uint32_t offset) {
+    uint8_t chunk[64];
+    while (offset < FLASH_RING_SECTOR_SIZE) {
+        uint32_t n = FLASH_RING_SECTOR_SIZE - offset;
+        if (n > sizeof(chunk)) {
+            n = sizeof(chunk);
+        }
+        if (!ring->io.read(ring->io.ctx, sectorAddress(ring, sector, offset), chunk, n)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            if (chunk[i] != 0xFF) {
+                return false;
+            }
+        }
+        offset += n;
+    }
+    return true;
+}
+
+// Rakstīšanas vieta head sektorā. Bojātu asti neizmantojam - nākamais
+// ieraksts sāks jaunu sektoru
+static uint32_t findWriteOffset(const flash_ring_t* ring) {
+    uint32_t offset = FLASH_RING_HEADER_SIZE;
+    while (offset + FLASH_RING_RECORD_HEADER <= FLASH_RING_SECTOR_SIZE) {
+        uint16_t length = 0;
+        if (!ring->io.read(ring->io.ctx, sectorAddress(ring, ring->headSector, offset), &length, sizeof(length))) {
+            return FLASH_RING_SECTOR_SIZE;
+        }
+        if (length == ERASED_U16) {
+            return sectorTailErased(ring, ring->headSector, offset) ? offset : FLASH_RING_SECTOR_SIZE;
+        }
+        if (length == 0 || offset + FLASH_RING_RECORD_HEADER + length > FLASH_RING_SECTOR_SIZE) {
+            return FLASH_RING_SECTOR_SIZE;
+        }
+        offset += FLASH_RING_RECORD_HEADER + length;
+    }
+    return FLASH_RING_SECTOR_SIZE;
+}
+
+void flash_ring_init(flash_ring_t* ring, const flash_ring_io_t* io, uint32_t baseOffset,
+                     uint16_t sectorCount, uint32_t magic) {
+    memset(ring, 0, sizeof(*ring));
+    ring->io = *io;
+    ring->baseOffset = baseOffset;
+    ring->sectorCount = sectorCount;
+    ring->magic = magic;
+}
+
+bool flash_ring_mount(flash_ring_t* ring) {
+    ring->mounted = false;
+    if (ring->sectorCount == 0) {
+        return false;
+    }
+
+    bool found = false;
+    for (uint16_t sector = 0; sector < ring->sectorCount; sector++) {
+        flash_ring_header_t header;
+        if (readHeader(ring, sector, &header) && (!found || header.sequence > ring->headSequence)) {
+            ring->headSector = sector;
+            ring->headSequence = header.sequence;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        ring->usedSectors = 1;
+        ring->mounted = openSector(ring, 0, 1);
+        return ring->mounted;
+    }
+
+    // Derīgi ir tikai sektori, kas iet pēc kārtas līdz head; vecas
+    // atliekas aiz pārrāvuma tiks pārrakstītas, kad aplis līdz tām nonāks
+    ring->usedSectors = 1;
+    while (ring->usedSectors < ring->sectorCount) {
+        const uint16_t sector = (uint16_t)((ring->headSector + ring->sectorCount - ring->usedSectors) % ring->sectorCount);
+        flash_ring_header_t header;
+        if (!readHeader(ring, sector, &header) || header.sequence != ring->headSequence - ring->usedSectors) {
+            break;
+        }
+        ring->usedSectors++;
+    }
+
+    ring->writeOffset = findWriteOffset(ring);
+    ring->mounted = true;
+    return true;
+}
+
+bool flash_ring_append(flash_ring_t* ring, const void* data, uint16_t size) {
+    if (!ring->mounted || size == 0 || size > FLASH_RING_RECORD_MAX) {
+        ring->errors++;
+        return false;
+    }
+    if (ring->writeOffset + FLASH_RING_RECORD_HEADER + size > FLASH_RING_SECTOR_SIZE && !openNextSector(ring)) {
+        return false;
+    }
+
+    // Vispirms dati, tad garums: pārrāvums pa vidu atstāj 0xFFFF garumu
+    const uint32_t address = sectorAddress(ring, ring->headSector, ring->writeOffset);
+    if (!ring->io.write(ring->io.ctx, address + FLASH_RING_RECORD_HEADER, data, size) ||
+        !ring->io.write(ring->io.ctx, address, &size, sizeof(size))) {
+        ring->errors++;
+        ring->writeOffset = FLASH_RING_SECTOR_SIZE;   // Nākamais ieraksts - jaunā sektorā
+        return false;
+    }
+    ring->writeOffset += FLASH_RING_RECORD_HEADER + size;
+    ring->records++;
+    ring->bytesWritten += FLASH_RING_RECORD_HEADER + size;
+    return true;
+}
+
+bool flash_ring_erase_all(flash_ring_t* ring) {
+    bool ok = true;
+    for (uint16_t sector = 1; sector < ring->sectorCount; sector++) {
+        ring->erases++;
+        ok &= ring->io.erase(ring->io.ctx, sectorAddress(ring, sector, 0), FLASH_RING_SECTOR_SIZE);
+    }
+    ring->usedSectors = 1;
+    ok &= openSector(ring, 0, 1);
+    ring->mounted = ok;
+    return ok;
+}
+
+uint16_t flash_ring_head_free(const flash_ring_t* ring) {
+    const uint32_t used = ring->writeOffset + FLASH_RING_RECORD_HEADER;
+    return used < FLASH_RING_SECTOR_SIZE ? (uint16_t)(FLASH_RING_SECTOR_SIZE - used) : 0;
+}
+
+void flash_ring_cursor_init(const flash_ring_t* ring, flash_ring_cursor_t* cursor, uint16_t sectorsBack) {
+    if (ring->usedSectors == 0) {
+        cursor->sector = ring->headSector;
+        cursor->remaining = 0;
+        cursor->offset = FLASH_RING_SECTOR_SIZE;
+        return;
+    }
+    if (sectorsBack > ring->usedSectors - 1) {
+        sectorsBack = ring->usedSectors - 1;
+    }
+    cursor->sector = (uint16_t)((ring->headSector + ring->sectorCount - sectorsBack) % ring->sectorCount);
+    cursor->remaining = sectorsBack;
+    cursor->offset = FLASH_RING_HEADER_SIZE;
+}
+
+uint16_t flash_ring_next(const flash_ring_t* ring, flash_ring_cursor_t* cursor, void* data, uint16_t size) {
+    for (;;) {
+        // Head sektorā tālāk par rakstīšanas vietu var būt tikai bojāta aste
+        const uint32_t end = cursor->remaining == 0 ? ring->writeOffset : FLASH_RING_SECTOR_SIZE;
+        if (cursor->offset + FLASH_RING_RECORD_HEADER <= end) {
+            uint16_t length = 0;
+            const uint32_t address = sectorAddress(ring, cursor->sector, cursor->offset);
+            if (ring->io.read(ring->io.ctx, address, &length, sizeof(length)) &&
+                length != ERASED_U16 && length != 0 &&
+                cursor->offset + FLASH_RING_RECORD_HEADER + length <= end) {
+                const uint16_t n = length < size ? length : size;
+                if (!ring->io.read(ring->io.ctx, address + FLASH_RING_RECORD_HEADER, data, n)) {
+                    return 0;
+                }
+                cursor->offset += FLASH_RING_RECORD_HEADER + length;
+                return length;
+            }
+        }
+        if (cursor->remaining == 0) {
+            cursor->offset = end;
+            return 0;
+        }
+        cursor->remaining--;
+        cursor->sector = (uint16_t)((cursor->sector + 1) % ring->sectorCount);
+        cursor->offset = FLASH_RING_HEADER_SIZE;
+    }
+}
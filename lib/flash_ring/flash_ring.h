@@ -0,0 +1,83 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Flash Ring - ierakstu žurnāls NOR flash apgabalā ar sektoru rotāciju
+ *
+ * Apgabals sastāv no 4 KB sektoriem. Katra sektora sākumā ir galvene
+ * (magic + kārtas numurs), aiz tās - ieraksti [garums u16][dati]. Ieraksti
+ * tiek tikai pievienoti; kad sektors ir pilns, tiek izdzēsts nākamais pēc
+ * kārtas un tas kļūst par jaunāko (vecākie ieraksti pazūd). Tā katrs
+ * sektors tiek dzēsts vienādi bieži - viena dzēšana uz pilnu apli.
+ *
+ * Pēc restarta flash_ring_mount() atrod jaunāko sektoru pēc kārtas numura
+ * un rakstīšanas vietu tajā. Garumu raksta pēc datiem, tāpēc strāvas
+ * pārrāvums ieraksta vidū atstāj neizlasāmu (0xFFFF) garumu - tad
+ * rakstīšana turpinās nākamajā sektorā, nevis virs bojātajiem baitiem.
+ *
+ * Bez Arduino atkarībām: lasīšanu/rakstīšanu/dzēšanu nodrošina izsaucējs
+ * (ESP32 - esp_partition_*, host - atmiņas buferis). Sinhronizācija - arī.
+ */
+
+#define FLASH_RING_SECTOR_SIZE   4096
+#define FLASH_RING_HEADER_SIZE   8      // magic u32 + kārtas numurs u32
+#define FLASH_RING_RECORD_HEADER 2      // garums u16
+#define FLASH_RING_RECORD_MAX    (FLASH_RING_SECTOR_SIZE - FLASH_RING_HEADER_SIZE - FLASH_RING_RECORD_HEADER)
+
+typedef struct {
+    bool (*read)(void* ctx, uint32_t offset, void* data, uint32_t size);
+    bool (*write)(void* ctx, uint32_t offset, const void* data, uint32_t size);
+    bool (*erase)(void* ctx, uint32_t offset, uint32_t size);   // Veseli sektori
+    void* ctx;
+} flash_ring_io_t;
+
+typedef struct {
+    flash_ring_io_t io;
+    uint32_t baseOffset;      // Apgabala sākums (sektora robeža)
+    uint16_t sectorCount;
+    uint32_t magic;           // Atšķiras katram lietotājam, lai apgabalus nesajauktu
+
+    bool mounted;
+    uint16_t headSector;      // Sektors, kurā raksta
+    uint32_t headSequence;
+    uint32_t writeOffset;     // Nākamā ieraksta vieta head sektorā
+    uint16_t usedSectors;     // Sektori ar derīgu galveni (1..sectorCount)
+
+    uint32_t records;         // Statistika kopš mount
+    uint32_t bytesWritten;
+    uint32_t erases;
+    uint32_t errors;
+} flash_ring_t;
+
+typedef struct {
+    uint16_t sector;
+    uint16_t remaining;       // Vēl nenolasītie sektori aiz šī
+    uint32_t offset;
+} flash_ring_cursor_t;
+
+void flash_ring_init(flash_ring_t* ring, const flash_ring_io_t* io, uint32_t baseOffset,
+                     uint16_t sectorCount, uint32_t magic);
+
+// Atrod jaunāko sektoru; tukšu (vai svešu) apgabalu noformatē. false = flash kļūda
+bool flash_ring_mount(flash_ring_t* ring);
+
+// Pievieno ierakstu (1..FLASH_RING_RECORD_MAX baiti). Ja sektorā nepietiek
+// vietas, pāriet uz nākamo, izdzēšot vecāko
+bool flash_ring_append(flash_ring_t* ring, const void* data, uint16_t size);
+
+// Izdzēš visu apgabalu un sāk no jauna
+bool flash_ring_erase_all(flash_ring_t* ring);
+
+// Brīvā vieta head sektorā ierakstu datiem (jau atskaitot garuma lauku)
+uint16_t flash_ring_head_free(const flash_ring_t* ring);
+
+/**
+ * Lasīšana no vecākā uz jaunāko. sectorsBack ierobežo sākumu: 0 = tikai
+ * head sektors, 1 = arī iepriekšējais utt. (vairāk par usedSectors - 1
+ * nozīmē visu žurnālu)
+ */
+void flash_ring_cursor_init(const flash_ring_t* ring, flash_ring_cursor_t* cursor, uint16_t sectorsBack);
+
+// Nākamais ieraksts buferī (garākus par size nogriež). Atgriež ieraksta
+// garumu, 0 = žurnāla beigas
+uint16_t flash_ring_next(const flash_ring_t* ring, flash_ring_cursor_t* cursor, void* data, uint16_t size);
@@ -0,0 +1,109 @@
+#include "gain_schedule.h"
+#include <math.h>
+#include <string.h>
+
+#define SAME_POINT_C 0.5f
+
+static bool scale_valid(float scale) {
+    return scale >= GAIN_SCHEDULE_MIN_SCALE && scale <= GAIN_SCHEDULE_MAX_SCALE;
+}
+
+void gain_schedule_clear(gain_schedule_t* schedule) {
+    memset(schedule, 0, sizeof(*schedule));
+}
+
+bool gain_schedule_set(gain_schedule_t* schedule, float tempC, float kpScale, float tauIScale) {
+    if (!scale_valid(kpScale) || !scale_valid(tauIScale)) {
+        return false;
+    }
+    gain_schedule_t candidate = *schedule;
+
+    uint8_t index = 0;
+    while (index < candidate.count && candidate.points[index].tempC < tempC - SAME_POINT_C) {
+        index++;
+    }
+    // Divi punkti var būt ±0.5 °C robežās - aizstājam tuvāko
+    if (index + 1 < candidate.count &&
+        fabsf(candidate.points[index + 1].tempC - tempC) < fabsf(candidate.points[index].tempC - tempC)) {
+        index++;
+    }
+
+    const bool replace = index < candidate.count &&
+                         fabsf(candidate.points[index].tempC - tempC) <= SAME_POINT_C;
+    if (!replace) {
+        if (candidate.count >= GAIN_SCHEDULE_MAX_POINTS) {
+            return false;
+        }
+        // Atbrīvojam vietu, saglabājot secību pēc temperatūras
+        memmove(&candidate.points[index + 1], &candidate.points[index],
+                (candidate.count - index) * sizeof(candidate.points[0]));
+        candidate.count++;
+        candidate.points[index].tempC = tempC;
+    }
+    // Aizstājot punkta temperatūra paliek, citādi tas varētu pārlēkt kaimiņam
+    candidate.points[index].kpScale = kpScale;
+    candidate.points[index].tauIScale = tauIScale;
+
+    if (!gain_schedule_valid(&candidate)) {
+        return false;
+    }
+    *schedule = candidate;
+    return true;
+}
+
+bool gain_schedule_remove(gain_schedule_t* schedule, float tempC) {
+    for (uint8_t i = 0; i < schedule->count; i++) {
+        if (fabsf(schedule->points[i].tempC - tempC) <= SAME_POINT_C) {
+            memmove(&schedule->points[i], &schedule->points[i + 1],
+                    (schedule->count - i - 1) * sizeof(schedule->points[0]));
+            schedule->count--;
+            return true;
+        }
+    }
+    return false;
+}
+
+gain_schedule_point_t gain_schedule_eval(const gain_schedule_t* schedule, float tempC) {
+    gain_schedule_point_t result = {tempC, 1.0f, 1.0f};
+    const uint8_t n = schedule->count;
+    if (n == 0) {
+        return result;
+    }
+
+    const gain_schedule_point_t* p = schedule->points;
+    if (tempC <= p[0].tempC) {
+        result.kpScale = p[0].kpScale;
+        result.tauIScale = p[0].tauIScale;
+        return result;
+    }
+    if (tempC >= p[n - 1].tempC) {
+        result.kpScale = p[n - 1].kpScale;
+        result.tauIScale = p[n - 1].tauIScale;
+        return result;
+    }
+
+    uint8_t i = 1;
+    while (p[i].tempC < tempC) {
+        i++;
+    }
+    const float frac = (tempC - p[i - 1].tempC) / (p[i].tempC - p[i - 1].tempC);
+    result.kpScale = p[i - 1].kpScale + frac * (p[i].kpScale - p[i - 1].kpScale);
+    result.tauIScale = p[i - 1].tauIScale + frac * (p[i].tauIScale - p[i - 1].tauIScale);
+    return result;
+}
+
+bool gain_schedule_valid(const gain_schedule_t* schedule) {
+    if (schedule->count > GAIN_SCHEDULE_MAX_POINTS) {
+        return false;
+    }
+    for (uint8_t i = 0; i < schedule->count; i++) {
+        const gain_schedule_point_t* p = &schedule->points[i];
+        if (!scale_valid(p->kpScale) || !scale_valid(p->tauIScale)) {
+            return false;
+        }
+        if (i > 0 && p->tempC <= schedule->points[i - 1].tempC) {
+            return false;
+        }
+    }
+    return true;
+}
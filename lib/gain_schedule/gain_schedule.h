@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Gain Schedule - PID pastiprinājumu grafiks pēc temperatūras
+ *
+ * Krāsns reakcija uz gaisu nav vienāda visā diapazonā: tikko virs
+ * temperatureMin krava vēl aizdegas un damper maiņa temperatūru gandrīz
+ * neietekmē, bet pie mērķa tā pati maiņa dod lielu un ātru atbildi.
+ * Tabulā ir līdz GAIN_SCHEDULE_MAX_POINTS punktiem (temperatūra, kP
+ * reizinātājs, tauI reizinātājs), sakārtotiem pēc temperatūras. Starp
+ * punktiem reizinātāji tiek interpolēti lineāri, ārpus tiem - ņemts tuvākais.
+ * Tukša tabula = reizinātāji 1 (pamata kP/tauI bez izmaiņām).
+ *
+ * Glabāti reizinātāji, nevis absolūti pastiprinājumi, lai pamata kP/tauI
+ * (iestatījumi, autotune) paliek viens skaitlis, ko grafiks tikai veido.
+ *
+ * Struktūra ir vienkāršs POD - to var glabāt NVS ar putBytes().
+ */
+
+#define GAIN_SCHEDULE_MAX_POINTS 6
+#define GAIN_SCHEDULE_MIN_SCALE  0.1f
+#define GAIN_SCHEDULE_MAX_SCALE  10.0f
+
+typedef struct {
+    float tempC;
+    float kpScale;
+    float tauIScale;
+} gain_schedule_point_t;
+
+typedef struct {
+    uint8_t count;
+    gain_schedule_point_t points[GAIN_SCHEDULE_MAX_POINTS];
+} gain_schedule_t;
+
+void gain_schedule_clear(gain_schedule_t* schedule);
+
+// Pievieno punktu vai aizstāj reizinātājus tuvākajam punktam ±0.5 °C robežās
+// (tā temperatūra nemainās). false, ja tabula pilna, reizinātāji ārpus
+// MIN..MAX_SCALE vai tabula nebūtu derīga - tad tā paliek neskarta
+bool gain_schedule_set(gain_schedule_t* schedule, float tempC, float kpScale, float tauIScale);
+
+// Izņem punktu šajā temperatūrā (±0.5 °C). false, ja tāda nav
+bool gain_schedule_remove(gain_schedule_t* schedule, float tempC);
+
+// Interpolētie reizinātāji šajā temperatūrā
+gain_schedule_point_t gain_schedule_eval(const gain_schedule_t* schedule, float tempC);
+
+// Pārbauda no NVS nolasītu tabulu (skaits, secība, robežas)
+bool gain_schedule_valid(const gain_schedule_t* schedule);
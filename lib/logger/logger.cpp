@@ -0,0 +1,367 @@
+#include "logger.h"
+#include <esp_partition.h>
+#include <freertos/semphr.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <time.h>
+#include "flash_ring.h"
+#include "output_ring.h"
+#include "telnet.h"
+
+#define LOG_FLASH_MAGIC 0x474F4C53u   // "SLOG" - atšķir žurnāla sektorus no citiem datiem
+
+TaskHandle_t loggerTaskHandle = NULL;
+
+static volatile int8_t sinkLevels[LOG_SINK_COUNT] = {LOG_LEVEL_INFO, LOG_LEVEL_DEBUG, LOG_LEVEL_INFO};
+static volatile bool wallClockValid = false;
+
+// RAM buferī raksta visi uzdevumi (ringLock); flash un carry - tikai
+// LogTask, loggerFlush() un telnet komandas (flashLock)
+static SemaphoreHandle_t ringLock = NULL;
+static SemaphoreHandle_t flashLock = NULL;
+static output_ring_t ramRing;
+static flash_ring_t flashRing;
+static bool flashReady = false;
+static char carry[LOG_FLASH_RECORD_MAX];   // Vēl neierakstītās rindas (veselas rindas vienā ierakstā)
+static uint16_t carryLength = 0;
+
+static const char LEVEL_LETTERS[] = "EWID";
+static const char* const LEVEL_NAMES[] = {"error", "warn", "info", "debug"};
+static const char* const SINK_NAMES[LOG_SINK_COUNT] = {"serial", "telnet", "flash"};
+
+static bool partitionRead(void* ctx, uint32_t offset, void* data, uint32_t size) {
+    return esp_partition_read((const esp_partition_t*)ctx, offset, data, size) == ESP_OK;
+}
+
+static bool partitionWrite(void* ctx, uint32_t offset, const void* data, uint32_t size) {
+    return esp_partition_write((const esp_partition_t*)ctx, offset, data, size) == ESP_OK;
+}
+
+static bool partitionErase(void* ctx, uint32_t offset, uint32_t size) {
+    return esp_partition_erase_range((const esp_partition_t*)ctx, offset, size) == ESP_OK;
+}
+
+static const char* resetReasonLabel(esp_reset_reason_t reason) {
+    switch (reason) {
+        case ESP_RST_POWERON:   return "ieslegts";
+        case ESP_RST_EXT:       return "areja poga";
+        case ESP_RST_SW:        return "restarts";
+        case ESP_RST_PANIC:     return "panika";
+        case ESP_RST_INT_WDT:
+        case ESP_RST_TASK_WDT:
+        case ESP_RST_WDT:       return "watchdog";
+        case ESP_RST_DEEPSLEEP: return "deep sleep";
+        case ESP_RST_BROWNOUT:  return "sprieguma kritums";
+        default:                return "nezinams";
+    }
+}
+
+static void LogTask(void* parameter) {
+    for (;;) {
+        // Pamostas periodiski vai uzreiz pēc WARN/ERROR rindas
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_FLASH_PERIOD_MS));
+        loggerTaskStep();
+    }
+}
+
+void loggerBegin() {
+    if (ringLock != NULL) {
+        return;
+    }
+    ringLock = xSemaphoreCreateMutex();
+    flashLock = xSemaphoreCreateMutex();
+
+    uint8_t* storage = NULL;
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound()) {
+        storage = (uint8_t*)ps_malloc(LOG_RAM_BUFFER_SIZE);
+    }
+#endif
+    if (storage == NULL) {
+        storage = (uint8_t*)malloc(LOG_RAM_BUFFER_SIZE);
+    }
+    output_ring_init(&ramRing, storage, LOG_RAM_BUFFER_SIZE);
+
+    // Žurnāls aizņem "spiffs" nodalījuma sākumu; tas nav montēts kā failu sistēma
+    const esp_partition_t* partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, "spiffs");
+    if (storage != NULL && partition != NULL &&
+        partition->size >= (uint32_t)LOG_FLASH_SECTORS * FLASH_RING_SECTOR_SIZE) {
+        const flash_ring_io_t io = {partitionRead, partitionWrite, partitionErase, (void*)partition};
+        flash_ring_init(&flashRing, &io, 0, LOG_FLASH_SECTORS, LOG_FLASH_MAGIC);
+        flashReady = flash_ring_mount(&flashRing);
+    }
+
+    xTaskCreatePinnedToCore(
+        LogTask,             // Uzdevuma funkcija
+        "LogTask",           // Uzdevuma nosaukums
+        3072,                // Steka izmērs (carry kopija flash ierakstam)
+        NULL,                // Parametri (nav)
+        1,                   // Prioritāte (zema - flash rakstīšana var pagaidīt)
+        &loggerTaskHandle,   // Uzdevuma rokturis
+        0                    // Kodola numurs (WiFi kodols, prom no ControlTask)
+    );
+
+    LOG_INFO("log", "Starts (%s)", resetReasonLabel(esp_reset_reason()));
+    if (!flashReady) {
+        LOG_WARN("log", "Flash zurnals nav pieejams (nav 'spiffs' nodalijuma vai atminas)");
+    }
+}
+
+void loggerTimeSynced() {
+    wallClockValid = true;
+    const unsigned long ms = millis();
+    LOG_INFO("log", "Laiks sinhronizets (+%lu.%03lu s kops starta)", ms / 1000, ms % 1000);
+}
+
+bool loggerTimeValid() {
+    return wallClockValid;
+}
+
+bool loggerEnabled(int8_t level) {
+    return level <= sinkLevels[LOG_SINK_SERIAL] ||
+           (level <= sinkLevels[LOG_SINK_TELNET] && Telnet.hasClient()) ||
+           (level <= sinkLevels[LOG_SINK_FLASH] && flashReady);
+}
+
+// Pēc NTP - datums un laiks, pirms tam - sekundes kopš starta
+static int formatStamp(char* out, size_t size) {
+    if (wallClockValid) {
+        time_t now = time(NULL);
+        struct tm local;
+        localtime_r(&now, &local);
+        return snprintf(out, size, "%02d.%02d %02d:%02d:%02d", local.tm_mday, local.tm_mon + 1,
+                        local.tm_hour, local.tm_min, local.tm_sec);
+    }
+    const unsigned long ms = millis();
+    return snprintf(out, size, "+%lu.%03lu", ms / 1000, ms % 1000);
+}
+
+void loggerWrite(int8_t level, const char* tag, const char* format, ...) {
+    if (level < LOG_LEVEL_ERROR || level > LOG_LEVEL_DEBUG) {
+        return;
+    }
+
+    // Rezervējam vietu "\r\n"; garāku rindu nogriežam
+    char line[LOG_LINE_MAX];
+    const int limit = (int)sizeof(line) - 3;
+    int length = formatStamp(line, sizeof(line));
+    if (length >= 0 && length < limit) {
+        length += snprintf(line + length, sizeof(line) - length, " %c %s: ", LEVEL_LETTERS[level], tag);
+    }
+    if (length >= 0 && length < limit) {
+        va_list args;
+        va_start(args, format);
+        const int n = vsnprintf(line + length, sizeof(line) - length, format, args);
+        va_end(args);
+        length += n > 0 ? n : 0;
+    }
+    if (length < 0) {
+        return;
+    }
+    if (length > limit) {
+        length = limit;
+    }
+    line[length++] = '\r';
+    line[length++] = '\n';
+    line[length] = '\0';
+
+    if (level <= sinkLevels[LOG_SINK_SERIAL]) {
+        Serial.write((const uint8_t*)line, length);
+    }
+    if (level <= sinkLevels[LOG_SINK_TELNET]) {
+        Telnet.write((const uint8_t*)line, length);
+    }
+    if (level <= sinkLevels[LOG_SINK_FLASH] && flashReady) {
+        xSemaphoreTake(ringLock, portMAX_DELAY);
+        output_ring_write(&ramRing, (const uint8_t*)line, length);
+        const bool wake = level <= LOG_LEVEL_WARN || ramRing.count > LOG_RAM_BUFFER_SIZE / 2;
+        xSemaphoreGive(ringLock);
+        if (wake && loggerTaskHandle != NULL) {
+            xTaskNotifyGive(loggerTaskHandle);
+        }
+    }
+}
+
+void loggerSetLevel(log_sink_t sink, int8_t level) {
+    if (sink < LOG_SINK_COUNT) {
+        sinkLevels[sink] = constrain(level, LOG_LEVEL_OFF, LOG_LEVEL_DEBUG);
+    }
+}
+
+int8_t loggerGetLevel(log_sink_t sink) {
+    return sink < LOG_SINK_COUNT ? sinkLevels[sink] : LOG_LEVEL_OFF;
+}
+
+const char* loggerLevelName(int8_t level) {
+    return level >= LOG_LEVEL_ERROR && level <= LOG_LEVEL_DEBUG ? LEVEL_NAMES[level] : "off";
+}
+
+bool loggerLevelFromName(const char* name, int8_t* level) {
+    if (strcmp(name, "off") == 0) {
+        *level = LOG_LEVEL_OFF;
+        return true;
+    }
+    for (int8_t i = LOG_LEVEL_ERROR; i <= LOG_LEVEL_DEBUG; i++) {
+        if (strcmp(name, LEVEL_NAMES[i]) == 0) {
+            *level = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* loggerSinkName(log_sink_t sink) {
+    return sink < LOG_SINK_COUNT ? SINK_NAMES[sink] : "?";
+}
+
+bool loggerSinkFromName(const char* name, log_sink_t* sink) {
+    for (uint8_t i = 0; i < LOG_SINK_COUNT; i++) {
+        if (strcmp(name, SINK_NAMES[i]) == 0) {
+            *sink = (log_sink_t)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void loggerTaskStep() {
+    if (!flashReady) {
+        return;
+    }
+    xSemaphoreTake(flashLock, portMAX_DELAY);
+    for (;;) {
+        xSemaphoreTake(ringLock, portMAX_DELAY);
+        while (carryLength < sizeof(carry)) {
+            const uint8_t* data;
+            uint32_t n = output_ring_peek(&ramRing, &data);
+            if (n == 0) {
+                break;
+            }
+            if (n > sizeof(carry) - carryLength) {
+                n = sizeof(carry) - carryLength;
+            }
+            memcpy(carry + carryLength, data, n);
+            output_ring_consume(&ramRing, n);
+            carryLength += n;
+        }
+        xSemaphoreGive(ringLock);
+
+        // Ierakstā tikai veselas rindas, lai lasīšana var sākt no jebkura ieraksta
+        uint16_t length = carryLength;
+        while (length > 0 && carry[length - 1] != '\n') {
+            length--;
+        }
+        if (length == 0) {
+            if (carryLength < sizeof(carry)) {
+                break;
+            }
+            length = carryLength;   // Rinda garāka par ierakstu (nevajadzētu notikt)
+        }
+        flash_ring_append(&flashRing, carry, length);
+        memmove(carry, carry + length, carryLength - length);
+        carryLength -= length;
+    }
+    xSemaphoreGive(flashLock);
+}
+
+void loggerFlush() {
+    loggerTaskStep();
+}
+
+void loggerPrintStatus(Print &out) {
+    out.printf("Zurnals: serial %s, telnet %s, flash %s (kompileti lidz %s)\r\n",
+               loggerLevelName(sinkLevels[LOG_SINK_SERIAL]), loggerLevelName(sinkLevels[LOG_SINK_TELNET]),
+               loggerLevelName(sinkLevels[LOG_SINK_FLASH]), loggerLevelName(LOG_LEVEL));
+    if (!flashReady) {
+        out.println("  Flash: nav pieejams");
+        return;
+    }
+    out.printf("  Flash: %u/%u sektori, kops starta %lu ieraksti, %lu B, %lu dzesanas, %lu kludas\r\n",
+               flashRing.usedSectors, flashRing.sectorCount, (unsigned long)flashRing.records,
+               (unsigned long)flashRing.bytesWritten, (unsigned long)flashRing.erases,
+               (unsigned long)flashRing.errors);
+    out.printf("  RAM buferis: %lu/%u B, izmesti %lu B\r\n", (unsigned long)ramRing.count,
+               LOG_RAM_BUFFER_SIZE, (unsigned long)ramRing.droppedBytes);
+}
+
+// Rindas vienā sektorā (sectorsBack no head)
+static uint32_t sectorLines(uint16_t sectorsBack, char* buffer) {
+    flash_ring_cursor_t cursor;
+    flash_ring_cursor_init(&flashRing, &cursor, sectorsBack);
+    uint32_t lines = 0;
+    for (;;) {
+        uint16_t length = flash_ring_next(&flashRing, &cursor, buffer, LOG_FLASH_RECORD_MAX);
+        if (length == 0 || cursor.remaining != sectorsBack) {
+            return lines;
+        }
+        if (length > LOG_FLASH_RECORD_MAX) {
+            length = LOG_FLASH_RECORD_MAX;
+        }
+        for (uint16_t i = 0; i < length; i++) {
+            lines += buffer[i] == '\n';
+        }
+    }
+}
+
+void loggerPrintFlash(Print &out, uint16_t lines) {
+    if (!flashReady) {
+        out.println("Flash zurnals nav pieejams.");
+        return;
+    }
+    loggerFlush();   // Arī vēl neierakstītās rindas
+
+    char buffer[LOG_FLASH_RECORD_MAX];
+    xSemaphoreTake(flashLock, portMAX_DELAY);
+
+    // Ejam atpakaļ pa sektoriem, līdz ir pietiekami rindu
+    uint16_t sectorsBack = 0;
+    uint32_t available = 0;
+    while (sectorsBack < flashRing.usedSectors) {
+        available += sectorLines(sectorsBack, buffer);
+        if (available >= lines) {
+            break;
+        }
+        sectorsBack++;
+    }
+    uint32_t skip = available > lines ? available - lines : 0;
+
+    flash_ring_cursor_t cursor;
+    flash_ring_cursor_init(&flashRing, &cursor, sectorsBack);
+    for (;;) {
+        uint16_t length = flash_ring_next(&flashRing, &cursor, buffer, sizeof(buffer));
+        if (length == 0) {
+            break;
+        }
+        if (length > sizeof(buffer)) {
+            length = sizeof(buffer);
+        }
+        uint16_t start = 0;
+        for (uint16_t i = 0; i < length; i++) {
+            if (buffer[i] != '\n') {
+                continue;
+            }
+            if (skip > 0) {
+                skip--;
+            } else {
+                out.write((const uint8_t*)buffer + start, i + 1 - start);
+            }
+            start = i + 1;
+        }
+    }
+    xSemaphoreGive(flashLock);
+}
+
+bool loggerEraseFlash() {
+    if (!flashReady) {
+        return false;
+    }
+    xSemaphoreTake(flashLock, portMAX_DELAY);
+    xSemaphoreTake(ringLock, portMAX_DELAY);
+    output_ring_clear(&ramRing);
+    xSemaphoreGive(ringLock);
+    carryLength = 0;
+    const bool ok = flash_ring_erase_all(&flashRing);
+    xSemaphoreGive(flashLock);
+    return ok;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * Logger - viens žurnāls ar līmeņiem, tagiem un laika zīmogiem
+ *
+ * Katra rinda tiek noformatēta vienreiz steka buferī un nodota izejām:
+ *   Serial - uzreiz (kā agrāk Serial.println)
+ *   Telnet - klientu gredzenbuferos (sk. telnet.h), ja kāds ir pieslēgts
+ *   Flash  - RAM buferī; LogTask (zema prioritāte) to ieraksta "spiffs"
+ *            nodalījuma sākumā rotējošā žurnālā (flash_ring), kas saglabājas
+ *            pēc restarta un deep sleep
+ * Katrai izejai ir savs līmenis (telnet komanda "log", glabājas NVS).
+ * Līmeņi virs LOG_LEVEL netiek kompilēti (arī argumenti netiek rēķināti).
+ *
+ * Rindas formāts: "17.10 03:12:44 W control: teksts" (pēc NTP) vai
+ * "+3723.456 W control: teksts" (sekundes kopš starta, pirms NTP).
+ */
+
+#define LOG_LEVEL_OFF   -1
+#define LOG_LEVEL_ERROR 0
+#define LOG_LEVEL_WARN  1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_DEBUG 3
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+#define LOG_LINE_MAX         384     // Viena rinda ar zīmogu (statusa rinda ~330 B)
+#define LOG_RAM_BUFFER_SIZE  8192    // Flash rindas, kas vēl nav ierakstītas
+#define LOG_FLASH_SECTORS    64      // 256 KB "spiffs" nodalījuma sākumā
+#define LOG_FLASH_PERIOD_MS  10000   // LogTask ieraksta vismaz tik bieži
+#define LOG_FLASH_RECORD_MAX 512     // Viens flash ieraksts (veselas rindas)
+
+typedef enum {
+    LOG_SINK_SERIAL = 0,
+    LOG_SINK_TELNET,
+    LOG_SINK_FLASH,
+    LOG_SINK_COUNT
+} log_sink_t;
+
+#define LOG_AT(level, tag, ...) \
+    do { \
+        if ((level) <= LOG_LEVEL && loggerEnabled(level)) { \
+            loggerWrite(level, tag, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_ERROR(tag, ...) LOG_AT(LOG_LEVEL_ERROR, tag, __VA_ARGS__)
+#define LOG_WARN(tag, ...)  LOG_AT(LOG_LEVEL_WARN, tag, __VA_ARGS__)
+#define LOG_INFO(tag, ...)  LOG_AT(LOG_LEVEL_INFO, tag, __VA_ARGS__)
+#define LOG_DEBUG(tag, ...) LOG_AT(LOG_LEVEL_DEBUG, tag, __VA_ARGS__)
+
+extern TaskHandle_t loggerTaskHandle;
+
+// Montē flash žurnālu un palaiž LogTask. Izsaukt setup() sākumā (pēc Serial.begin)
+void loggerBegin();
+
+// wifi1.cpp pēc NTP: turpmāk zīmogā datums un laiks
+void loggerTimeSynced();
+bool loggerTimeValid();
+
+// Vai kāda izeja pieņem šo līmeni (citādi rindu pat neformatē)
+bool loggerEnabled(int8_t level);
+void loggerWrite(int8_t level, const char* tag, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+void loggerSetLevel(log_sink_t sink, int8_t level);
+int8_t loggerGetLevel(log_sink_t sink);
+const char* loggerLevelName(int8_t level);
+bool loggerLevelFromName(const char* name, int8_t* level);
+const char* loggerSinkName(log_sink_t sink);
+bool loggerSinkFromName(const char* name, log_sink_t* sink);
+
+// Ieraksta flash visu, kas ir RAM buferī (pirms deep sleep / restarta)
+void loggerFlush();
+
+// Viena LogTask iterācija (host harness izsauc tieši)
+void loggerTaskStep();
+
+// Telnet komanda "log"
+void loggerPrintStatus(Print &out);
+void loggerPrintFlash(Print &out, uint16_t lines);
+bool loggerEraseFlash();
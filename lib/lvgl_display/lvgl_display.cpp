@@ -2,6 +2,7 @@
 //#include <TFT_eSPI.h>  // Include TFT_eSPI here instead of in header
 #include "temperature.h"
 #include "damper_control.h"
+#include "controller_state.h"
 #include "wifi1.h"
 #include "lvgl.h"
 #include "display_config.h"  // For buffer size configuration
@@ -109,7 +110,6 @@ static int saved_damper = 0; // Lai saglabātu vērtību pirms manuālā režīm
 
 extern int targetTempC;
 extern int damper;
-extern String messageDamp;
 
 void lvgl_display_show_touch_point(uint16_t x, uint16_t y, bool show);
 LV_FONT_DECLARE(ekstra);
@@ -184,7 +184,7 @@ static void toggle_damper_mode(void)
         saved_damper = damper;  // Saglabājam pašreizējo vērtību
         
         // Uzstādam tekstu uz "MANUAL" - prioritārā darbība
-        lv_label_set_text(damper_status_label, "MANUAL");
+        lv_label_set_text_static(damper_status_label, damper_mode_label(DAMPER_MODE_MANUAL));
         
         // Teksta maiņa nekavējas, tāpēc mainām tieši
         lv_label_set_text(target, "Set Damper");
@@ -219,7 +219,7 @@ static void toggle_damper_mode(void)
         // SVARĪGI: Tagad atjaunojam status ar nelielu aizturi
         // Šeit bija kļūda - mēs izmantojām messageDamp, kura varēja būt novecojusi
         // Tā vietā, iekodējam fiksētu vērtību "AUTO", jo tikko esam pārslēguši uz AUTO režīmu
-        lv_label_set_text(damper_status_label, "AUTO");
+        lv_label_set_text_static(damper_status_label, damper_mode_label(DAMPER_MODE_AUTO));
         
         // Forsa redraw
         lv_obj_invalidate(damper_status_label);
@@ -387,11 +387,7 @@ static void warning_popup_close_event_handler(lv_event_t * e) {
 
 // JAUNS: Funkcija brīdinājuma popup parādīšanai (bez OK pogas, automātiski aizveras)
 void lvgl_display_show_warning(const char* title, const char* message) {
-    // Atskaņojam brīdinājuma signālu, ja nav ieslēgts klusuma režīms
-    if (!buzzer_muted) {
-        playWarningSound();
-    }
-    
+    // Skaņas rakstu izvēlas izsaucējs (buzzerSetPattern), popup tikai rāda tekstu
     // Ja jau ir atvērts popup, nav nepieciešams to dzēst
     if (warning_popup) {
         // Jau ir aktīvs brīdinājums - atjaunojam tikai tekstu, ja nepieciešams
@@ -400,11 +396,6 @@ void lvgl_display_show_warning(const char* title, const char* message) {
             lv_label_set_text(message_label, message);
         }
         
-        // Ja nav ieslēgts klusums, atskaņojam brīdinājuma signālu, jo tas var būt cits brīdinājums
-        if (!buzzer_muted) {
-            playWarningSound();
-        }
-        
         return; // Izejam, jo brīdinājums jau tiek rādīts
     }
     
@@ -466,12 +457,8 @@ void lvgl_display_show_warning(const char* title, const char* message) {
                 lv_label_set_text(label, buzzer_muted ? LV_SYMBOL_MUTE : LV_SYMBOL_VOLUME_MAX);
             }
             
-            // Izslēdzam vai ieslēdzam skaņu
-            if (buzzer_muted) {
-                stopBuzzerSound();
-            } else {
-                playWarningSound();
-            }
+            // Apklusina šobrīd skanošos rakstus; jauns brīdinājums atkal skanēs
+            buzzerMute(buzzer_muted);
         }
     }, LV_EVENT_CLICKED, NULL);
     
@@ -500,33 +487,40 @@ void lvgl_display_update_bars() {
    static bool warning_shown = false;
    static bool high_temp_warning = false; // Vai brīdinājums ir par augstu temperatūru
    static bool low_temp_warning = false;  // Vai brīdinājums ir par zemu temperatūru
+
+   // Sensora kļūdu nosaka ControlTask pēc dūmgāzu kanāla derīguma (tas arī
+   // ieslēdz buzzer); nederīgs kanāls rāda drošo vērtību, nevis ~0 °C
+   controller_state_t state;
+   const bool sensor_fault = controller_state_read(&state) &&
+                             (state.channelValidMask & (1 << TEMP_CHANNEL_FLUE)) == 0;
    
    if (temperature > warningTemperature && !warning_shown) {
        // Ja temperatūra ir par augstu un brīdinājums vēl nav parādīts
        static char warning_message[40];
        snprintf(warning_message, sizeof(warning_message), "Temp. parsniedz %d!", warningTemperature);
+       buzzerSetPattern(BUZZER_PATTERN_OVER_TEMP, true);
        lvgl_display_show_warning("Bridinajums!", warning_message);
        warning_shown = true;
        high_temp_warning = true;
        low_temp_warning = false;
-   } else if (temperature <= 3 && !warning_shown) {
+   } else if (sensor_fault && !warning_shown) {
        // Sensora kļūda un brīdinājums vēl nav parādīts
        lvgl_display_show_warning("Bridinajums!", "Sensor error!");
        warning_shown = true;
        high_temp_warning = false;
        low_temp_warning = true;
    } else if ((high_temp_warning && temperature <= warningTemperature) || 
-              (low_temp_warning && temperature > 3)) {
+              (low_temp_warning && !sensor_fault)) {
        // Temperatūra ir normalizējusies - notīram brīdinājumu
        // - Ja bija augstās temperatūras brīdinājums un temperatura nokrita zem sliekšņa
-       // - VAI ja bija zemas temperatūras brīdinājums un temperatura paaugstinājās virs 3°C
+       // - VAI ja bija sensora kļūda un dūmgāzu kanāls atkal derīgs
        warning_shown = false;
        high_temp_warning = false;
        low_temp_warning = false;
+       buzzerSetPattern(BUZZER_PATTERN_OVER_TEMP, false);
        
        // Ja ir aktīvs brīdinājums, aizveram to
        if (warning_popup) {
-           stopBuzzerSound(); // Apstādinām skaņu
            lv_obj_del(warning_popup);
            warning_popup = NULL;
            warning_popup_visible = false;
@@ -795,8 +789,10 @@ void lvgl_display_show_touch_point(uint16_t x, uint16_t y, bool show) {
 
 void lvgl_display_update_damper() {
    if(damper_label) {
+       controller_state_t state;
+       controller_state_read(&state);
        static char buf[16];
-       snprintf(buf, sizeof(buf), "%d %%", damper);
+       snprintf(buf, sizeof(buf), "%d %%", state.damper);
        lv_label_set_text(damper_label, buf);
    }
 }
@@ -812,7 +808,9 @@ void lvgl_display_update_damper_status() {
        
        // Ja esam manuālajā režīmā, nerediģējam tekstu
        if (!manual_mode) {
-           lv_label_set_text(damper_status_label, messageDamp.c_str());
+           controller_state_t state;
+           controller_state_read(&state);
+           lv_label_set_text_static(damper_status_label, damper_mode_label(state.mode));
        }
        // Manuālajā režīmā nedarām neko - teksts paliek "MANUAL"
    }
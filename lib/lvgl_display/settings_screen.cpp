@@ -5,6 +5,7 @@
 #include "damper_control.h"
 #include "display_config.h"
 #include "display_manager.h"
+#include "logger.h"
 
 
 // External variables
@@ -529,7 +530,7 @@ void settings_screen_show(void)
             
             // Ja vērtība tika koriģēta, atjauninām arī globālo mainīgo
             if (corrected_value != targetTempC) {
-                Serial.printf("Correcting targetTempC from %d to %d\n", targetTempC, corrected_value);
+                LOG_WARN("settings", "Correcting targetTempC from %d to %d", targetTempC, corrected_value);
                 targetTempC = corrected_value;
                 // Ja mainījās vērtība, atjauninām arī galveno ekrānu
                 lvgl_display_update_target_temp();
@@ -0,0 +1,197 @@
+#pragma once
+
+/**
+ * Arduino-ESP32 API aizstājējs host (native) būvējumam
+ *
+ * Satur tikai to, ko izmanto damper_control, temperature, display_manager,
+ * settings_storage, touch_button un telnet bibliotēkas. Laiks nāk no
+ * virtuālā pulksteņa (native_clock.h), nevis no reālā laika.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <string>
+
+#include "native_clock.h"
+
+using std::min;
+using std::max;
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT  0x01
+#define OUTPUT 0x03
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// Laiks (virtuālais pulkstenis)
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+// GPIO
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint32_t touchRead(uint8_t pin);
+void touchSleepWakeUpEnable(uint8_t pin, uint32_t threshold);
+
+// Deep sleep uz host nozīmē "firmware šeit apstātos" - harness to noķer
+struct NativeDeepSleep {
+    unsigned long at_ms;
+};
+[[noreturn]] void esp_deep_sleep_start();
+
+// Restarta iemesls (esp_system.h); host vienmēr "ieslēgts no jauna"
+typedef enum {
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT,
+    ESP_RST_SDIO,
+} esp_reset_reason_t;
+inline esp_reset_reason_t esp_reset_reason() { return ESP_RST_POWERON; }
+
+// Uz host nav NTP - žurnāls izmanto laiku kopš starta
+inline bool getLocalTime(struct tm* info, uint32_t ms = 5000) {
+    (void)info;
+    (void)ms;
+    return false;
+}
+
+// PSRAM uz host vienkārši ir parasts heap
+inline bool psramFound() { return true; }
+inline void* ps_malloc(size_t size) { return malloc(size); }
+
+// Nestandarta libc funkcijas, kuras izmanto telnet.cpp
+char* itoa(int value, char* str, int base);
+char* utoa(unsigned int value, char* str, int base);
+char* ltoa(long value, char* str, int base);
+char* ultoa(unsigned long value, char* str, int base);
+
+class String {
+public:
+    String(const char* s = "") : str(s ? s : "") {}
+    String(const std::string& s) : str(s) {}
+    explicit String(char c) : str(1, c) {}
+    explicit String(int value, unsigned char base = DEC);
+    explicit String(unsigned int value, unsigned char base = DEC);
+    explicit String(long value, unsigned char base = DEC);
+    explicit String(unsigned long value, unsigned char base = DEC);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+
+    const char* c_str() const { return str.c_str(); }
+    unsigned int length() const { return (unsigned int)str.length(); }
+    char operator[](unsigned int index) const { return index < str.length() ? str[index] : 0; }
+
+    void trim();
+    long toInt() const { return strtol(str.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(str.c_str(), nullptr); }
+    bool startsWith(const String& prefix) const { return str.compare(0, prefix.str.length(), prefix.str) == 0; }
+    String substring(unsigned int from) const { return from < str.length() ? String(str.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const;
+    int indexOf(char c) const;
+    int indexOf(char c, unsigned int fromIndex) const;
+
+    String& operator+=(const String& rhs) { str += rhs.str; return *this; }
+    String& operator+=(const char* rhs) { str += rhs; return *this; }
+    String& operator+=(char c) { str += c; return *this; }
+
+    bool operator==(const String& rhs) const { return str == rhs.str; }
+    bool operator==(const char* rhs) const { return str == rhs; }
+    bool operator!=(const String& rhs) const { return str != rhs.str; }
+    bool operator!=(const char* rhs) const { return str != rhs; }
+
+    friend String operator+(const String& lhs, const String& rhs) { return String(lhs.str + rhs.str); }
+    friend String operator+(const String& lhs, const char* rhs) { return String(lhs.str + rhs); }
+    friend String operator+(const char* lhs, const String& rhs) { return String(lhs + rhs.str); }
+
+private:
+    std::string str;
+};
+
+class IPAddress {
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : octets{a, b, c, d} {}
+    String toString() const;
+private:
+    uint8_t octets[4];
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+
+    size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned int n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(long n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned long n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(double n, int digits = 2) { return print(String(n, (unsigned int)digits)); }
+    size_t print(const IPAddress& ip) { return print(ip.toString()); }
+
+    template <typename T>
+    size_t println(const T& value) { return print(value) + println(); }
+    size_t println(double n, int digits) { return print(n, digits) + println(); }
+    size_t println() { return write("\r\n"); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    String readStringUntil(char terminator);
+};
+
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+    uint32_t getFreeHeap() { return 256 * 1024; }
+    [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
+
+// Host konsoles izvada karogs: false = Serial/Telnet izvads tiek klusināts
+// (ātriem benchmark palaidieniem), true = izvads uz stdout
+extern bool native_console_enabled;
@@ -0,0 +1,4 @@
+#pragma once
+
+// Telegram bibliotēka uz host netiek izmantota - wifi1.h vajag tikai tipa nosaukumu
+class AsyncTelegram2;
@@ -0,0 +1,43 @@
+#pragma once
+#include <Arduino.h>
+#include "OneWire.h"
+
+typedef uint8_t DeviceAddress[8];
+typedef uint8_t ScratchPad[9];
+
+#define DEVICE_DISCONNECTED_C -127
+
+// DS18B20 aizstājējs. Sensorus uz kopnes un to temperatūras uzstāda harness
+// (native_hw.h); sensors temperatūru "izmēra" konversijas sākumā, noapaļotu
+// līdz savai izšķirtspējai (9 biti = 0.5 °C, 12 biti = 0.0625 °C).
+// Konversija ilgst tik, cik datu lapā (93.75 ms pie 9 bitiem līdz 750 ms pie 12),
+// un kopnes apmaiņu ilgums tiek uzskaitīts native_onewire_bus_us().
+class DallasTemperature {
+public:
+    explicit DallasTemperature(OneWire* bus) : bus(bus) {}
+
+    // Kopnes skenēšana (kā bibliotēkā - begin() meklē sensorus)
+    void begin();
+    uint8_t getDeviceCount() const { return deviceCount; }
+    bool getAddress(uint8_t* address, uint8_t index);
+
+    bool setResolution(const uint8_t* address, uint8_t bits);
+    uint8_t getResolution(const uint8_t* address);
+    int16_t millisToWaitForConversion(uint8_t bits);
+
+    // false - requestTemperatures*() atgriežas uzreiz, beigas jāpārbauda
+    // ar isConversionComplete()
+    void setWaitForConversion(bool flag) { waitForConversion = flag; }
+    bool getWaitForConversion() const { return waitForConversion; }
+    bool isConversionComplete();
+
+    void requestTemperatures();   // Visi sensori (SKIP ROM)
+    bool requestTemperaturesByAddress(const uint8_t* address);
+    bool readScratchPad(const uint8_t* address, uint8_t* scratchPad);
+    float getTempC(const uint8_t* address);
+
+private:
+    OneWire* bus;
+    uint8_t deviceCount = 0;
+    bool waitForConversion = true;
+};
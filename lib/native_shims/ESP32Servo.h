@@ -0,0 +1,26 @@
+#pragma once
+#include <Arduino.h>
+
+// Servo aizstājējs: pozīcija netiek kustināta, bet saglabāta, lai harness
+// (vai krāsns simulators) varētu to nolasīt ar native_servo_microseconds()
+class Servo {
+public:
+    int attach(int pin);
+    int attach(int pin, int minUs, int maxUs);
+    void detach();
+    bool attached() const { return pin >= 0; }
+    void write(int angle);
+    void writeMicroseconds(int us);
+    int readMicroseconds() const { return us; }
+    // LEDC taimera platums un impulss taimera soļos (ESP32Servo API)
+    void setTimerWidth(int bits) { timerWidth = bits; }
+    int readTimerWidth() const { return timerWidth; }
+    void writeTicks(int ticks);
+    int readTicks() const { return ticks; }
+
+private:
+    int pin = -1;
+    int us = 0;
+    int timerWidth = 10;
+    int ticks = 0;
+};
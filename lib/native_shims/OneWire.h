@@ -0,0 +1,15 @@
+#pragma once
+#include <Arduino.h>
+
+// OneWire kopnes aizstājējs - reālā apmaiņa notiek DallasTemperature aizstājējā
+class OneWire {
+public:
+    explicit OneWire(uint8_t pin) : pin(pin) {}
+    uint8_t getPin() const { return pin; }
+
+    // Dallas/Maxim CRC-8 (x^8 + x^5 + x^4 + 1), kā OneWire bibliotēkā
+    static uint8_t crc8(const uint8_t* addr, uint8_t len);
+
+private:
+    uint8_t pin;
+};
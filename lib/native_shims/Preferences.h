@@ -0,0 +1,34 @@
+#pragma once
+#include <Arduino.h>
+
+// NVS aizstājējs: vērtības glabājas atmiņā, kopīgas visiem Preferences
+// objektiem ar vienādu namespace, un pazūd līdz ar procesu
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false);
+    void end();
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putInt(const char* key, int32_t value);
+    size_t putUInt(const char* key, uint32_t value);
+    size_t putULong(const char* key, uint32_t value);
+    size_t putChar(const char* key, int8_t value);
+    size_t putUChar(const char* key, uint8_t value);
+    size_t putFloat(const char* key, float value);
+    size_t putBytes(const char* key, const void* value, size_t len);
+
+    int32_t getInt(const char* key, int32_t defaultValue = 0);
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0);
+    int8_t getChar(const char* key, int8_t defaultValue = 0);
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0);
+    float getFloat(const char* key, float defaultValue = NAN);
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buf, size_t maxLen);
+
+private:
+    std::string ns;
+    bool started = false;
+};
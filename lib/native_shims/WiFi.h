@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+
+// Telnet klienta aizstājējs. Tas, ko firmware raksta klientam, nonāk
+// stdout (ja native_console_enabled), un tiek skaitīti baiti un write() izsaukumi,
+// lai uz host varētu izmērīt, cik TCP segmentu rada viena statusa rinda.
+class WiFiClient : public Stream {
+public:
+    WiFiClient() {}
+    explicit WiFiClient(bool connected) : isOpen(connected) {}
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    void flush() {}
+    void stop() { isOpen = false; }
+    uint8_t connected() { return isOpen; }
+    explicit operator bool() const { return isOpen; }
+    void setNoDelay(bool nodelay) { (void)nodelay; }
+
+private:
+    bool isOpen = false;
+};
+
+class WiFiServer {
+public:
+    WiFiServer(uint16_t port = 23) : port(port) {}
+    void begin() {}
+    void setNoDelay(bool nodelay) { (void)nodelay; }
+    bool hasClient();
+    WiFiClient available();
+
+private:
+    uint16_t port;
+};
+
+class WiFiClass {
+public:
+    IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+    String macAddress() { return String("00:00:00:00:00:00"); }
+    int8_t RSSI() { return 0; }
+};
+
+extern WiFiClass WiFi;
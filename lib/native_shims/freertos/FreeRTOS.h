@@ -0,0 +1,25 @@
+#pragma once
+
+/**
+ * FreeRTOS aizstājējs host (native) būvējumam
+ *
+ * Tick ir 1 ms (tāpat kā Arduino-ESP32 konfigurācijā), un tick skaitītājs
+ * nāk no virtuālā pulksteņa. Uzdevumi uz host netiek palaisti - harness
+ * pats izsauc to darba funkcijas deterministiskā secībā.
+ */
+
+#include <stdint.h>
+#include "native_clock.h"
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(xTimeInMs))
@@ -0,0 +1,12 @@
+#pragma once
+#include "FreeRTOS.h"
+
+// Rinda host būvējumam: viens pavediens, tāpēc bloķēšana nekad nenotiek -
+// xTicksToWait tiek ignorēts, un tukša/pilna rinda uzreiz atgriež pdFALSE
+typedef struct native_queue* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueOverwrite(QueueHandle_t xQueue, const void* pvItemToQueue);
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
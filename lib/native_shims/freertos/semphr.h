@@ -0,0 +1,10 @@
+#pragma once
+#include "FreeRTOS.h"
+
+// Mutex host būvējumam: harness darbina uzdevumus pa vienam, tāpēc
+// sacensību nav - Take vienmēr izdodas, Give neko nedara
+typedef struct native_mutex* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
@@ -0,0 +1,24 @@
+#pragma once
+#include "FreeRTOS.h"
+
+// Programmatūras taimeri host būvējumam: taimeru uzdevuma vietā harness
+// izsauc native_timers_service(), kad pienāk native_timers_next_ms() laiks.
+// Izsaukumi nekad nebloķē - xTicksToWait tiek ignorēts
+typedef struct native_timer* TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t xTimer);
+
+TimerHandle_t xTimerCreate(const char* pcTimerName,
+                           TickType_t xTimerPeriodInTicks,
+                           UBaseType_t uxAutoReload,
+                           void* pvTimerID,
+                           TimerCallbackFunction_t pxCallbackFunction);
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait);
+BaseType_t xTimerIsTimerActive(TimerHandle_t xTimer);
+void* pvTimerGetTimerID(TimerHandle_t xTimer);
+
+// Agrākais aktīvā taimera termiņš; false, ja neviens nav aktīvs
+bool native_timers_next_ms(unsigned long* at_ms);
+// Izpilda visu termiņu sasniegušo taimeru callback
+void native_timers_service();
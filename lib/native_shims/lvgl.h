@@ -0,0 +1,16 @@
+#pragma once
+
+// LVGL aizstājējs host būvējumam. Displeja kods (lvgl_display) uz host netiek
+// kompilēts; šis fails vajadzīgs tikai tāpēc, ka lvgl_display.h un
+// settings_screen.h to iekļauj savu deklarāciju dēļ.
+#include <stdint.h>
+
+typedef struct _lv_obj_t lv_obj_t;
+typedef struct {
+    uint32_t full;
+} lv_color_t;
+
+static inline lv_color_t lv_color_hex(uint32_t c) {
+    lv_color_t color = {c};
+    return color;
+}
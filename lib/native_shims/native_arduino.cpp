@@ -0,0 +1,226 @@
+#include "Arduino.h"
+#include <ctype.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+bool native_console_enabled = true;
+
+// GPIO stāvoklis (buzzer, relejs u.c.) - harness var to nolasīt ar digitalRead()
+static uint8_t gpio_levels[64] = {0};
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    // Tāda pati veselo skaitļu aritmētika kā Arduino-ESP32 map()
+    const long run = in_max - in_min;
+    if (run == 0) {
+        return out_min;
+    }
+    const long rise = out_max - out_min;
+    const long delta = x - in_min;
+    return (delta * rise) / run + out_min;
+}
+
+unsigned long millis() {
+    return native_clock_now_ms();
+}
+
+unsigned long micros() {
+    return (unsigned long)(uint32_t)native_clock_now_us();
+}
+
+void delay(uint32_t ms) {
+    native_clock_advance_ms(ms);
+}
+
+void delayMicroseconds(uint32_t us) {
+    native_clock_advance_us(us);
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    if (pin < sizeof(gpio_levels)) {
+        gpio_levels[pin] = val ? HIGH : LOW;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < sizeof(gpio_levels) ? gpio_levels[pin] : LOW;
+}
+
+uint32_t touchRead(uint8_t pin) {
+    // Neviens nav pieskāries pogai
+    (void)pin;
+    return 0;
+}
+
+void touchSleepWakeUpEnable(uint8_t pin, uint32_t threshold) {
+    (void)pin;
+    (void)threshold;
+}
+
+void esp_deep_sleep_start() {
+    throw NativeDeepSleep{millis()};
+}
+
+void EspClass::restart() {
+    fprintf(stderr, "ESP.restart() izsaukts host buvejuma\n");
+    exit(1);
+}
+
+static char* format_unsigned(unsigned long value, char* str, int base, bool negative) {
+    char tmp[8 * sizeof(unsigned long) + 2];
+    int pos = 0;
+    if (base < 2 || base > 36) {
+        base = 10;
+    }
+    do {
+        const int digit = (int)(value % (unsigned long)base);
+        tmp[pos++] = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= (unsigned long)base;
+    } while (value > 0);
+
+    int out = 0;
+    if (negative) {
+        str[out++] = '-';
+    }
+    while (pos > 0) {
+        str[out++] = tmp[--pos];
+    }
+    str[out] = '\0';
+    return str;
+}
+
+char* itoa(int value, char* str, int base) {
+    return ltoa(value, str, base);
+}
+
+char* utoa(unsigned int value, char* str, int base) {
+    return format_unsigned(value, str, base, false);
+}
+
+char* ltoa(long value, char* str, int base) {
+    if (value < 0 && base == 10) {
+        return format_unsigned((unsigned long)(-(value + 1)) + 1, str, base, true);
+    }
+    return format_unsigned((unsigned long)value, str, base, false);
+}
+
+char* ultoa(unsigned long value, char* str, int base) {
+    return format_unsigned(value, str, base, false);
+}
+
+// String
+
+String::String(int value, unsigned char base) {
+    char buf[8 * sizeof(int) + 2];
+    str = itoa(value, buf, base);
+}
+
+String::String(unsigned int value, unsigned char base) {
+    char buf[8 * sizeof(unsigned int) + 2];
+    str = utoa(value, buf, base);
+}
+
+String::String(long value, unsigned char base) {
+    char buf[8 * sizeof(long) + 2];
+    str = ltoa(value, buf, base);
+}
+
+String::String(unsigned long value, unsigned char base) {
+    char buf[8 * sizeof(unsigned long) + 2];
+    str = ultoa(value, buf, base);
+}
+
+String::String(float value, unsigned int decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, unsigned int decimalPlaces) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    str = buf;
+}
+
+void String::trim() {
+    size_t begin = 0;
+    while (begin < str.length() && isspace((unsigned char)str[begin])) {
+        begin++;
+    }
+    size_t end = str.length();
+    while (end > begin && isspace((unsigned char)str[end - 1])) {
+        end--;
+    }
+    str = str.substr(begin, end - begin);
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) {
+        std::swap(from, to);
+    }
+    if (from >= str.length()) {
+        return String();
+    }
+    return String(str.substr(from, to - from));
+}
+
+int String::indexOf(char c) const {
+    const size_t pos = str.find(c);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(char c, unsigned int fromIndex) const {
+    const size_t pos = str.find(c, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String IPAddress::toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+    return String(buf);
+}
+
+// Print / Stream
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char buf[512];
+    va_list args;
+    va_start(args, format);
+    const int len = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (len <= 0) {
+        return 0;
+    }
+    return write((const uint8_t*)buf, std::min((size_t)len, sizeof(buf) - 1));
+}
+
+String Stream::readStringUntil(char terminator) {
+    std::string out;
+    int c;
+    while ((c = read()) >= 0 && c != terminator) {
+        out += (char)c;
+    }
+    return String(out);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (native_console_enabled) {
+        fputc(c, stdout);
+    }
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (native_console_enabled) {
+        fwrite(buffer, 1, size, stdout);
+    }
+    return size;
+}
@@ -0,0 +1,24 @@
+#include "native_clock.h"
+
+static uint64_t clock_us = 0;
+
+uint64_t native_clock_now_us() {
+    return clock_us;
+}
+
+unsigned long native_clock_now_ms() {
+    // Tāpat kā uz ESP32, millis() ir 32 bitu un pārplūst pēc ~49 dienām
+    return (unsigned long)(uint32_t)(clock_us / 1000);
+}
+
+void native_clock_advance_ms(unsigned long ms) {
+    clock_us += (uint64_t)ms * 1000;
+}
+
+void native_clock_advance_us(uint64_t us) {
+    clock_us += us;
+}
+
+void native_clock_reset(uint64_t start_us) {
+    clock_us = start_us;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Virtuālais pulkstenis host (native) būvējumam
+ *
+ * millis(), micros(), delay(), xTaskGetTickCount() un vTaskDelay() uz Linux
+ * neskatās uz reālo laiku, bet uz šo pulksteni. Laiku virza tikai harness
+ * (vai koda izsauktais delay()), tāpēc katrs palaidiens ir deterministisks
+ * un 8 stundu kurināšanu var izsimulēt dažās sekundēs.
+ */
+
+uint64_t native_clock_now_us();
+unsigned long native_clock_now_ms();
+
+// Pavirza virtuālo laiku uz priekšu
+void native_clock_advance_ms(unsigned long ms);
+void native_clock_advance_us(uint64_t us);
+
+// Atiestata pulksteni (piem., starp vairākiem simulācijas palaidieniem)
+void native_clock_reset(uint64_t start_us = 0);
@@ -0,0 +1,60 @@
+// Displeja (lvgl_display), iestatījumu ekrāna un WiFi/Telegram bibliotēku
+// aizstājēji. Šīs bibliotēkas uz host netiek kompilētas (sk. lib_ignore
+// platformio.ini [env:native]), bet vadības kods izsauc to funkcijas.
+
+#include "native_ui.h"
+#include "lvgl_display.h"
+#include "settings_screen.h"
+#include "wifi1.h"
+
+// settings_screen.cpp globālie mainīgie
+uint8_t screenBrightness = 255;
+uint32_t timeUpdateIntervalMs = 30000;
+uint32_t touchUpdateIntervalMs = 50;
+
+// wifi1.cpp globālie mainīgie
+bool waitingForTemp = false;
+bool waitingForKP = false;
+bool waitingForTempMin = false;
+
+static bool manual_mode = false;
+static bool target_temp_changed = false;
+static native_ui_stats_t ui_stats = {0};
+
+void native_ui_set_manual_mode(bool manual) {
+    manual_mode = manual;
+}
+
+void native_ui_notify_target_temp_changed() {
+    target_temp_changed = true;
+}
+
+native_ui_stats_t native_ui_get_stats() {
+    return ui_stats;
+}
+
+bool is_manual_damper_mode() {
+    return manual_mode;
+}
+
+bool isTargetTempChanged() {
+    if (target_temp_changed) {
+        target_temp_changed = false;
+        return true;
+    }
+    return false;
+}
+
+void lvgl_display_init() {}
+void lvgl_display_update_bars() { ui_stats.bar_redraws++; }
+void lvgl_display_touch_update() { ui_stats.touch_polls++; }
+void lvgl_display_update_damper() { ui_stats.damper_redraws++; }
+void lvgl_display_update_target_temp() { ui_stats.target_redraws++; }
+void lvgl_display_update_damper_status() { ui_stats.status_redraws++; }
+void lvgl_display_set_time(const char* time_str) { (void)time_str; }
+void show_time_on_display() {}
+void show_time_reset_cache() {}
+void lvgl_display_show_warning(const char* title, const char* message) {
+    (void)title;
+    (void)message;
+}
@@ -0,0 +1,98 @@
+#include "esp_partition.h"
+#include "native_hw.h"
+#include <stdio.h>
+#include <string.h>
+
+#define NATIVE_FLASH_SECTOR 4096
+
+// partitions_16MB.csv: spiffs, data, spiffs, 0xDE0000, 0x220000
+static const esp_partition_t spiffs_partition = {
+    ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, 0xDE0000, 0x220000, "spiffs", false,
+};
+
+static uint8_t flash_data[0x220000];
+static bool flash_initialized = false;
+static native_flash_stats_t flash_stats = {0};
+
+static void flash_init() {
+    if (!flash_initialized) {
+        memset(flash_data, 0xFF, sizeof(flash_data));
+        flash_initialized = true;
+    }
+}
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+    if (type != ESP_PARTITION_TYPE_DATA ||
+        (subtype != ESP_PARTITION_SUBTYPE_DATA_SPIFFS && subtype != ESP_PARTITION_SUBTYPE_ANY) ||
+        (label != nullptr && strcmp(label, spiffs_partition.label) != 0)) {
+        return nullptr;
+    }
+    flash_init();
+    return &spiffs_partition;
+}
+
+static bool in_range(const esp_partition_t* partition, size_t offset, size_t size) {
+    return partition == &spiffs_partition && offset <= partition->size && size <= partition->size - offset;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t src_offset, void* dst, size_t size) {
+    if (!in_range(partition, src_offset, size)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(dst, flash_data + src_offset, size);
+    flash_stats.bytes_read += size;
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t dst_offset, const void* src, size_t size) {
+    if (!in_range(partition, dst_offset, size)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    const uint8_t* bytes = (const uint8_t*)src;
+    for (size_t i = 0; i < size; i++) {
+        // NOR: 0 -> 1 bez dzēšanas nav iespējams; tāds rakstījums ir kļūda rakstītājā
+        if ((flash_data[dst_offset + i] & bytes[i]) != bytes[i]) {
+            flash_stats.overwrites++;
+        }
+        flash_data[dst_offset + i] &= bytes[i];
+    }
+    flash_stats.writes++;
+    flash_stats.bytes_written += size;
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t size) {
+    if (!in_range(partition, offset, size) || offset % NATIVE_FLASH_SECTOR != 0 || size % NATIVE_FLASH_SECTOR != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(flash_data + offset, 0xFF, size);
+    flash_stats.sector_erases += size / NATIVE_FLASH_SECTOR;
+    return ESP_OK;
+}
+
+native_flash_stats_t native_flash_stats() {
+    return flash_stats;
+}
+
+bool native_flash_save(const char* path) {
+    flash_init();
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    const bool ok = fwrite(flash_data, 1, sizeof(flash_data), file) == sizeof(flash_data);
+    fclose(file);
+    return ok;
+}
+
+bool native_flash_load(const char* path) {
+    flash_init();
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    const bool ok = fread(flash_data, 1, sizeof(flash_data), file) == sizeof(flash_data);
+    fclose(file);
+    return ok;
+}
@@ -0,0 +1,179 @@
+#include "native_harness.h"
+#include <Arduino.h>
+#include <chrono>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/timers.h>
+#include "damper_control.h"
+#include "temperature.h"
+#include "temperature_sensor.h"
+#include "native_hw.h"
+#include "touch_button.h"
+#include "display_manager.h"
+#include "settings_storage.h"
+#include "telnet.h"
+#include "logger.h"
+#include "recorder.h"
+
+static native_run_stats_t stats = {0};
+static unsigned long next_loop_ms = 0;
+static unsigned long next_damper_task_ms = 0;
+static bool damper_task_sleeping = false;   // Gaida paziņojumu (ulTaskNotifyTake)
+static unsigned long next_sensor_task_ms = 0;
+static unsigned long next_control_task_ms = 0;
+static unsigned long next_log_task_ms = 0;
+static unsigned long loop_period_ms = NATIVE_LOOP_PERIOD_MS;
+
+void native_firmware_setup() {
+    stats = native_run_stats_t{};
+
+    // Tāda pati secība kā main.cpp setup(), bez displeja, WiFi, OTA un Telegram
+    loggerBegin();
+    recorderBegin();
+    initSettingsStorage();
+    touchButtonInit(2, TOUCH_THRESHOLD, TOUCH_DEBOUNCE_MS);
+    display_manager_init();
+    initTemperatureSensor();
+    Telnet.begin(23);
+    display_manager_set_update_intervals(0, 0, 30000, 50);
+    startDamperControlTask();
+
+    next_loop_ms = millis();
+    next_damper_task_ms = millis();
+    damper_task_sleeping = false;
+    next_sensor_task_ms = millis();
+    next_control_task_ms = millis() + DAMPER_CONTROL_PERIOD_MS;
+    next_log_task_ms = millis() + LOG_FLASH_PERIOD_MS;
+}
+
+static void firmware_loop_once() {
+    // main.cpp loop() bez lv_timer_handler(), ota_loop() un Telegram
+    Telnet.handle();
+    updateTemperature();
+    damperControlApplyAutotune();
+    touchButtonHandle();
+    display_manager_update();
+}
+
+void native_firmware_set_loop_period_ms(unsigned long period_ms) {
+    loop_period_ms = period_ms > 0 ? period_ms : NATIVE_LOOP_PERIOD_MS;
+}
+
+bool native_firmware_run_for(unsigned long duration_ms, native_tick_hook_t hook, void* ctx) {
+    const unsigned long end_ms = millis() + duration_ms;
+
+    try {
+        while ((long)(end_ms - millis()) > 0) {
+            // Nākamais notikums: loop(), DamperTask, SensorTask vai ControlTask, kurš agrāk
+            unsigned long next_ms = next_loop_ms;
+            if (!damper_task_sleeping && (long)(next_damper_task_ms - next_ms) < 0) next_ms = next_damper_task_ms;
+            if ((long)(next_sensor_task_ms - next_ms) < 0) next_ms = next_sensor_task_ms;
+            if ((long)(next_control_task_ms - next_ms) < 0) next_ms = next_control_task_ms;
+            if ((long)(next_log_task_ms - next_ms) < 0) next_ms = next_log_task_ms;
+            unsigned long timer_ms = 0;
+            if (native_timers_next_ms(&timer_ms) && (long)(timer_ms - next_ms) < 0) next_ms = timer_ms;
+            if ((long)(next_ms - millis()) > 0) {
+                native_clock_advance_ms(next_ms - millis());
+            }
+
+            // Taimeru uzdevums (buzzer raksti) ir ar augstāko prioritāti
+            native_timers_service();
+
+            // ControlTask ir nākamais pēc prioritātes
+            if ((long)(millis() - next_control_task_ms) >= 0) {
+                const auto start = std::chrono::steady_clock::now();
+                damperControlTaskStep();
+                const uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+                stats.control_task_iterations++;
+                stats.control_host_ns += ns;
+                if (ns > stats.control_host_max_ns) {
+                    stats.control_host_max_ns = ns;
+                }
+                // vTaskDelayUntil: periods skaitās no iepriekšējās pamošanās
+                next_control_task_ms += DAMPER_CONTROL_PERIOD_MS;
+                if ((long)(millis() - next_control_task_ms) >= 0) {
+                    next_control_task_ms = millis() + DAMPER_CONTROL_PERIOD_MS;
+                }
+            }
+
+            // DamperTask: kustības laikā ik pēc SERVO_STEP_PERIOD_MS, citādi guļ
+            // līdz paziņojumam (ControlTask to dod, publicējot jaunu mērķi)
+            if (damper_task_sleeping && native_task_notify_take(damperTaskHandle) > 0) {
+                damper_task_sleeping = false;
+                next_damper_task_ms = millis();
+            }
+            if (!damper_task_sleeping && (long)(millis() - next_damper_task_ms) >= 0) {
+                const bool moving = moveServoToDamper();
+                stats.damper_task_iterations++;
+                if (moving) {
+                    next_damper_task_ms += SERVO_STEP_PERIOD_MS;
+                    if ((long)(millis() - next_damper_task_ms) >= 0) {
+                        next_damper_task_ms = millis() + SERVO_STEP_PERIOD_MS;
+                    }
+                } else {
+                    damper_task_sleeping = true;
+                }
+            }
+
+            // SensorTask: konversijas laikā ik pēc SENSOR_TASK_PERIOD_MS, starp
+            // kārtām līdz nākamajai vai paziņojumam (skenēšana, kanālu maiņa)
+            if (native_task_notify_take(sensorTaskHandle) > 0) {
+                next_sensor_task_ms = millis();
+            }
+            if ((long)(millis() - next_sensor_task_ms) >= 0) {
+                const uint64_t bus_start_us = native_onewire_bus_us();
+                const uint32_t wait_ms = temperatureSensorTaskStep();
+                stats.sensor_onewire_us += native_onewire_bus_us() - bus_start_us;
+                stats.sensor_task_iterations++;
+                next_sensor_task_ms = millis() + wait_ms;
+            }
+
+            // LogTask: periodiski vai uzreiz pēc paziņojuma (WARN/ERROR, pusē pilns buferis)
+            if (native_task_notify_take(loggerTaskHandle) > 0 || (long)(millis() - next_log_task_ms) >= 0) {
+                loggerTaskStep();
+                stats.log_task_iterations++;
+                next_log_task_ms = millis() + LOG_FLASH_PERIOD_MS;
+            }
+
+            // RecTask: tikai pēc paziņojuma (ControlTask nodeva pilnu bloku)
+            if (native_task_notify_take(recorderTaskHandle) > 0) {
+                recorderTaskStep();
+                stats.recorder_task_iterations++;
+            }
+
+            if ((long)(millis() - next_loop_ms) >= 0) {
+                if (hook) {
+                    hook(millis(), ctx);
+                }
+
+                const uint64_t bus_start_us = native_onewire_bus_us();
+                const auto start = std::chrono::steady_clock::now();
+                firmware_loop_once();
+                stats.loop_onewire_us += native_onewire_bus_us() - bus_start_us;
+                const uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+
+                stats.loop_iterations++;
+                stats.loop_host_ns += ns;
+                if (ns > stats.loop_host_max_ns) {
+                    stats.loop_host_max_ns = ns;
+                }
+
+                // loop() beigās ir delay(5); ja ķermenis pats izsauca delay(),
+                // nākamā iterācija sākas attiecīgi vēlāk
+                next_loop_ms = millis() + loop_period_ms;
+            }
+        }
+    } catch (const NativeDeepSleep& sleep) {
+        stats.deep_sleep = true;
+        stats.deep_sleep_ms = sleep.at_ms;
+        return false;
+    }
+
+    return true;
+}
+
+const native_run_stats_t& native_firmware_stats() {
+    return stats;
+}
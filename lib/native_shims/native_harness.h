@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Host harness, kas darbina firmware vadības daļu ar virtuālo pulksteni
+ *
+ * native_firmware_setup() atkārto main.cpp setup() tām bibliotēkām, kas
+ * kompilējas uz host. native_firmware_run_for() virza virtuālo laiku un
+ * izsauc loop() ķermeni ik pēc 5 ms, SensorTask konversijas laikā ik pēc 10 ms
+ * (starp kārtām - nākamās kārtas laikā vai pēc paziņojuma), ControlTask ik pēc
+ * DAMPER_CONTROL_PERIOD_MS un DamperTask kustības laikā ik pēc SERVO_STEP_PERIOD_MS
+ * (bez kustības - tikai pēc paziņojuma), LogTask ik pēc LOG_FLASH_PERIOD_MS
+ * (vai pēc paziņojuma) un RecTask pēc paziņojuma - tādā pašā ritmā kā uz ESP32-S3.
+ * Programmatūras taimeru callback izpildās to termiņos (freertos/timers.h).
+ */
+
+#define NATIVE_LOOP_PERIOD_MS        5
+
+typedef struct {
+    uint64_t loop_iterations;
+    uint64_t loop_host_ns;        // Reālais CPU laiks, kas pavadīts loop() ķermenī
+    uint64_t loop_host_max_ns;
+    uint64_t loop_onewire_us;     // OneWire kopnes laiks loop() iekšienē (jābūt 0)
+    uint64_t sensor_task_iterations;
+    uint64_t sensor_onewire_us;   // ... un SensorTask
+    uint64_t damper_task_iterations;
+    uint64_t control_task_iterations;
+    uint64_t control_host_ns;     // Reālais CPU laiks ControlTask solī (damperControlTaskStep)
+    uint64_t control_host_max_ns;
+    uint64_t log_task_iterations;
+    uint64_t recorder_task_iterations;
+    bool deep_sleep;              // Firmware izsauca esp_deep_sleep_start()
+    unsigned long deep_sleep_ms;  // Virtuālais laiks, kad tas notika
+} native_run_stats_t;
+
+// Izsauc tieši pirms katras loop() iterācijas (piem., krāsns simulatora solim)
+typedef void (*native_tick_hook_t)(unsigned long now_ms, void* ctx);
+
+void native_firmware_setup();
+
+// loop() periods (noklusējums NATIVE_LOOP_PERIOD_MS). Atkārtošanai, kurai
+// displejs un telnet nav svarīgi, lielāks periods ļoti paātrina darbību;
+// uzdevumu ritms nemainās
+void native_firmware_set_loop_period_ms(unsigned long period_ms);
+
+// Darbina firmware duration_ms virtuālā laika. Atgriež false, ja firmware
+// aizgāja deep sleep (tad tālāk darbināt nav jēgas).
+bool native_firmware_run_for(unsigned long duration_ms, native_tick_hook_t hook = nullptr, void* ctx = nullptr);
+
+const native_run_stats_t& native_firmware_stats();
@@ -0,0 +1,453 @@
+#include "native_hw.h"
+#include <ESP32Servo.h>
+#include <DallasTemperature.h>
+#include <Preferences.h>
+#include <WiFi.h>
+#include <map>
+#include <string.h>
+
+WiFiClass WiFi;
+
+// DS18B20
+
+#define NATIVE_SENSOR_MAX 4
+
+typedef struct {
+    uint8_t address[8];
+    float temp_c;
+    bool present;
+    uint8_t resolution;
+    int16_t raw;              // °C × 16 pēc pēdējās konversijas
+} native_sensor_t;
+
+// Sensors 0 ir dūmgāzu sensors ar firmware noklusējuma adresi
+static native_sensor_t sensors[NATIVE_SENSOR_MAX] = {
+    {{0x28, 0xFC, 0x70, 0x96, 0xF0, 0x01, 0x3C, 0xC0}, 20.0f, true, 12, 0x0550},
+};
+static int sensor_count = 1;
+static uint32_t sensor_crc_errors_pending = 0;
+static uint64_t onewire_bus_us = 0;
+static unsigned long conversion_start_ms = 0;
+static uint8_t conversion_bits = 12;
+
+// Kopnes laiki standarta ātrumā: reset + presence ~960 us, viens bita slots ~70 us
+#define ONEWIRE_RESET_US 960
+#define ONEWIRE_SLOT_US  70
+// reset + MATCH ROM + 64 bitu adrese + komanda
+#define ONEWIRE_SELECT_US (ONEWIRE_RESET_US + (8 + 64 + 8) * ONEWIRE_SLOT_US)
+// reset + SKIP ROM + komanda
+#define ONEWIRE_SKIP_US   (ONEWIRE_RESET_US + (8 + 8) * ONEWIRE_SLOT_US)
+// Search ROM: 64 biti × (2 nolasīti + 1 rakstīts) uz katru sensoru
+#define ONEWIRE_SEARCH_US (ONEWIRE_RESET_US + 8 * ONEWIRE_SLOT_US + 64 * 3 * ONEWIRE_SLOT_US)
+
+static native_sensor_t* find_sensor(const uint8_t* address) {
+    for (int i = 0; i < sensor_count; i++) {
+        if (memcmp(sensors[i].address, address, 8) == 0) {
+            return &sensors[i];
+        }
+    }
+    return nullptr;
+}
+
+static bool bus_has_presence() {
+    for (int i = 0; i < sensor_count; i++) {
+        if (sensors[i].present) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void native_sensor_set_temp_c(float temp_c) {
+    sensors[0].temp_c = temp_c;
+}
+
+float native_sensor_get_temp_c() {
+    return sensors[0].temp_c;
+}
+
+int native_sensor_add(float temp_c) {
+    if (sensor_count >= NATIVE_SENSOR_MAX) {
+        return -1;
+    }
+    native_sensor_t* s = &sensors[sensor_count];
+    const uint8_t address[7] = {0x28, (uint8_t)(0x10 + sensor_count), 0x22, 0x33, 0x44, 0x55, 0x66};
+    memcpy(s->address, address, 7);
+    s->address[7] = OneWire::crc8(address, 7);
+    s->temp_c = temp_c;
+    s->present = true;
+    s->resolution = 12;
+    s->raw = 0x0550;
+    return sensor_count++;
+}
+
+void native_sensor_set_device_temp_c(int device, float temp_c) {
+    if (device >= 0 && device < sensor_count) {
+        sensors[device].temp_c = temp_c;
+    }
+}
+
+bool native_sensor_address(int device, uint8_t address[8]) {
+    if (device < 0 || device >= sensor_count) {
+        return false;
+    }
+    memcpy(address, sensors[device].address, 8);
+    return true;
+}
+
+void native_sensor_set_present(bool present, int device) {
+    if (device >= 0 && device < sensor_count) {
+        sensors[device].present = present;
+    }
+}
+
+void native_sensor_inject_crc_errors(uint32_t count) {
+    sensor_crc_errors_pending = count;
+}
+
+uint64_t native_onewire_bus_us() {
+    return onewire_bus_us;
+}
+
+uint8_t OneWire::crc8(const uint8_t* addr, uint8_t len) {
+    uint8_t crc = 0;
+    while (len--) {
+        uint8_t inbyte = *addr++;
+        for (uint8_t i = 8; i; i--) {
+            uint8_t mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix) {
+                crc ^= 0x8C;
+            }
+            inbyte >>= 1;
+        }
+    }
+    return crc;
+}
+
+void DallasTemperature::begin() {
+    (void)bus;
+    deviceCount = 0;
+    onewire_bus_us += ONEWIRE_RESET_US;
+    for (int i = 0; i < sensor_count; i++) {
+        if (sensors[i].present) {
+            deviceCount++;
+            onewire_bus_us += ONEWIRE_SEARCH_US;
+        }
+    }
+}
+
+bool DallasTemperature::getAddress(uint8_t* address, uint8_t index) {
+    uint8_t found = 0;
+    for (int i = 0; i < sensor_count; i++) {
+        if (!sensors[i].present) {
+            continue;
+        }
+        if (found++ == index) {
+            memcpy(address, sensors[i].address, 8);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DallasTemperature::setResolution(const uint8_t* address, uint8_t bits) {
+    native_sensor_t* s = find_sensor(address);
+    if (bits < 9 || bits > 12 || !s || !s->present) {
+        return false;
+    }
+    // WRITE SCRATCHPAD (3 baiti)
+    onewire_bus_us += ONEWIRE_SELECT_US + 3 * 8 * ONEWIRE_SLOT_US;
+    s->resolution = bits;
+    return true;
+}
+
+uint8_t DallasTemperature::getResolution(const uint8_t* address) {
+    native_sensor_t* s = find_sensor(address);
+    return s ? s->resolution : 0;
+}
+
+int16_t DallasTemperature::millisToWaitForConversion(uint8_t bits) {
+    switch (bits) {
+        case 9:  return 94;
+        case 10: return 188;
+        case 11: return 375;
+        default: return 750;
+    }
+}
+
+bool DallasTemperature::isConversionComplete() {
+    // Viens nolasīts bits: kāds sensors tur 0, kamēr konvertē
+    onewire_bus_us += ONEWIRE_SLOT_US;
+    return millis() - conversion_start_ms >= (unsigned long)millisToWaitForConversion(conversion_bits);
+}
+
+// Sensors nolasa temperatūru konversijas sākumā ar savu izšķirtspēju
+static void start_conversion(native_sensor_t* s) {
+    // DS18B20 nogriež mazāk nozīmīgos bitus: 9 biti = 0.5 °C solis
+    const int shift = 12 - s->resolution;
+    s->raw = (int16_t)((int32_t)floorf(s->temp_c * 16.0f / (1 << shift)) * (1 << shift));
+}
+
+void DallasTemperature::requestTemperatures() {
+    onewire_bus_us += ONEWIRE_SKIP_US;
+    conversion_bits = 9;
+    for (int i = 0; i < sensor_count; i++) {
+        if (sensors[i].present) {
+            start_conversion(&sensors[i]);
+            if (sensors[i].resolution > conversion_bits) {
+                conversion_bits = sensors[i].resolution;
+            }
+        }
+    }
+    conversion_start_ms = millis();
+    if (waitForConversion) {
+        delay(millisToWaitForConversion(conversion_bits));
+    }
+}
+
+bool DallasTemperature::requestTemperaturesByAddress(const uint8_t* address) {
+    // Bibliotēka vispirms nolasa izšķirtspēju no scratchpad, tad sūta CONVERT T
+    ScratchPad scratch;
+    if (!readScratchPad(address, scratch) || OneWire::crc8(scratch, 8) != scratch[8]) {
+        return false;
+    }
+    onewire_bus_us += ONEWIRE_SELECT_US;
+
+    native_sensor_t* s = find_sensor(address);
+    start_conversion(s);
+    conversion_bits = s->resolution;
+    conversion_start_ms = millis();
+
+    if (waitForConversion) {
+        delay(millisToWaitForConversion(conversion_bits));
+    }
+    return true;
+}
+
+bool DallasTemperature::readScratchPad(const uint8_t* address, uint8_t* scratchPad) {
+    if (!bus_has_presence()) {
+        onewire_bus_us += ONEWIRE_RESET_US;
+        return false;
+    }
+    onewire_bus_us += ONEWIRE_SELECT_US + 9 * 8 * ONEWIRE_SLOT_US;
+
+    native_sensor_t* s = find_sensor(address);
+    if (!s || !s->present) {
+        // Neviens neatbild uz šo adresi - kopne paliek augstā līmenī
+        memset(scratchPad, 0xFF, 9);
+        return true;
+    }
+
+    scratchPad[0] = (uint8_t)(s->raw & 0xFF);
+    scratchPad[1] = (uint8_t)((uint16_t)s->raw >> 8);
+    scratchPad[2] = 0x4B;                                  // TH
+    scratchPad[3] = 0x46;                                  // TL
+    scratchPad[4] = (uint8_t)(((s->resolution - 9) << 5) | 0x1F);
+    scratchPad[5] = 0xFF;
+    scratchPad[6] = 0x0C;
+    scratchPad[7] = 0x10;
+    scratchPad[8] = OneWire::crc8(scratchPad, 8);
+
+    // Traucējums kopnē: viens apgriezts bits, CRC vairs nesakrīt
+    if (sensor_crc_errors_pending > 0) {
+        sensor_crc_errors_pending--;
+        scratchPad[0] ^= 0x04;
+    }
+    return true;
+}
+
+float DallasTemperature::getTempC(const uint8_t* address) {
+    ScratchPad scratch;
+    if (!readScratchPad(address, scratch) || OneWire::crc8(scratch, 8) != scratch[8]) {
+        return DEVICE_DISCONNECTED_C;
+    }
+    return (int16_t)(scratch[0] | (scratch[1] << 8)) / 16.0f;
+}
+
+// Servo
+
+static int servo_us = 0;
+static bool servo_is_attached = false;
+static uint32_t servo_attach_count = 0;
+
+int Servo::attach(int pin) {
+    return attach(pin, 500, 2500);
+}
+
+int Servo::attach(int pin, int minUs, int maxUs) {
+    (void)minUs;
+    (void)maxUs;
+    this->pin = pin;
+    servo_is_attached = true;
+    servo_attach_count++;
+    return 0;
+}
+
+void Servo::detach() {
+    pin = -1;
+    servo_is_attached = false;
+}
+
+void Servo::write(int angle) {
+    writeMicroseconds((int)map(angle, 0, 180, 500, 2500));
+}
+
+void Servo::writeMicroseconds(int us) {
+    this->us = us;
+    servo_us = us;
+}
+
+void Servo::writeTicks(int ticks) {
+    // 50 Hz: viens periods (20000 us) ir 2^timerWidth soļi
+    this->ticks = ticks;
+    us = (int)(((int64_t)ticks * 20000) >> timerWidth);
+    servo_us = us;
+}
+
+int native_servo_microseconds() {
+    return servo_us;
+}
+
+bool native_servo_attached() {
+    return servo_is_attached;
+}
+
+uint32_t native_servo_attach_count() {
+    return servo_attach_count;
+}
+
+// Preferences
+
+static std::map<std::string, std::map<std::string, std::string>> nvs;
+
+bool Preferences::begin(const char* name, bool readOnly) {
+    (void)readOnly;
+    ns = name ? name : "";
+    started = true;
+    return true;
+}
+
+void Preferences::end() {
+    started = false;
+}
+
+bool Preferences::clear() {
+    nvs[ns].clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    return nvs[ns].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+    return nvs[ns].count(key) > 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len) {
+    if (!started) {
+        return 0;
+    }
+    nvs[ns][key] = std::string((const char*)value, len);
+    return len;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    auto it = nvs[ns].find(key);
+    return it == nvs[ns].end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+    auto it = nvs[ns].find(key);
+    if (it == nvs[ns].end() || it->second.size() > maxLen) {
+        return 0;
+    }
+    memcpy(buf, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+template <typename T>
+static size_t put_value(Preferences& prefs, const char* key, T value) {
+    return prefs.putBytes(key, &value, sizeof(value));
+}
+
+template <typename T>
+static T get_value(Preferences& prefs, const char* key, T defaultValue) {
+    T value;
+    if (prefs.getBytesLength(key) != sizeof(T) || prefs.getBytes(key, &value, sizeof(T)) != sizeof(T)) {
+        return defaultValue;
+    }
+    return value;
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) { return put_value(*this, key, value); }
+size_t Preferences::putUInt(const char* key, uint32_t value) { return put_value(*this, key, value); }
+size_t Preferences::putULong(const char* key, uint32_t value) { return put_value(*this, key, value); }
+size_t Preferences::putChar(const char* key, int8_t value) { return put_value(*this, key, value); }
+size_t Preferences::putUChar(const char* key, uint8_t value) { return put_value(*this, key, value); }
+size_t Preferences::putFloat(const char* key, float value) { return put_value(*this, key, value); }
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) { return get_value(*this, key, defaultValue); }
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) { return get_value(*this, key, defaultValue); }
+uint32_t Preferences::getULong(const char* key, uint32_t defaultValue) { return get_value(*this, key, defaultValue); }
+int8_t Preferences::getChar(const char* key, int8_t defaultValue) { return get_value(*this, key, defaultValue); }
+uint8_t Preferences::getUChar(const char* key, uint8_t defaultValue) { return get_value(*this, key, defaultValue); }
+float Preferences::getFloat(const char* key, float defaultValue) { return get_value(*this, key, defaultValue); }
+
+// WiFi / telnet
+
+static bool telnet_client_pending = false;
+static uint32_t telnet_bytes = 0;
+static uint32_t telnet_writes = 0;
+static uint32_t telnet_lines = 0;
+
+void native_telnet_connect_client() {
+    telnet_client_pending = true;
+}
+
+uint32_t native_telnet_bytes() {
+    return telnet_bytes;
+}
+
+uint32_t native_telnet_writes() {
+    return telnet_writes;
+}
+
+uint32_t native_telnet_lines() {
+    return telnet_lines;
+}
+
+bool WiFiServer::hasClient() {
+    (void)port;
+    return telnet_client_pending;
+}
+
+WiFiClient WiFiServer::available() {
+    if (!telnet_client_pending) {
+        return WiFiClient();
+    }
+    telnet_client_pending = false;
+    return WiFiClient(true);
+}
+
+size_t WiFiClient::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    if (!isOpen) {
+        return 0;
+    }
+    telnet_bytes += size;
+    telnet_writes++;
+    for (size_t i = 0; i < size; i++) {
+        if (buffer[i] == '\n') {
+            telnet_lines++;
+        }
+    }
+    if (native_console_enabled) {
+        fwrite(buffer, 1, size, stdout);
+    }
+    return size;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Host harness piekļuve viltotajai aparatūrai
+ *
+ * Ar šīm funkcijām harness (vai krāsns simulators) uzstāda, ko "redz"
+ * DS18B20 sensors, nolasa, kur servo ir aizgājis, un pievieno telnet klientu.
+ */
+
+// DS18B20: temperatūra, ko dūmgāzu sensors (0) izmērīs nākamajā konversijā
+void native_sensor_set_temp_c(float temp_c);
+float native_sensor_get_temp_c();
+
+// Papildu sensori uz tās pašas kopnes (istaba, ūdens). native_sensor_add()
+// atgriež sensora numuru; adresi firmware kanālam piesaista harness.
+int native_sensor_add(float temp_c);
+void native_sensor_set_device_temp_c(int device, float temp_c);
+bool native_sensor_address(int device, uint8_t address[8]);
+
+// DS18B20 traucējumi: sensors pazūd no kopnes / nākamie count nolasījumi ar bojātu CRC
+void native_sensor_set_present(bool present, int device = 0);
+void native_sensor_inject_crc_errors(uint32_t count);
+
+// Kopā OneWire kopnē pavadītais laiks (modelēts, virtuālo pulksteni nevirza)
+uint64_t native_onewire_bus_us();
+
+// Servo: pēdējais uzrakstītais impulss un pievienošanas statistika
+int native_servo_microseconds();
+bool native_servo_attached();
+uint32_t native_servo_attach_count();
+
+// Telnet: nākamais server.hasClient() atgriezīs jaunu klientu
+void native_telnet_connect_client();
+
+// Telnet klientiem nosūtītie baiti un write() izsaukumi (≈ TCP segmenti ar NoDelay)
+uint32_t native_telnet_bytes();
+uint32_t native_telnet_writes();
+uint32_t native_telnet_lines();   // Nosūtītās rindas ('\n')
+
+// Flash (esp_partition "spiffs" atmiņā): operāciju skaitītāji un attēla
+// saglabāšana/ielāde, lai žurnālu varētu nolasīt arī pēc "restarta"
+typedef struct {
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    uint32_t writes;
+    uint32_t sector_erases;
+    uint32_t overwrites;     // Rakstīšana nedzēstā vietā (0 -> 1 biti) - jābūt 0
+} native_flash_stats_t;
+
+native_flash_stats_t native_flash_stats();
+bool native_flash_save(const char* path);
+bool native_flash_load(const char* path);
@@ -0,0 +1,270 @@
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/timers.h>
+#include <freertos/semphr.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Piereģistrēto uzdevumu saraksts (tikai diagnostikai un rokturiem)
+#define NATIVE_MAX_TASKS 8
+
+static struct {
+    TaskFunction_t function;
+    char name[16];
+    uint32_t notifications;
+} native_tasks[NATIVE_MAX_TASKS];
+static int native_task_count = 0;
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)native_clock_now_ms();
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+    native_clock_advance_ms(xTicksToDelay);
+}
+
+void vTaskDelayUntil(TickType_t* pxPreviousWakeTime, TickType_t xTimeIncrement) {
+    *pxPreviousWakeTime += xTimeIncrement;
+    const TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(*pxPreviousWakeTime - now) > 0) {
+        native_clock_advance_ms(*pxPreviousWakeTime - now);
+    }
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode,
+                                   const char* pcName,
+                                   uint32_t usStackDepth,
+                                   void* pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t* pvCreatedTask,
+                                   BaseType_t xCoreID) {
+    (void)usStackDepth;
+    (void)pvParameters;
+    (void)uxPriority;
+    (void)xCoreID;
+
+    if (native_task_count >= NATIVE_MAX_TASKS) {
+        return pdFAIL;
+    }
+
+    native_tasks[native_task_count].function = pvTaskCode;
+    strncpy(native_tasks[native_task_count].name, pcName ? pcName : "",
+            sizeof(native_tasks[native_task_count].name) - 1);
+    if (pvCreatedTask) {
+        *pvCreatedTask = &native_tasks[native_task_count];
+    }
+    native_task_count++;
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify) {
+    if (!xTaskToNotify) {
+        return pdFAIL;
+    }
+    ((decltype(&native_tasks[0]))xTaskToNotify)->notifications++;
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+    // Uz host neviens uzdevums negaida (sk. native_task_notify_take())
+    (void)xClearCountOnExit;
+    (void)xTicksToWait;
+    return 0;
+}
+
+uint32_t native_task_notify_take(TaskHandle_t task) {
+    if (!task) {
+        return 0;
+    }
+    auto* entry = (decltype(&native_tasks[0]))task;
+    const uint32_t count = entry->notifications;
+    entry->notifications = 0;
+    return count;
+}
+
+// Rindas
+
+struct native_queue {
+    uint8_t* storage;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+    if (uxQueueLength == 0 || uxItemSize == 0) {
+        return nullptr;
+    }
+    QueueHandle_t queue = (QueueHandle_t)calloc(1, sizeof(struct native_queue));
+    if (!queue) {
+        return nullptr;
+    }
+    queue->storage = (uint8_t*)calloc(uxQueueLength, uxItemSize);
+    if (!queue->storage) {
+        free(queue);
+        return nullptr;
+    }
+    queue->length = uxQueueLength;
+    queue->itemSize = uxItemSize;
+    return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait) {
+    (void)xTicksToWait;
+    if (!xQueue || xQueue->count >= xQueue->length) {
+        return pdFALSE;
+    }
+    const UBaseType_t tail = (xQueue->head + xQueue->count) % xQueue->length;
+    memcpy(xQueue->storage + tail * xQueue->itemSize, pvItemToQueue, xQueue->itemSize);
+    xQueue->count++;
+    return pdTRUE;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t xQueue, const void* pvItemToQueue) {
+    // Tāpat kā FreeRTOS - paredzēts tikai rindām ar garumu 1
+    if (!xQueue) {
+        return pdFALSE;
+    }
+    xQueue->head = 0;
+    xQueue->count = 0;
+    return xQueueSend(xQueue, pvItemToQueue, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait) {
+    (void)xTicksToWait;
+    if (!xQueue || xQueue->count == 0) {
+        return pdFALSE;
+    }
+    memcpy(pvBuffer, xQueue->storage + xQueue->head * xQueue->itemSize, xQueue->itemSize);
+    xQueue->head = (xQueue->head + 1) % xQueue->length;
+    xQueue->count--;
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue) {
+    return xQueue ? xQueue->count : 0;
+}
+
+// Mutex
+
+struct native_mutex {
+    uint32_t takes;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return (SemaphoreHandle_t)calloc(1, sizeof(struct native_mutex));
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait) {
+    (void)xTicksToWait;
+    if (!xSemaphore) {
+        return pdFALSE;
+    }
+    xSemaphore->takes++;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+    return xSemaphore ? pdTRUE : pdFALSE;
+}
+
+// Programmatūras taimeri
+
+#define NATIVE_MAX_TIMERS 4
+
+struct native_timer {
+    TickType_t period;
+    bool autoReload;
+    void* id;
+    TimerCallbackFunction_t callback;
+    bool active;
+    unsigned long expiryMs;
+};
+
+static struct native_timer native_timers[NATIVE_MAX_TIMERS];
+static int native_timer_count = 0;
+
+TimerHandle_t xTimerCreate(const char* pcTimerName,
+                           TickType_t xTimerPeriodInTicks,
+                           UBaseType_t uxAutoReload,
+                           void* pvTimerID,
+                           TimerCallbackFunction_t pxCallbackFunction) {
+    (void)pcTimerName;
+    if (native_timer_count >= NATIVE_MAX_TIMERS || xTimerPeriodInTicks == 0) {
+        return nullptr;
+    }
+    TimerHandle_t timer = &native_timers[native_timer_count++];
+    timer->period = xTimerPeriodInTicks;
+    timer->autoReload = uxAutoReload != 0;
+    timer->id = pvTimerID;
+    timer->callback = pxCallbackFunction;
+    timer->active = false;
+    return timer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait) {
+    (void)xTicksToWait;
+    if (!xTimer) {
+        return pdFAIL;
+    }
+    xTimer->active = true;
+    xTimer->expiryMs = native_clock_now_ms() + xTimer->period;
+    return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait) {
+    (void)xTicksToWait;
+    if (!xTimer) {
+        return pdFAIL;
+    }
+    xTimer->active = false;
+    return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait) {
+    // Tāpat kā FreeRTOS - maina periodu un (no jauna) palaiž taimeri
+    if (!xTimer || xNewPeriod == 0) {
+        return pdFAIL;
+    }
+    xTimer->period = xNewPeriod;
+    return xTimerStart(xTimer, xTicksToWait);
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t xTimer) {
+    return xTimer && xTimer->active ? pdTRUE : pdFALSE;
+}
+
+void* pvTimerGetTimerID(TimerHandle_t xTimer) {
+    return xTimer ? xTimer->id : nullptr;
+}
+
+bool native_timers_next_ms(unsigned long* at_ms) {
+    bool found = false;
+    for (int i = 0; i < native_timer_count; i++) {
+        const struct native_timer* timer = &native_timers[i];
+        if (timer->active && (!found || (long)(timer->expiryMs - *at_ms) < 0)) {
+            *at_ms = timer->expiryMs;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void native_timers_service() {
+    const unsigned long now = native_clock_now_ms();
+    for (int i = 0; i < native_timer_count; i++) {
+        struct native_timer* timer = &native_timers[i];
+        if (!timer->active || (long)(now - timer->expiryMs) < 0) {
+            continue;
+        }
+        // Callback drīkst taimeri palaist no jauna (xTimerChangePeriod)
+        if (timer->autoReload) {
+            timer->expiryMs += timer->period;
+        } else {
+            timer->active = false;
+        }
+        timer->callback(timer);
+    }
+}
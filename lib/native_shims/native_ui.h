@@ -0,0 +1,21 @@
+#pragma once
+#include <stdint.h>
+
+// Host harness vadība pār displeja aizstājēju (native_fakes.cpp)
+
+// Ko atgriež is_manual_damper_mode() (UI manuālā režīma pārslēgs)
+void native_ui_set_manual_mode(bool manual);
+
+// Imitē Telegram/touch mērķa temperatūras maiņu (isTargetTempChanged())
+void native_ui_notify_target_temp_changed();
+
+// Cik reizes display_manager būtu pārzīmējis katru displeja daļu
+typedef struct {
+    uint32_t bar_redraws;
+    uint32_t damper_redraws;
+    uint32_t status_redraws;
+    uint32_t target_redraws;
+    uint32_t touch_polls;
+} native_ui_stats_t;
+
+native_ui_stats_t native_ui_get_stats();
@@ -0,0 +1,73 @@
+#include "output_ring.h"
+#include <stdio.h>
+#include <string.h>
+
+void output_ring_init(output_ring_t* ring, uint8_t* storage, uint32_t capacity) {
+    memset(ring, 0, sizeof(*ring));
+    ring->data = storage;
+    ring->capacity = storage ? capacity : 0;
+}
+
+void output_ring_clear(output_ring_t* ring) {
+    ring->head = 0;
+    ring->count = 0;
+    ring->pendingDropped = 0;
+}
+
+static void append(output_ring_t* ring, const uint8_t* data, uint32_t size) {
+    uint32_t tail = (ring->head + ring->count) % ring->capacity;
+    uint32_t first = ring->capacity - tail;
+    if (first > size) {
+        first = size;
+    }
+    memcpy(ring->data + tail, data, first);
+    memcpy(ring->data, data + first, size - first);
+    ring->count += size;
+}
+
+bool output_ring_fits(const output_ring_t* ring, uint32_t size) {
+    // Kopsavilkumam paturam vietu, lai to vienmēr var ielikt pirms nākamā gabala
+    const uint32_t reserve = ring->pendingDropped > 0 ? OUTPUT_RING_SUMMARY_MAX : 0;
+    return ring->capacity > 0 && ring->count + size + reserve <= ring->capacity;
+}
+
+uint32_t output_ring_write(output_ring_t* ring, const uint8_t* data, uint32_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    if (!output_ring_fits(ring, size)) {
+        ring->pendingDropped += size;
+        ring->droppedBytes += size;
+        ring->droppedWrites++;
+        return 0;
+    }
+    if (ring->pendingDropped > 0) {
+        char summary[OUTPUT_RING_SUMMARY_MAX];
+        int length = snprintf(summary, sizeof(summary), "\r\n[... izlaisti %lu baiti]\r\n",
+                              (unsigned long)ring->pendingDropped);
+        if (length > 0) {
+            append(ring, (const uint8_t*)summary, (uint32_t)length);
+        }
+        ring->pendingDropped = 0;
+    }
+    append(ring, data, size);
+    return size;
+}
+
+uint32_t output_ring_peek(const output_ring_t* ring, const uint8_t** data) {
+    if (ring->count == 0) {
+        *data = 0;
+        return 0;
+    }
+    *data = ring->data + ring->head;
+    const uint32_t untilEnd = ring->capacity - ring->head;
+    return ring->count < untilEnd ? ring->count : untilEnd;
+}
+
+void output_ring_consume(output_ring_t* ring, uint32_t size) {
+    if (size > ring->count) {
+        size = ring->count;
+    }
+    ring->head = (ring->head + size) % ring->capacity;
+    ring->count -= size;
+}
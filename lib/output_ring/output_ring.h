@@ -0,0 +1,40 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Output Ring - baitu gredzenbuferis lēnam izejas kanālam (telnet klientam)
+ *
+ * Rakstītājs pievieno visu gabalu vai neko: ja vietas nepietiek, gabals tiek
+ * izmests un saskaitīts, nevis gaidīts, kamēr klients nolasa. Kad vieta
+ * atkal ir, pirms nākamā gabala tiek ielikts kopsavilkums par izlaisto.
+ * Lasītājs paņem nepārtrauktu apgabalu (output_ring_peek) un pēc sūtīšanas
+ * atbrīvo tik, cik izdevās nosūtīt (output_ring_consume).
+ *
+ * Atmiņu (piem., PSRAM) nodrošina izsaucējs; sinhronizācija - arī.
+ */
+
+#define OUTPUT_RING_SUMMARY_MAX 48   // "\r\n[... izlaisti N baiti]\r\n" rezerve
+
+typedef struct {
+    uint8_t* data;
+    uint32_t capacity;
+    uint32_t head;             // Pirmais nenosūtītais baits
+    uint32_t count;
+    uint32_t pendingDropped;   // Izmesti kopš pēdējā kopsavilkuma
+    uint32_t droppedBytes;     // Kopā
+    uint32_t droppedWrites;
+} output_ring_t;
+
+void output_ring_init(output_ring_t* ring, uint8_t* storage, uint32_t capacity);
+void output_ring_clear(output_ring_t* ring);
+
+// Pievieno visu vai neko; atgriež pievienoto baitu skaitu (size vai 0)
+uint32_t output_ring_write(output_ring_t* ring, const uint8_t* data, uint32_t size);
+
+// Vai output_ring_write() šo gabalu pieņemtu (ieskaitot kopsavilkuma rezervi).
+// Rakstītājs, kas grib gaidīt, nevis zaudēt, pārbauda un raksta zem vienas slēdzenes
+bool output_ring_fits(const output_ring_t* ring, uint32_t size);
+
+// Nepārtraukts nenosūtītais apgabals no head (0 = tukšs)
+uint32_t output_ring_peek(const output_ring_t* ring, const uint8_t** data);
+void output_ring_consume(output_ring_t* ring, uint32_t size);
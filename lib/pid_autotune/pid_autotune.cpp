@@ -0,0 +1,262 @@
+#include "pid_autotune.h"
+#include <math.h>
+#include <string.h>
+
+static const char* const STATE_LABELS[PID_AUTOTUNE_STATE_COUNT] = {
+    "IDLE",
+    "SETTLE",
+    "STEP",
+    "DONE",
+    "FAILED",
+};
+
+static const char* const RESULT_LABELS[PID_AUTOTUNE_RESULT_COUNT] = {
+    "OK",
+    "NOT_STEADY",
+    "TIMEOUT",
+    "LIMIT",
+    "NO_RESPONSE",
+    "BAD_MODEL",
+    "ABORTED",
+};
+
+pid_autotune_config_t pid_autotune_default_config(float outMin, float outMax) {
+    pid_autotune_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.stepPct = 20.0f;
+    config.outMin = outMin;
+    config.outMax = outMax;
+    config.samplePeriodMs = 10000;
+    config.settleMs = 300000;           // 5 min bāzes logs
+    config.maxSettleMs = 1800000;       // 30 min
+    config.minStepMs = 600000;          // 10 min
+    config.maxStepMs = 3600000;         // 60 min
+    config.settledWindowMs = 300000;
+    config.steadySlopeCPerMin = 0.1f;
+    config.minResponseC = 1.0f;
+    config.minTempC = 40.0f;
+    config.maxTempC = 85.0f;
+    config.lambdaFactor = 1.0f;         // SIMC ieteikums: τc = L
+    return config;
+}
+
+void pid_autotune_start(pid_autotune_t* tune, const pid_autotune_config_t* config,
+                        unsigned long nowMs, float u0) {
+    memset(tune, 0, sizeof(*tune));
+    tune->config = *config;
+    tune->state = PID_AUTOTUNE_SETTLE;
+    tune->result = PID_AUTOTUNE_OK;
+    tune->u0 = u0;
+    tune->u1 = u0;
+    tune->startMs = nowMs;
+    tune->phaseStartMs = nowMs;
+    // Pirmais rādījums uzreiz
+    tune->lastSampleMs = nowMs - config->samplePeriodMs;
+}
+
+void pid_autotune_abort(pid_autotune_t* tune) {
+    if (pid_autotune_running(tune)) {
+        tune->state = PID_AUTOTUNE_FAILED;
+        tune->result = PID_AUTOTUNE_ERR_ABORTED;
+    }
+}
+
+bool pid_autotune_running(const pid_autotune_t* tune) {
+    return tune->state == PID_AUTOTUNE_SETTLE || tune->state == PID_AUTOTUNE_STEP;
+}
+
+static void fail(pid_autotune_t* tune, pid_autotune_result_t result) {
+    tune->state = PID_AUTOTUNE_FAILED;
+    tune->result = result;
+}
+
+// Mazāko kvadrātu taisne pār rādījumiem [from, to): vidējais (°C) un slīpums (°C/s)
+static void fit_line(const pid_autotune_t* tune, uint16_t from, uint16_t to,
+                     float* meanC, float* slopeCPerS) {
+    const float periodS = tune->config.samplePeriodMs / 1000.0f;
+    const float n = (float)(to - from);
+    float sumY = 0.0f;
+    for (uint16_t i = from; i < to; i++) {
+        sumY += tune->samples[i];
+    }
+    const float meanY = sumY / n;
+    const float meanX = (n - 1.0f) / 2.0f;
+    float sxy = 0.0f;
+    float sxx = 0.0f;
+    for (uint16_t i = from; i < to; i++) {
+        const float dx = (float)(i - from) - meanX;
+        sxy += dx * (tune->samples[i] - meanY);
+        sxx += dx * dx;
+    }
+    *meanC = meanY / PID_AUTOTUNE_SCALE;
+    *slopeCPerS = sxx > 0.0f ? sxy / sxx / PID_AUTOTUNE_SCALE / periodS : 0.0f;
+}
+
+// Rādījums ar atņemtu bāzes līnijas drift (°C, 0 pirms lēciena)
+static float compensated(const pid_autotune_t* tune, uint16_t index) {
+    const float periodS = tune->config.samplePeriodMs / 1000.0f;
+    const float baselineMid = (tune->stepIndex - 1) / 2.0f;
+    const float baseline = tune->baselineC + tune->baselineSlopeCPerS * (index - baselineMid) * periodS;
+    return tune->samples[index] / (float)PID_AUTOTUNE_SCALE - baseline;
+}
+
+// Laiks kopš lēciena (s), kad normētā atbilde pirmoreiz sasniedz fraction
+static bool crossing_time(const pid_autotune_t* tune, float deltaC, float fraction, float* timeS) {
+    const float periodS = tune->config.samplePeriodMs / 1000.0f;
+    float previous = 0.0f;   // Lēciena brīdī (pēdējais bāzes rādījums)
+    for (uint16_t i = tune->stepIndex; i < tune->sampleCount; i++) {
+        const float r = compensated(tune, i) / deltaC;
+        if (r >= fraction) {
+            const float frac = r > previous ? (fraction - previous) / (r - previous) : 1.0f;
+            *timeS = ((float)(i - tune->stepIndex) + frac) * periodS;
+            return true;
+        }
+        previous = r;
+    }
+    return false;
+}
+
+static void identify(pid_autotune_t* tune, uint16_t settledSamples) {
+    const pid_autotune_config_t* c = &tune->config;
+    float deltaC = 0.0f;
+    for (uint16_t i = tune->sampleCount - settledSamples; i < tune->sampleCount; i++) {
+        deltaC += compensated(tune, i);
+    }
+    deltaC /= settledSamples;
+
+    if (fabsf(deltaC) < c->minResponseC) {
+        fail(tune, PID_AUTOTUNE_ERR_NO_RESPONSE);
+        return;
+    }
+
+    const float deltaU = tune->u1 - tune->u0;
+    const float gain = deltaC / deltaU;
+    float t28 = 0.0f;
+    float t63 = 0.0f;
+    // Vairāk gaisa = siltāk; pretēja zīme nozīmē, ka eksperimentu izjauca malka
+    if (gain <= 0.0f || !crossing_time(tune, deltaC, 0.283f, &t28) ||
+        !crossing_time(tune, deltaC, 0.632f, &t63)) {
+        fail(tune, PID_AUTOTUNE_ERR_BAD_MODEL);
+        return;
+    }
+
+    const float timeConstant = 1.5f * (t63 - t28);
+    if (timeConstant <= 0.0f) {
+        fail(tune, PID_AUTOTUNE_ERR_BAD_MODEL);
+        return;
+    }
+    // Nolasīšana pati par sevi ir puse perioda aiztures
+    float deadTime = t63 - timeConstant;
+    const float minDeadTime = c->samplePeriodMs / 2000.0f;
+    if (deadTime < minDeadTime) {
+        deadTime = minDeadTime;
+    }
+
+    tune->model.gainCPerPct = gain;
+    tune->model.timeConstantS = timeConstant;
+    tune->model.deadTimeS = deadTime;
+    tune->model.deltaC = deltaC;
+    tune->model.driftCPerMin = tune->baselineSlopeCPerS * 60.0f;
+
+    const float closedLoop = c->lambdaFactor * deadTime + deadTime;
+    tune->kp = timeConstant / (gain * closedLoop);
+    tune->tauI = fminf(timeConstant, 4.0f * closedLoop);
+
+    tune->state = PID_AUTOTUNE_DONE;
+    tune->result = PID_AUTOTUNE_OK;
+}
+
+static void update_settle(pid_autotune_t* tune, unsigned long nowMs) {
+    const pid_autotune_config_t* c = &tune->config;
+    const uint16_t window = (uint16_t)(c->settleMs / c->samplePeriodMs);
+    if (tune->sampleCount < window) {
+        return;
+    }
+
+    float meanC = 0.0f;
+    float slopeCPerS = 0.0f;
+    fit_line(tune, 0, tune->sampleCount, &meanC, &slopeCPerS);
+    if (fabsf(slopeCPerS * 60.0f) <= c->steadySlopeCPerMin) {
+        tune->baselineC = meanC;
+        tune->baselineSlopeCPerS = slopeCPerS;
+        tune->stepIndex = tune->sampleCount;
+        // Uz augšu, ja ir vieta; citādi uz leju
+        tune->u1 = tune->u0 + c->stepPct <= c->outMax ? tune->u0 + c->stepPct : tune->u0 - c->stepPct;
+        if (tune->u1 < c->outMin) {
+            tune->u1 = c->outMin;
+        }
+        if (fabsf(tune->u1 - tune->u0) < c->stepPct / 2.0f) {
+            fail(tune, PID_AUTOTUNE_ERR_BAD_MODEL);
+            return;
+        }
+        tune->state = PID_AUTOTUNE_STEP;
+        tune->phaseStartMs = nowMs;
+        return;
+    }
+
+    if (nowMs - tune->startMs >= c->maxSettleMs) {
+        fail(tune, PID_AUTOTUNE_ERR_NOT_STEADY);
+        return;
+    }
+    // Slīdošs logs: vecākais rādījums ārā
+    memmove(&tune->samples[0], &tune->samples[1], (tune->sampleCount - 1) * sizeof(tune->samples[0]));
+    tune->sampleCount--;
+}
+
+static void update_step(pid_autotune_t* tune, unsigned long nowMs) {
+    const pid_autotune_config_t* c = &tune->config;
+    const unsigned long elapsedMs = nowMs - tune->phaseStartMs;
+    const uint16_t settledSamples = (uint16_t)(c->settledWindowMs / c->samplePeriodMs);
+    const bool full = tune->sampleCount >= PID_AUTOTUNE_MAX_SAMPLES;
+
+    if (elapsedMs >= c->minStepMs && tune->sampleCount - tune->stepIndex >= settledSamples) {
+        // Nostājusies: pēdējā loga slīpums pēc drift atņemšanas ir mazs
+        float meanC = 0.0f;
+        float slopeCPerS = 0.0f;
+        fit_line(tune, tune->sampleCount - settledSamples, tune->sampleCount, &meanC, &slopeCPerS);
+        if (fabsf((slopeCPerS - tune->baselineSlopeCPerS) * 60.0f) <= c->steadySlopeCPerMin) {
+            identify(tune, settledSamples);
+            return;
+        }
+    }
+
+    if (elapsedMs >= c->maxStepMs || full) {
+        fail(tune, PID_AUTOTUNE_ERR_TIMEOUT);
+    }
+}
+
+float pid_autotune_update(pid_autotune_t* tune, unsigned long nowMs, float temperatureC) {
+    const pid_autotune_config_t* c = &tune->config;
+    if (!pid_autotune_running(tune)) {
+        return tune->u0;
+    }
+
+    if (temperatureC < c->minTempC || temperatureC > c->maxTempC) {
+        fail(tune, PID_AUTOTUNE_ERR_LIMIT);
+        return tune->u0;
+    }
+
+    if (nowMs - tune->lastSampleMs >= c->samplePeriodMs && tune->sampleCount < PID_AUTOTUNE_MAX_SAMPLES) {
+        tune->lastSampleMs += c->samplePeriodMs;
+        tune->samples[tune->sampleCount++] = (int16_t)lroundf(temperatureC * PID_AUTOTUNE_SCALE);
+
+        if (tune->state == PID_AUTOTUNE_SETTLE) {
+            update_settle(tune, nowMs);
+        } else {
+            update_step(tune, nowMs);
+        }
+    }
+
+    if (tune->state == PID_AUTOTUNE_STEP) {
+        return tune->u1;
+    }
+    return tune->u0;
+}
+
+const char* pid_autotune_state_label(pid_autotune_state_t state) {
+    return state < PID_AUTOTUNE_STATE_COUNT ? STATE_LABELS[state] : "?";
+}
+
+const char* pid_autotune_result_label(pid_autotune_result_t result) {
+    return result < PID_AUTOTUNE_RESULT_COUNT ? RESULT_LABELS[result] : "?";
+}
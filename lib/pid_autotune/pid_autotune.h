@@ -0,0 +1,113 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * PID Autotune - krāsns modeļa identifikācija ar damper lēciena eksperimentu
+ *
+ *   SETTLE --bāzes logs mierīgs--> STEP --atbilde nostājusies--> DONE
+ *      |  (|slīpums| < steadySlope)     (vai FAILED)
+ *      +-- maxSettleMs bez miera --> FAILED
+ *
+ * SETTLE tur damper sākuma pozīcijā u0 un gaida settleMs garu logu, kurā
+ * temperatūras slīpums ir mazs. Šī loga vidējais un slīpums ir bāzes līnija:
+ * malka deg nost, tāpēc krāsns nekad nav pilnīgi stacionāra, un drift tiek
+ * atņemts no atbildes. STEP pārliek damper uz u1 = u0 ± stepPct un ieraksta
+ * atbildi, līdz tā nostājas vai iestājas maxStepMs.
+ *
+ * No atbildes tiek noteikts pirmās kārtas modelis ar aizturi (FOPDT)
+ *   G(s) = K e^(-Ls) / (T s + 1)
+ * ar divu punktu metodi (28.3 % un 63.2 % no galīgās izmaiņas):
+ *   T = 1.5 (t63 - t28),  L = t63 - T,  K = Δy / Δu.
+ * Pastiprinājumi pēc SIMC (Skogestad) PI noteikumiem, τc = lambdaFactor · L:
+ *   kP = T / (K (τc + L)),  tauI = min(T, 4 (τc + L)).
+ *
+ * Rādījumi tiek glabāti °C × 16 ik pēc samplePeriodMs. Bez Arduino
+ * atkarībām - to pašu kodu darbina host simulācija (src/native/sim_main.cpp).
+ */
+
+#define PID_AUTOTUNE_MAX_SAMPLES 420   // 70 min pa 10 s
+#define PID_AUTOTUNE_SCALE       16    // °C × 16
+
+typedef enum : uint8_t {
+    PID_AUTOTUNE_IDLE = 0,
+    PID_AUTOTUNE_SETTLE,       // Gaida mierīgu bāzes līniju
+    PID_AUTOTUNE_STEP,         // Ieraksta atbildi uz lēcienu
+    PID_AUTOTUNE_DONE,
+    PID_AUTOTUNE_FAILED,
+    PID_AUTOTUNE_STATE_COUNT
+} pid_autotune_state_t;
+
+typedef enum : uint8_t {
+    PID_AUTOTUNE_OK = 0,
+    PID_AUTOTUNE_ERR_NOT_STEADY,    // Bāzes līnija nenomierinājās
+    PID_AUTOTUNE_ERR_TIMEOUT,       // Atbilde nenostājās maxStepMs laikā
+    PID_AUTOTUNE_ERR_LIMIT,         // Temperatūra izgāja ārpus minTempC..maxTempC
+    PID_AUTOTUNE_ERR_NO_RESPONSE,   // Izmaiņa mazāka par minResponseC
+    PID_AUTOTUNE_ERR_BAD_MODEL,     // Nepareiza zīme vai nereāli laiki
+    PID_AUTOTUNE_ERR_ABORTED,
+    PID_AUTOTUNE_RESULT_COUNT
+} pid_autotune_result_t;
+
+typedef struct {
+    float stepPct;                  // Lēciena lielums (damper %)
+    float outMin;                   // Damper robežas
+    float outMax;
+    uint32_t samplePeriodMs;
+    uint32_t settleMs;              // Bāzes loga garums
+    uint32_t maxSettleMs;           // Cik ilgi gaidīt mierīgu bāzi
+    uint32_t minStepMs;             // Atbildi nevērtē ātrāk
+    uint32_t maxStepMs;
+    uint32_t settledWindowMs;       // Logs, kurā atbildei jābūt mierīgai
+    float steadySlopeCPerMin;       // |slīpums| zem šī - mierīgs
+    float minResponseC;
+    float minTempC;                 // Ārpus šīm robežām eksperiments tiek pārtraukts
+    float maxTempC;
+    float lambdaFactor;             // τc = lambdaFactor · L
+} pid_autotune_config_t;
+
+typedef struct {
+    float gainCPerPct;              // K (°C uz damper %)
+    float timeConstantS;            // T
+    float deadTimeS;                // L
+    float deltaC;                   // Galīgā izmaiņa pēc drift atņemšanas
+    float driftCPerMin;             // Bāzes līnijas slīpums
+} pid_autotune_model_t;
+
+typedef struct {
+    pid_autotune_config_t config;
+    pid_autotune_state_t state;
+    pid_autotune_result_t result;
+
+    float u0;                       // Sākuma damper
+    float u1;                       // Damper lēciena laikā
+    unsigned long startMs;
+    unsigned long phaseStartMs;
+    unsigned long lastSampleMs;
+
+    int16_t samples[PID_AUTOTUNE_MAX_SAMPLES];
+    uint16_t sampleCount;
+    uint16_t stepIndex;             // Pirmais rādījums pēc lēciena
+
+    float baselineC;                // Bāzes loga vidējais
+    float baselineSlopeCPerS;
+
+    pid_autotune_model_t model;
+    float kp;                       // Aprēķinātie pastiprinājumi (firmware formā)
+    float tauI;
+} pid_autotune_t;
+
+pid_autotune_config_t pid_autotune_default_config(float outMin, float outMax);
+
+// Sāk eksperimentu no damper pozīcijas u0
+void pid_autotune_start(pid_autotune_t* tune, const pid_autotune_config_t* config,
+                        unsigned long nowMs, float u0);
+
+// Jauns rādījums; atgriež damper pozīciju, ko turēt. Pēc DONE/FAILED - u0.
+float pid_autotune_update(pid_autotune_t* tune, unsigned long nowMs, float temperatureC);
+
+void pid_autotune_abort(pid_autotune_t* tune);
+
+bool pid_autotune_running(const pid_autotune_t* tune);
+
+const char* pid_autotune_state_label(pid_autotune_state_t state);
+const char* pid_autotune_result_label(pid_autotune_result_t result);
@@ -0,0 +1,87 @@
+#include "pid_controller.h"
+
+PidController::PidController(float outMin, float outMax, float derivativeFilterS)
+    : outMin(outMin), outMax(outMax), derivativeFilterS(derivativeFilterS) {
+}
+
+void PidController::setTunings(float kp, float tauI_s, float tauD_s) {
+    // I komponente tiek glabāta jau pareizināta ar ki, tāpēc, mainot ki,
+    // izeja nelec (svarīgi, ja kP maina no Telegram vai iestatījumu ekrāna)
+    this->kp = kp;
+    this->ki = tauI_s > 0.0f ? kp / tauI_s : 0.0f;
+    this->kd = tauD_s > 0.0f ? kp * tauD_s : 0.0f;
+}
+
+void PidController::setOutputLimits(float outMin, float outMax) {
+    if (outMin >= outMax) {
+        return;
+    }
+    this->outMin = outMin;
+    this->outMax = outMax;
+    iTerm = clampOutput(iTerm);
+    output = clampOutput(output);
+}
+
+float PidController::clampOutput(float value) const {
+    if (value < outMin) return outMin;
+    if (value > outMax) return outMax;
+    return value;
+}
+
+float PidController::update(float setpoint, float measurement, float dt_s) {
+    error = setpoint - measurement;
+
+    if (!initialized || dt_s <= 0.0f) {
+        // Pirmais solis (vai nederīgs dt): nav no kā rēķināt atvasinājumu
+        lastMeasurement = measurement;
+        derivative = 0.0f;
+        initialized = true;
+        dt_s = 0.0f;
+    }
+
+    // Atvasinājums no mērījuma ar pirmās kārtas filtru
+    if (dt_s > 0.0f) {
+        const float raw = -(measurement - lastMeasurement) / dt_s;
+        const float alpha = dt_s / (derivativeFilterS + dt_s);
+        derivative += alpha * (raw - derivative);
+    }
+    lastMeasurement = measurement;
+
+    pTerm = kp * error;
+    dTerm = kd * derivative;
+
+    // Anti-windup: integrējam tikai, ja izeja nav piesātināta kļūdas virzienā
+    const float candidateI = iTerm + ki * error * dt_s;
+    const float unsaturated = pTerm + candidateI + dTerm;
+    const bool windingUp = (unsaturated > outMax && error > 0.0f) ||
+                           (unsaturated < outMin && error < 0.0f);
+    if (!windingUp) {
+        iTerm = clampOutput(candidateI);
+    }
+
+    output = clampOutput(pTerm + iTerm + dTerm);
+    return output;
+}
+
+void PidController::track(float setpoint, float measurement, float output) {
+    error = setpoint - measurement;
+    lastMeasurement = measurement;
+    derivative = 0.0f;
+    initialized = true;
+
+    // Integrālis tiek iestatīts tā, lai nākamais update() sāktu no output
+    pTerm = kp * error;
+    dTerm = 0.0f;
+    iTerm = clampOutput(output - pTerm);
+    this->output = clampOutput(output);
+}
+
+void PidController::reset() {
+    iTerm = 0.0f;
+    pTerm = 0.0f;
+    dTerm = 0.0f;
+    error = 0.0f;
+    derivative = 0.0f;
+    output = 0.0f;
+    initialized = false;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+/**
+ * PID regulators ar fiksētu izsaukšanas periodu un reālo dt
+ *
+ * - Integrālis tiek reizināts ar faktisko dt, tāpēc reakcija nav atkarīga no
+ *   tā, cik bieži sensors nolasa vai cik bieži mainās tā rādījums.
+ * - Atvasinājums tiek rēķināts no mērījuma (nevis kļūdas), lai mērķa maiņa
+ *   nedod "derivative kick", un tiek filtrēts ar pirmās kārtas filtru, jo
+ *   DS18B20 rādījums mainās pakāpienveidīgi.
+ * - Anti-windup: integrālis netiek palielināts, kamēr izeja ir piesātināta
+ *   kļūdas virzienā, un I komponente nekad neiziet ārpus izejas robežām.
+ * - Bumpless pāreja: kamēr izeju nosaka kaut kas cits (manuālais režīms,
+ *   min/max robežas), track() pielāgo integrāli tā, lai atgriežoties
+ *   automātiskajā režīmā izeja turpinātos no tās pašas vērtības.
+ *
+ * Pastiprinājumi ir standarta (ideālā) formā:
+ *   u = kP * (e + 1/tauI * ∫e dt + tauD * d(-y)/dt)
+ * kur tauI un tauD ir sekundēs.
+ */
+class PidController {
+public:
+    PidController(float outMin = 0.0f, float outMax = 100.0f, float derivativeFilterS = 30.0f);
+
+    void setTunings(float kp, float tauI_s, float tauD_s);
+    void setOutputLimits(float outMin, float outMax);
+    void setDerivativeFilter(float tau_s) { derivativeFilterS = tau_s; }
+
+    // Viens regulatora solis. dt_s ir faktiskais laiks kopš iepriekšējā soļa.
+    float update(float setpoint, float measurement, float dt_s);
+
+    // Izeju nosaka kas cits - sekojam tai, lai pāreja atpakaļ būtu bez lēciena
+    void track(float setpoint, float measurement, float output);
+
+    // Aizmirst visu vēsturi (piem., pēc ilgas pauzes)
+    void reset();
+
+    float getOutput() const { return output; }
+    float getPTerm() const { return pTerm; }
+    float getITerm() const { return iTerm; }
+    float getDTerm() const { return dTerm; }
+    float getError() const { return error; }
+    float getDerivative() const { return derivative; }  // Filtrēts -dy/dt (°C/s)
+
+private:
+    float clampOutput(float value) const;
+
+    float kp = 0.0f;
+    float ki = 0.0f;   // kp / tauI (1/s)
+    float kd = 0.0f;   // kp * tauD (s)
+    float outMin;
+    float outMax;
+    float derivativeFilterS;
+
+    float iTerm = 0.0f;        // Glabājam jau ar ki pareizinātu integrāli
+    float pTerm = 0.0f;
+    float dTerm = 0.0f;
+    float error = 0.0f;
+    float derivative = 0.0f;
+    float lastMeasurement = 0.0f;
+    float output = 0.0f;
+    bool initialized = false;
+};
@@ -0,0 +1,201 @@
+#include "recorder.h"
+#include <esp_partition.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <time.h>
+#include "temperature.h"
+
+TaskHandle_t recorderTaskHandle = NULL;
+bool recorderEnabled = true;
+
+typedef struct {
+    uint16_t length;
+    uint8_t data[TRACE_BLOCK_MAX];
+} recorder_record_t;
+
+// block un outgoing pieder ControlTask; flashRing un incoming - tam, kurš tur flashLock
+static trace_block_t block;
+static recorder_record_t outgoing;
+static recorder_record_t incoming;
+static QueueHandle_t blockQueue = NULL;
+static SemaphoreHandle_t flashLock = NULL;
+static flash_ring_t flashRing;
+static bool flashReady = false;
+static recorder_stats_t stats = {0};
+static uint32_t writtenSamples = 0;   // Paraugi ierakstītajos blokos (B/paraugs novērtējumam)
+
+static bool partitionRead(void* ctx, uint32_t offset, void* data, uint32_t size) {
+    return esp_partition_read((const esp_partition_t*)ctx, offset, data, size) == ESP_OK;
+}
+
+static bool partitionWrite(void* ctx, uint32_t offset, const void* data, uint32_t size) {
+    return esp_partition_write((const esp_partition_t*)ctx, offset, data, size) == ESP_OK;
+}
+
+static bool partitionErase(void* ctx, uint32_t offset, uint32_t size) {
+    return esp_partition_erase_range((const esp_partition_t*)ctx, offset, size) == ESP_OK;
+}
+
+static void RecTask(void* parameter) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        recorderTaskStep();
+    }
+}
+
+void recorderBegin() {
+    if (flashLock != NULL) {
+        return;
+    }
+    flashLock = xSemaphoreCreateMutex();
+    blockQueue = xQueueCreate(RECORDER_QUEUE_LENGTH, sizeof(recorder_record_t));
+
+    // Trase aizņem "spiffs" nodalījuma atlikumu aiz žurnāla
+    const esp_partition_t* partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, "spiffs");
+    if (blockQueue != NULL && partition != NULL &&
+        partition->size >= RECORDER_FLASH_OFFSET + 2 * FLASH_RING_SECTOR_SIZE) {
+        const flash_ring_io_t io = {partitionRead, partitionWrite, partitionErase, (void*)partition};
+        const uint16_t sectors = (uint16_t)((partition->size - RECORDER_FLASH_OFFSET) / FLASH_RING_SECTOR_SIZE);
+        flash_ring_init(&flashRing, &io, RECORDER_FLASH_OFFSET, sectors, TRACE_FLASH_MAGIC);
+        flashReady = flash_ring_mount(&flashRing);
+    }
+    if (!flashReady) {
+        LOG_WARN("rec", "Trases ierakstitajs nav pieejams");
+        return;
+    }
+
+    xTaskCreatePinnedToCore(
+        RecTask,               // Uzdevuma funkcija
+        "RecTask",             // Uzdevuma nosaukums
+        2048,                  // Steka izmērs (bloks ir statisks)
+        NULL,                  // Parametri (nav)
+        1,                     // Prioritāte (zema - flash rakstīšana var pagaidīt)
+        &recorderTaskHandle,   // Uzdevuma rokturis
+        0                      // Kodola numurs (WiFi kodols, prom no ControlTask)
+    );
+    LOG_INFO("rec", "Trase: %u/%u sektori", flashRing.usedSectors, flashRing.sectorCount);
+}
+
+// Pabeigto bloku nodod RecTask; ja rinda pilna, bloks tiek izmests (ControlTask negaida)
+static void queueBlock() {
+    if (block.length == 0) {
+        return;
+    }
+    outgoing.length = block.length;
+    memcpy(outgoing.data, block.data, block.length);
+    block.length = 0;
+    if (xQueueSend(blockQueue, &outgoing, 0) != pdTRUE) {
+        stats.droppedBlocks++;
+        return;
+    }
+    if (recorderTaskHandle != NULL) {
+        xTaskNotifyGive(recorderTaskHandle);
+    }
+}
+
+// Bloka pirmā parauga reālais laiks (0 līdz NTP)
+static uint32_t sampleUnixTime(const trace_sample_t* sample) {
+    if (!loggerTimeValid()) {
+        return 0;
+    }
+    return (uint32_t)time(NULL) - (millis() - sample->timeMs) / 1000;
+}
+
+void recorderAddSample(const trace_sample_t* sample) {
+    if (!flashReady) {
+        return;
+    }
+    if (!recorderEnabled) {
+        queueBlock();
+        return;
+    }
+    if (block.length == 0) {
+        trace_block_begin(&block, sampleUnixTime(sample));
+    }
+    if (!trace_block_add(&block, sample)) {
+        queueBlock();
+        trace_block_begin(&block, sampleUnixTime(sample));
+        trace_block_add(&block, sample);
+    }
+    stats.samples++;
+}
+
+void recorderFlush() {
+    if (!flashReady) {
+        return;
+    }
+    queueBlock();
+    recorderTaskStep();
+}
+
+void recorderTaskStep() {
+    if (!flashReady) {
+        return;
+    }
+    xSemaphoreTake(flashLock, portMAX_DELAY);
+    while (xQueueReceive(blockQueue, &incoming, 0) == pdTRUE) {
+        if (flash_ring_append(&flashRing, incoming.data, incoming.length)) {
+            stats.blocks++;
+            writtenSamples += trace_block_count(incoming.data, incoming.length);
+        } else {
+            stats.droppedBlocks++;
+        }
+    }
+    xSemaphoreGive(flashLock);
+}
+
+recorder_stats_t recorderGetStats() {
+    return stats;
+}
+
+void recorderPrintStatus(Print &out) {
+    if (!flashReady) {
+        out.println("Trases ierakstitajs nav pieejams.");
+        return;
+    }
+    out.printf("Trase: %s, %u/%u sektori, kops starta %lu paraugi, %lu bloki (%lu B), izmesti %lu, %lu kludas\r\n",
+               recorderEnabled ? "ieslegta" : "izslegta", flashRing.usedSectors, flashRing.sectorCount,
+               (unsigned long)stats.samples, (unsigned long)stats.blocks,
+               (unsigned long)flashRing.bytesWritten, (unsigned long)stats.droppedBlocks,
+               (unsigned long)flashRing.errors);
+    if (writtenSamples > 0) {
+        // Cik ilgu kurināšanu apgabals ietilpina ar pašreizējo saspiešanu
+        const float bytesPerSample = flashRing.bytesWritten / (float)writtenSamples;
+        const float capacityS = (float)flashRing.sectorCount * (FLASH_RING_SECTOR_SIZE - FLASH_RING_HEADER_SIZE) /
+                                bytesPerSample * (tempReadIntervalMs / 1000.0f);
+        out.printf("  %.1f B/paraugs, ietilpiba ~%.0f h pie %lu ms intervala\r\n",
+                   bytesPerSample, capacityS / 3600.0f, tempReadIntervalMs);
+    }
+}
+
+bool recorderErase() {
+    if (!flashReady) {
+        return false;
+    }
+    xSemaphoreTake(flashLock, portMAX_DELAY);
+    const bool ok = flash_ring_erase_all(&flashRing);
+    writtenSamples = 0;
+    xSemaphoreGive(flashLock);
+    return ok;
+}
+
+bool recorderDumpBegin(flash_ring_cursor_t* cursor, uint16_t sectorsBack) {
+    if (!flashReady) {
+        return false;
+    }
+    xSemaphoreTake(flashLock, portMAX_DELAY);
+    flash_ring_cursor_init(&flashRing, cursor, sectorsBack);
+    xSemaphoreGive(flashLock);
+    return true;
+}
+
+uint16_t recorderDumpNext(flash_ring_cursor_t* cursor, uint8_t* data, uint16_t size) {
+    if (!flashReady) {
+        return 0;
+    }
+    xSemaphoreTake(flashLock, portMAX_DELAY);
+    const uint16_t length = flash_ring_next(&flashRing, cursor, data, size);
+    xSemaphoreGive(flashLock);
+    return length;
+}
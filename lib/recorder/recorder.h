@@ -0,0 +1,55 @@
+#pragma once
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "flash_ring.h"
+#include "logger.h"
+#include "trace_codec.h"
+
+/**
+ * Recorder - regulatora trase flash atmiņā (temperatūra, damper, errP/I/D,
+ * režīms) katram nolasījumam (tempReadIntervalMs)
+ *
+ * ControlTask pēc katra soļa ar jaunu rādījumu pievieno paraugu RAM blokam
+ * (trace_codec.h, ~6 B/paraugs). Pilnu bloku (~1 KB, ~10 min) paņem RecTask
+ * (zema prioritāte) un ieraksta "spiffs" nodalījumā aiz flash žurnāla
+ * (flash_ring, atsevišķs apgabals ar savu magic). 1.9 MB pietiek vairākām
+ * nedēļām kurināšanas; vecākie sektori tiek pārrakstīti pa apli.
+ *
+ * Pirms deep sleep nepabeigtais bloks tiek ierakstīts uzreiz
+ * (recorderFlush()); strāvas pārrāvumā pazūd tikai tas.
+ * Nolasīšana: telnet "rec dump" (hex rindas) vai esptool read_flash, pēc
+ * tam host rīks native_trace -> CSV.
+ */
+
+#define RECORDER_FLASH_OFFSET ((uint32_t)LOG_FLASH_SECTORS * FLASH_RING_SECTOR_SIZE)   // Aiz žurnāla
+#define RECORDER_QUEUE_LENGTH 2             // Pabeigti bloki, ko RecTask vēl nav ierakstījis
+
+typedef struct {
+    uint32_t samples;         // Kopš starta
+    uint32_t blocks;          // Ierakstīti flash
+    uint32_t droppedBlocks;   // Rinda bija pilna vai flash kļūda
+} recorder_stats_t;
+
+extern TaskHandle_t recorderTaskHandle;
+extern bool recorderEnabled;   // Telnet "rec on|off" (NVS)
+
+// Montē apgabalu un palaiž RecTask. Izsaukt pēc loggerBegin()
+void recorderBegin();
+
+// ControlTask: viens paraugs pēc soļa ar jaunu rādījumu
+void recorderAddSample(const trace_sample_t* sample);
+
+// Ieraksta nepabeigto bloku (pirms deep sleep, no ControlTask)
+void recorderFlush();
+
+// Viena RecTask iterācija (host harness izsauc tieši)
+void recorderTaskStep();
+
+recorder_stats_t recorderGetStats();
+void recorderPrintStatus(Print &out);
+bool recorderErase();
+
+// Telnet "rec dump": bloki no vecākā uz jaunāko (sectorsBack kā flash_ring_cursor_init)
+bool recorderDumpBegin(flash_ring_cursor_t* cursor, uint16_t sectorsBack);
+uint16_t recorderDumpNext(flash_ring_cursor_t* cursor, uint8_t* data, uint16_t size);
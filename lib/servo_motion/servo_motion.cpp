@@ -0,0 +1,55 @@
+#include "servo_motion.h"
+#include <math.h>
+#include <string.h>
+
+void servo_motion_init(servo_motion_t* motion, const servo_motion_config_t* config, float position) {
+    memset(motion, 0, sizeof(*motion));
+    motion->config = *config;
+    motion->position = position;
+    motion->target = position;
+}
+
+void servo_motion_configure(servo_motion_t* motion, const servo_motion_config_t* config) {
+    motion->config = *config;
+}
+
+void servo_motion_set_target(servo_motion_t* motion, float target) {
+    motion->target = target;
+    if (fabsf(target - motion->position) >= SERVO_MOTION_EPSILON_PCT || motion->velocity != 0.0f) {
+        motion->moving = true;
+    }
+}
+
+bool servo_motion_update(servo_motion_t* motion, float dtS) {
+    if (!motion->moving || dtS <= 0.0f) {
+        return motion->moving;
+    }
+
+    const float accel = motion->config.accelerationPctPerS2;
+    const float maxVelocity = motion->config.maxVelocityPctPerS;
+    const float distance = motion->target - motion->position;
+    const float direction = distance >= 0.0f ? 1.0f : -1.0f;
+    const float remaining = fabsf(distance);
+
+    // Ātrums mērķa virzienā (negatīvs - vēl brauc prom no tā)
+    float speed = motion->velocity * direction;
+    if (speed < 0.0f) {
+        speed = fminf(speed + accel * dtS, 0.0f);
+    } else {
+        // Ne ātrāk par maxVelocity un par ātrumu, no kura vēl var apstāties
+        speed = fminf(speed + accel * dtS, maxVelocity);
+        speed = fminf(speed, sqrtf(2.0f * accel * remaining));
+    }
+
+    const float step = speed * dtS;
+    if (speed >= 0.0f && (step >= remaining || remaining < SERVO_MOTION_EPSILON_PCT)) {
+        motion->position = motion->target;
+        motion->velocity = 0.0f;
+        motion->moving = false;
+        return false;
+    }
+
+    motion->position += step * direction;
+    motion->velocity = speed * direction;
+    return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Servo Motion - damper kustības plānotājs ar trapecveida ātruma profilu
+ *
+ *   ātrums
+ *     ^     ______________
+ *     |    /              \        paātrinājums ≤ acceleration
+ *     |   /                \       ātrums ≤ maxVelocity
+ *     |__/                  \__>   laiks
+ *
+ * Pozīcija ir float procentos, tāpēc solis katrā update() ir tik liels, cik
+ * pieļauj ātrums un dt, nevis fiksēts 1 %. Bremzēšana sākas, kad
+ * atlikušais ceļš ir vienāds ar apstāšanās ceļu v² / (2a), tāpēc mērķi
+ * var mainīt jebkurā brīdī - kustība turpinās no esošā ātruma (ja jaunais
+ * mērķis ir pretējā virzienā, vispirms nobremzē).
+ *
+ * Bez Arduino atkarībām; laiku un PWM izvadi nodrošina izsaucējs.
+ */
+
+#define SERVO_MOTION_EPSILON_PCT 0.01f   // Tuvāk par šo - mērķī
+
+typedef struct {
+    float maxVelocityPctPerS;
+    float accelerationPctPerS2;
+} servo_motion_config_t;
+
+typedef struct {
+    servo_motion_config_t config;
+    float position;          // %
+    float velocity;          // %/s (zīme = virziens)
+    float target;            // %
+    bool moving;
+} servo_motion_t;
+
+void servo_motion_init(servo_motion_t* motion, const servo_motion_config_t* config, float position);
+void servo_motion_configure(servo_motion_t* motion, const servo_motion_config_t* config);
+
+// Jauns mērķis; drīkst izsaukt arī kustības laikā
+void servo_motion_set_target(servo_motion_t* motion, float target);
+
+// Pavirza kustību par dtS sekundēm. Atgriež true, kamēr vēl kustas
+bool servo_motion_update(servo_motion_t* motion, float dtS);
@@ -4,6 +4,8 @@
 #include "lvgl_display.h"
 #include "display_manager.h"
 #include "settings_screen.h"
+#include "logger.h"
+#include "recorder.h"
 #include <Arduino.h>
 
 // Preferences instance
@@ -17,6 +19,10 @@ const char* KEY_MIN_TEMP = "minTemp";
 const char* KEY_MAX_TEMP = "maxTemp";
 const char* KEY_WARNING_TEMP = "warnTemp";
 const char* KEY_READ_INTERVAL = "readIntrvl";
+const char* KEY_TEMP_RESOLUTION = "tempRes";
+const char* KEY_TEMP_MEDIAN = "tempMedian";
+const char* KEY_TEMP_FILTER_TAU = "tempTauMs";
+const char* KEY_TEMP_CHANNELS = "tempChAddr";
 
 // Display settings
 const char* KEY_BRIGHTNESS = "brightness";
@@ -30,6 +36,9 @@ const char* KEY_ZERO_DAMPER = "zeroDamper";
 const char* KEY_SERVO_ANGLE = "servoAngle";
 const char* KEY_SERVO_OFFSET = "servoOffs";
 const char* KEY_SERVO_STEP = "servoStep";
+const char* KEY_SERVO_DEADBAND = "servoDeadband";
+const char* KEY_SERVO_BACKLASH = "servoBacklash";
+const char* KEY_AIRFLOW_MAP = "airflowMap";
 
 // Control parameters
 const char* KEY_KP = "kP";
@@ -38,6 +47,22 @@ const char* KEY_TAU_D = "tauD";
 const char* KEY_END_TRIGGER = "endTrigger";
 const char* KEY_REFILL_TRIGGER = "refillTrig";
 const char* KEY_LOW_TEMP_TIMEOUT = "lowTmpTout";
+const char* KEY_WOOD_RECENT = "woodRecentS";
+const char* KEY_WOOD_OLDER = "woodOlderS";
+const char* KEY_FF_TREND_GAIN = "ffTrendGain";
+const char* KEY_FF_REFILL_BOOST = "ffRefillBoost";
+const char* KEY_FF_REFILL_TAU = "ffRefillTau";
+const char* KEY_CASCADE_ON = "cascadeOn";
+const char* KEY_ROOM_TARGET = "roomTarget";
+const char* KEY_CASCADE_KP = "cascadeKp";
+const char* KEY_CASCADE_TAU_I = "cascadeTauI";
+const char* KEY_GAIN_SCHEDULE = "gainSched";
+
+// Žurnāla līmeņi katrai izejai (logger.h)
+const char* KEY_LOG_SERIAL = "logSerial";
+const char* KEY_LOG_TELNET = "logTelnet";
+const char* KEY_LOG_FLASH = "logFlash";
+const char* KEY_REC_ENABLED = "recEnabled";   // Trases ierakstītājs (recorder.h)
 
 void initSettingsStorage() {
     // Initialize preferences
@@ -54,6 +79,7 @@ bool saveAllSettings() {
     success &= saveDamperSettings();
     success &= saveControlSettings();
     success &= saveDisplaySettings();
+    success &= saveLogSettings();
     
     // Force preferences write to flash
     preferences.end();
@@ -73,8 +99,12 @@ bool saveTemperatureSettings() {
     preferences.putInt(KEY_MAX_TEMP, maxTemp);
     preferences.putInt(KEY_WARNING_TEMP, warningTemperature);
     preferences.putULong(KEY_READ_INTERVAL, tempReadIntervalMs);
+    preferences.putInt(KEY_TEMP_RESOLUTION, temperatureResolutionBits);
+    preferences.putInt(KEY_TEMP_MEDIAN, temperatureMedianLength);
+    preferences.putULong(KEY_TEMP_FILTER_TAU, temperatureFilterTauMs);
+    preferences.putBytes(KEY_TEMP_CHANNELS, temperatureChannelAddress, sizeof(temperatureChannelAddress));
     
-    Serial.println("Temperature settings saved");
+    LOG_INFO("settings", "Temperature settings saved");
     return true;
 }
 
@@ -86,8 +116,11 @@ bool saveDamperSettings() {
     preferences.putInt(KEY_SERVO_ANGLE, servoAngle);
     preferences.putInt(KEY_SERVO_OFFSET, servoOffset);
     preferences.putInt(KEY_SERVO_STEP, servoStepInterval);
+    preferences.putInt(KEY_SERVO_DEADBAND, servoDeadbandPct);
+    preferences.putFloat(KEY_SERVO_BACKLASH, servoBacklashPct);
+    preferences.putBytes(KEY_AIRFLOW_MAP, &airflowMap, sizeof(airflowMap));
     
-    Serial.println("Damper settings saved");
+    LOG_INFO("settings", "Damper settings saved");
     return true;
 }
 
@@ -99,8 +132,18 @@ bool saveControlSettings() {
     preferences.putFloat(KEY_END_TRIGGER, endTrigger);
     preferences.putFloat(KEY_REFILL_TRIGGER, refillTrigger);
     preferences.putULong(KEY_LOW_TEMP_TIMEOUT, LOW_TEMP_TIMEOUT);
+    preferences.putInt(KEY_WOOD_RECENT, woodFillRecentS);
+    preferences.putInt(KEY_WOOD_OLDER, woodFillOlderS);
+    preferences.putFloat(KEY_FF_TREND_GAIN, ffTrendGain);
+    preferences.putFloat(KEY_FF_REFILL_BOOST, ffRefillBoost);
+    preferences.putFloat(KEY_FF_REFILL_TAU, ffRefillTauS);
+    preferences.putUChar(KEY_CASCADE_ON, cascadeEnabled ? 1 : 0);
+    preferences.putFloat(KEY_ROOM_TARGET, roomTargetC);
+    preferences.putFloat(KEY_CASCADE_KP, cascadeKp);
+    preferences.putFloat(KEY_CASCADE_TAU_I, cascadeTauI);
+    preferences.putBytes(KEY_GAIN_SCHEDULE, &gainSchedule, sizeof(gainSchedule));
     
-    Serial.println("Control settings saved");
+    LOG_INFO("settings", "Control settings saved");
     return true;
 }
 
@@ -113,14 +156,24 @@ bool saveDisplaySettings() {
     preferences.putULong(KEY_TIME_UPDATE, timeUpdateIntervalMs);
     preferences.putULong(KEY_TOUCH_UPDATE, touchUpdateIntervalMs);
     
-    Serial.println("Display settings saved");
+    LOG_INFO("settings", "Display settings saved");
+    return true;
+}
+
+bool saveLogSettings() {
+    preferences.putChar(KEY_LOG_SERIAL, loggerGetLevel(LOG_SINK_SERIAL));
+    preferences.putChar(KEY_LOG_TELNET, loggerGetLevel(LOG_SINK_TELNET));
+    preferences.putChar(KEY_LOG_FLASH, loggerGetLevel(LOG_SINK_FLASH));
+    preferences.putUChar(KEY_REC_ENABLED, recorderEnabled ? 1 : 0);
+
+    LOG_INFO("settings", "Log settings saved");
     return true;
 }
 
 bool loadAllSettings() {
     // Check if we have saved settings
     if (!preferences.isKey(KEY_TARGET_TEMP)) {
-        Serial.println("No saved settings found, using defaults");
+        LOG_INFO("settings", "No saved settings found, using defaults");
         return false;
     }
     
@@ -130,6 +183,13 @@ bool loadAllSettings() {
     maxTemp = preferences.getInt(KEY_MAX_TEMP, maxTemp);
     warningTemperature = preferences.getInt(KEY_WARNING_TEMP, warningTemperature);
     tempReadIntervalMs = preferences.getULong(KEY_READ_INTERVAL, tempReadIntervalMs);
+    temperatureResolutionBits = preferences.getInt(KEY_TEMP_RESOLUTION, temperatureResolutionBits);
+    temperatureMedianLength = preferences.getInt(KEY_TEMP_MEDIAN, temperatureMedianLength);
+    temperatureFilterTauMs = preferences.getULong(KEY_TEMP_FILTER_TAU, temperatureFilterTauMs);
+    // Kanālu skaits var mainīties starp versijām - nolasām tikai pilnu tabulu
+    if (preferences.getBytesLength(KEY_TEMP_CHANNELS) == sizeof(temperatureChannelAddress)) {
+        preferences.getBytes(KEY_TEMP_CHANNELS, temperatureChannelAddress, sizeof(temperatureChannelAddress));
+    }
     
     // Load damper settings
     minDamper = preferences.getInt(KEY_MIN_DAMPER, minDamper);
@@ -138,6 +198,15 @@ bool loadAllSettings() {
     servoAngle = preferences.getInt(KEY_SERVO_ANGLE, servoAngle);
     servoOffset = preferences.getInt(KEY_SERVO_OFFSET, servoOffset);
     servoStepInterval = preferences.getInt(KEY_SERVO_STEP, servoStepInterval);
+    servoDeadbandPct = preferences.getInt(KEY_SERVO_DEADBAND, servoDeadbandPct);
+    servoBacklashPct = preferences.getFloat(KEY_SERVO_BACKLASH, servoBacklashPct);
+    if (preferences.getBytesLength(KEY_AIRFLOW_MAP) == sizeof(airflowMap)) {
+        airflow_map_t loaded;
+        preferences.getBytes(KEY_AIRFLOW_MAP, &loaded, sizeof(loaded));
+        if (airflow_map_valid(&loaded)) {
+            damperControlSetAirflowMap(&loaded);
+        }
+    }
     
     // Load PID and control settings
     kP = preferences.getInt(KEY_KP, kP);
@@ -146,6 +215,23 @@ bool loadAllSettings() {
     endTrigger = preferences.getFloat(KEY_END_TRIGGER, endTrigger);
     refillTrigger = preferences.getFloat(KEY_REFILL_TRIGGER, refillTrigger);
     LOW_TEMP_TIMEOUT = preferences.getULong(KEY_LOW_TEMP_TIMEOUT, LOW_TEMP_TIMEOUT);
+    woodFillRecentS = preferences.getInt(KEY_WOOD_RECENT, woodFillRecentS);
+    woodFillOlderS = preferences.getInt(KEY_WOOD_OLDER, woodFillOlderS);
+    ffTrendGain = preferences.getFloat(KEY_FF_TREND_GAIN, ffTrendGain);
+    ffRefillBoost = preferences.getFloat(KEY_FF_REFILL_BOOST, ffRefillBoost);
+    ffRefillTauS = preferences.getFloat(KEY_FF_REFILL_TAU, ffRefillTauS);
+    cascadeEnabled = preferences.getUChar(KEY_CASCADE_ON, cascadeEnabled ? 1 : 0) != 0;
+    roomTargetC = preferences.getFloat(KEY_ROOM_TARGET, roomTargetC);
+    cascadeKp = preferences.getFloat(KEY_CASCADE_KP, cascadeKp);
+    cascadeTauI = preferences.getFloat(KEY_CASCADE_TAU_I, cascadeTauI);
+    // Tabulu ņemam tikai, ja izmērs sakrīt un punkti ir sakārtoti un robežās
+    if (preferences.getBytesLength(KEY_GAIN_SCHEDULE) == sizeof(gainSchedule)) {
+        gain_schedule_t loaded;
+        preferences.getBytes(KEY_GAIN_SCHEDULE, &loaded, sizeof(loaded));
+        if (gain_schedule_valid(&loaded)) {
+            damperControlSetGainSchedule(&loaded);
+        }
+    }
     
     // Update dependent values
     kI = kP / tauI;
@@ -158,6 +244,12 @@ bool loadAllSettings() {
     timeUpdateIntervalMs = preferences.getULong(KEY_TIME_UPDATE, TIME_UPDATE_INTERVAL_MS);
     touchUpdateIntervalMs = preferences.getULong(KEY_TOUCH_UPDATE, TOUCH_UPDATE_INTERVAL_MS);
     
+    // Load log levels
+    loggerSetLevel(LOG_SINK_SERIAL, preferences.getChar(KEY_LOG_SERIAL, loggerGetLevel(LOG_SINK_SERIAL)));
+    loggerSetLevel(LOG_SINK_TELNET, preferences.getChar(KEY_LOG_TELNET, loggerGetLevel(LOG_SINK_TELNET)));
+    loggerSetLevel(LOG_SINK_FLASH, preferences.getChar(KEY_LOG_FLASH, loggerGetLevel(LOG_SINK_FLASH)));
+    recorderEnabled = preferences.getUChar(KEY_REC_ENABLED, recorderEnabled ? 1 : 0) != 0;
+    
     // Apply the loaded display manager settings
     display_manager_set_update_intervals(
         DEFAULT_TEMP_UPDATE_INTERVAL,
@@ -166,7 +258,7 @@ bool loadAllSettings() {
         touchUpdateIntervalMs
     );
     
-    Serial.println("Settings loaded from storage");
+    LOG_INFO("settings", "Settings loaded from storage");
     printCurrentSettings();
     return true;
 }
@@ -180,20 +272,50 @@ void printCurrentSettings() {
     Serial.print("Max Temp: "); Serial.println(maxTemp);
     Serial.print("Warning Temp: "); Serial.println(warningTemperature);
     Serial.print("Read Interval (ms): "); Serial.println(tempReadIntervalMs);
+    Serial.print("Sensor Resolution (bits): "); Serial.println(temperatureResolutionBits);
+    Serial.print("Sensor Filter (median / tau ms): "); Serial.print(temperatureMedianLength);
+    Serial.print(" / "); Serial.println(temperatureFilterTauMs);
     Serial.println("--- PID & Damper Settings ---");
     Serial.print("kP: "); Serial.println(kP);
     Serial.print("tauI: "); Serial.println(tauI);
     Serial.print("tauD: "); Serial.println(tauD);
     Serial.print("End Trigger: "); Serial.println(endTrigger);
     Serial.print("Refill Trigger: "); Serial.println(refillTrigger);
-    Serial.print("Low Temp Timeout (ms): "); Serial.println(LOW_TEMP_TIMEOUT);
+    Serial.print("Burnout Hold (ms): "); Serial.println(LOW_TEMP_TIMEOUT);
+    Serial.print("Fire Detector Windows (s): "); Serial.print(woodFillRecentS);
+    Serial.print(" / "); Serial.println(woodFillOlderS);
+    Serial.print("Feed-forward (trend / refill boost / tau s): "); Serial.print(ffTrendGain);
+    Serial.print(" / "); Serial.print(ffRefillBoost);
+    Serial.print(" / "); Serial.println(ffRefillTauS);
+    Serial.print("Cascade: "); Serial.print(cascadeEnabled ? "on" : "off");
+    Serial.print(", room "); Serial.print(roomTargetC);
+    Serial.print(" C, kP "); Serial.print(cascadeKp);
+    Serial.print(", tauI "); Serial.println(cascadeTauI);
+    Serial.print("Gain Schedule Points: "); Serial.println(gainSchedule.count);
+    for (uint8_t i = 0; i < gainSchedule.count; i++) {
+        Serial.print("  "); Serial.print(gainSchedule.points[i].tempC);
+        Serial.print(" C: kP x"); Serial.print(gainSchedule.points[i].kpScale);
+        Serial.print(", tauI x"); Serial.println(gainSchedule.points[i].tauIScale);
+    }
     Serial.println("--- Servo Settings ---");
     Serial.print("Servo Angle: "); Serial.println(servoAngle);
     Serial.print("Servo Offset: "); Serial.println(servoOffset);
     Serial.print("Servo Step Interval: "); Serial.println(servoStepInterval);
+    Serial.print("Servo Deadband / Backlash (%): "); Serial.print(servoDeadbandPct);
+    Serial.print(" / "); Serial.println(servoBacklashPct);
+    Serial.print("Airflow Map Points: "); Serial.println(airflowMap.count);
+    for (uint8_t i = 0; i < airflowMap.count; i++) {
+        Serial.print("  "); Serial.print(airflowMap.points[i].airflowPct);
+        Serial.print(" %: "); Serial.print(airflowMap.points[i].micros);
+        Serial.println(" us");
+    }
     Serial.println("--- Display Settings ---");
     Serial.print("Screen Brightness: "); Serial.println(screenBrightness);
     Serial.print("Time Update Interval (ms): "); Serial.println(timeUpdateIntervalMs);
     Serial.print("Touch Update Interval (ms): "); Serial.println(touchUpdateIntervalMs);
+    Serial.print("Log Levels (serial / telnet / flash): "); Serial.print(loggerLevelName(loggerGetLevel(LOG_SINK_SERIAL)));
+    Serial.print(" / "); Serial.print(loggerLevelName(loggerGetLevel(LOG_SINK_TELNET)));
+    Serial.print(" / "); Serial.println(loggerLevelName(loggerGetLevel(LOG_SINK_FLASH)));
+    Serial.print("Trace Recorder: "); Serial.println(recorderEnabled ? "on" : "off");
     Serial.println("==============================");
 }
@@ -12,6 +12,7 @@ bool saveTemperatureSettings();
 bool saveDamperSettings();
 bool saveControlSettings();
 bool saveDisplaySettings();
+bool saveLogSettings();
 
 // Debug helper
 void printCurrentSettings();
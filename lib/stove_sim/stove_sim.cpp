@@ -0,0 +1,174 @@
+#include "stove_sim.h"
+#include <math.h>
+#include <string.h>
+
+stove_sim_config_t stove_sim_default_config() {
+    stove_sim_config_t config;
+    memset(&config, 0, sizeof(config));
+
+    config.initial_fuel_kg = 8.0f;
+    config.initial_ignition = 0.3f;
+    config.fuel_heat_j_per_kg = 15.5e6f;        // Sausa bērza malka ~4.3 kWh/kg
+    config.max_burn_rate_kg_s = 3.0f / 3600.0f; // 3 kg/h ar pilnu gaisu
+    config.fuel_half_kg = 0.8f;
+    config.ignition_tau_s = 600.0f;
+
+    config.leak_air_fraction = 0.08f;
+
+    config.heat_capacity_j_per_k = 180e3f;
+    config.heat_loss_w_per_k = 150.0f;
+    config.ambient_c = 20.0f;
+    config.initial_temp_c = 25.0f;
+
+    // Māja ar ~5 h laika konstanti; pie -5 °C ārā istaba turas 21 °C, ja apvalks ~73 °C
+    config.room_heat_capacity_j_per_k = 8e6f;
+    config.room_loss_w_per_k = 300.0f;
+    config.outdoor_c = -5.0f;
+
+    config.sensor_tau_s = 20.0f;
+
+    config.refill_count = 0;
+    return config;
+}
+
+void stove_sim_init(stove_sim_t* sim, const stove_sim_config_t* config, unsigned long now_ms) {
+    memset(sim, 0, sizeof(*sim));
+    sim->config = *config;
+    sim->fuel_kg = config->initial_fuel_kg;
+    sim->ignition = config->initial_ignition;
+    sim->water_temp_c = config->initial_temp_c;
+    sim->sensor_temp_c = config->initial_temp_c;
+    sim->room_temp_c = config->ambient_c;
+    sim->last_ms = now_ms;
+}
+
+void stove_sim_add_fuel(stove_sim_t* sim, float kg) {
+    if (kg <= 0.0f) {
+        return;
+    }
+    // Auksta krava "atšķaida" aizdegšanās pakāpi proporcionāli masai
+    const float total = sim->fuel_kg + kg;
+    sim->ignition = sim->ignition * sim->fuel_kg / total;
+    sim->fuel_kg = total;
+}
+
+void stove_sim_step(stove_sim_t* sim, unsigned long now_ms, float damper_pct) {
+    const stove_sim_config_t* c = &sim->config;
+    const float dt = (float)(now_ms - sim->last_ms) / 1000.0f;
+    sim->last_ms = now_ms;
+
+    // Plānotās piekraušanas
+    while (sim->next_refill < c->refill_count &&
+           (long)(now_ms - c->refill_at_ms[sim->next_refill]) >= 0) {
+        stove_sim_add_fuel(sim, c->refill_kg[sim->next_refill]);
+        sim->next_refill++;
+    }
+
+    if (dt <= 0.0f) {
+        return;
+    }
+
+    if (damper_pct < 0.0f) damper_pct = 0.0f;
+    if (damper_pct > 100.0f) damper_pct = 100.0f;
+    const float opening = damper_pct / 100.0f;
+    const float flow = c->butterfly_damper ? 1.0f - cosf(opening * (float)M_PI_2) : opening;
+    const float air = c->leak_air_fraction + (1.0f - c->leak_air_fraction) * flow;
+
+    // Krava aizdegas ātrāk, ja ir gaiss un kurtuve jau ir karsta
+    if (sim->fuel_kg > 0.0f) {
+        const float room_c = (float)sim->room_temp_c;
+        const float heat_factor = sim->water_temp_c > room_c
+            ? 1.0f + (sim->water_temp_c - room_c) / 50.0f
+            : 1.0f;
+        sim->ignition += (1.0f - sim->ignition) * (dt * air * heat_factor / c->ignition_tau_s);
+        if (sim->ignition > 1.0f) sim->ignition = 1.0f;
+    }
+
+    const float fuel_factor = sim->fuel_kg / (sim->fuel_kg + c->fuel_half_kg);
+    float burned = c->max_burn_rate_kg_s * air * fuel_factor * sim->ignition * dt;
+    if (burned > sim->fuel_kg) {
+        burned = sim->fuel_kg;
+    }
+    sim->fuel_kg -= burned;
+    sim->burned_kg += burned;
+
+    sim->heat_release_w = burned * c->fuel_heat_j_per_kg / dt;
+    const float loss_w = c->heat_loss_w_per_k * (sim->water_temp_c - (float)sim->room_temp_c);
+    sim->water_temp_c += (sim->heat_release_w - loss_w) * dt / c->heat_capacity_j_per_k;
+
+    // Krāsns zudumi ir istabas ieguvums
+    if (c->room_heat_capacity_j_per_k > 0.0f) {
+        const double room_loss_w = c->room_loss_w_per_k * (sim->room_temp_c - c->outdoor_c);
+        sim->room_temp_c += (loss_w - room_loss_w) * dt / c->room_heat_capacity_j_per_k;
+    }
+
+    // Sensora aizture (eksponenciāla, stabila arī pie liela dt)
+    const float alpha = 1.0f - expf(-dt / c->sensor_tau_s);
+    sim->sensor_temp_c += (sim->water_temp_c - sim->sensor_temp_c) * alpha;
+}
+
+float stove_sim_sensor_temp(const stove_sim_t* sim) {
+    return sim->sensor_temp_c;
+}
+
+void stove_bench_init(stove_bench_t* bench, unsigned long now_ms, float damper_pct) {
+    memset(bench, 0, sizeof(*bench));
+    bench->start_ms = now_ms;
+    bench->last_ms = now_ms;
+    bench->last_damper_pct = damper_pct;
+}
+
+void stove_bench_observe(stove_bench_t* bench, unsigned long now_ms, float temp_c, float target_c,
+                         float damper_pct, bool fill_active, bool end_active) {
+    const unsigned long dt_ms = now_ms - bench->last_ms;
+    bench->last_ms = now_ms;
+
+    const float error = temp_c - target_c;
+
+    if (!bench->target_reached && error >= 0.0f) {
+        bench->target_reached = true;
+        bench->target_reached_ms = now_ms;
+    }
+
+    if (bench->target_reached) {
+        if (error > bench->max_overshoot_c) {
+            bench->max_overshoot_c = error;
+        }
+        bench->abs_error_integral += fabsf(error) * (float)dt_ms / 1000.0f;
+    }
+
+    // Nostabilizēšanās: ieiešana joslā, kurā temperatūra paliek SETTLE_HOLD
+    if (fabsf(error) <= STOVE_BENCH_BAND_C) {
+        if (bench->band_entry_ms == 0) {
+            bench->band_entry_ms = now_ms;
+        }
+        if (!bench->settled && now_ms - bench->band_entry_ms >= STOVE_BENCH_SETTLE_HOLD_MS) {
+            bench->settled = true;
+            bench->settling_ms = bench->band_entry_ms - bench->start_ms;
+        }
+    } else {
+        bench->band_entry_ms = 0;
+    }
+
+    const float delta = damper_pct - bench->last_damper_pct;
+    if (delta != 0.0f) {
+        if (bench->damper_moves == 0 || now_ms - bench->last_damper_change_ms > STOVE_BENCH_MOVE_GAP_MS) {
+            bench->damper_moves++;
+        }
+        bench->damper_travel_pct += fabsf(delta);
+        const int8_t direction = delta > 0.0f ? 1 : -1;
+        if (bench->last_damper_direction != 0 && direction != bench->last_damper_direction) {
+            bench->damper_reversals++;
+        }
+        bench->last_damper_direction = direction;
+        bench->last_damper_change_ms = now_ms;
+    }
+    bench->last_damper_pct = damper_pct;
+
+    if (fill_active) {
+        bench->fill_ms += dt_ms;
+    }
+    if (end_active) {
+        bench->end_ms += dt_ms;
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Stove Sim - malkas krāsns termiskais modelis slēgtas cilpas testiem uz host
+ *
+ * Kurtuvē ir malkas krava, kas deg ar ātrumu, kurš atkarīgs no gaisa padeves
+ * (damper %), atlikušās malkas daudzuma un tā, cik labi krava ir aizdegusies.
+ * Atbrīvotais siltums silda ūdens apvalku ar siltuma ietilpību, un tas atdziest
+ * uz istabu. Istaba ir otrs, daudz lēnāks mezgls, kas zaudē siltumu uz āru.
+ * DS18B20 "redz" apvalka temperatūru ar pirmās kārtas aizturi.
+ *
+ * Modelis nav atkarīgs no Arduino API - to var darbināt arī bez firmware.
+ */
+
+#define STOVE_SIM_MAX_REFILLS 16
+
+typedef struct {
+    // Kurināmais
+    float initial_fuel_kg;          // Malka kurtuvē simulācijas sākumā
+    float initial_ignition;         // 0..1, cik labi sākuma krava jau deg
+    float fuel_heat_j_per_kg;       // Malkas siltumspēja (J/kg)
+    float max_burn_rate_kg_s;       // Degšanas ātrums ar pilnu gaisu un labi degošu kravu
+    float fuel_half_kg;             // Pie šī daudzuma degšana ir uz pusi lēnāka (ogļu fāze)
+    float ignition_tau_s;           // Laika konstante jaunas kravas aizdegšanās fāzei
+
+    // Gaisa padeve
+    float leak_air_fraction;        // Gaiss, kas iet garām aizvērtam damper (0..1)
+    bool butterfly_damper;          // Tauriņvārsts: plūsma ∝ 1 - cos(atvērums × 90°), citādi lineāra
+
+    // Siltuma bilance
+    float heat_capacity_j_per_k;    // Ūdens apvalka + krāsns siltuma ietilpība
+    float heat_loss_w_per_k;        // Siltuma zudumi uz istabu
+    float ambient_c;                // Istabas temperatūra simulācijas sākumā
+    float initial_temp_c;
+
+    // Istaba (0 siltuma ietilpība = istabas temperatūra nemainās)
+    float room_heat_capacity_j_per_k;
+    float room_loss_w_per_k;        // Zudumi caur sienām un ventilāciju
+    float outdoor_c;
+
+    // Sensors
+    float sensor_tau_s;             // DS18B20 un čaulas termiskā aizture
+
+    // Plānotās malkas piekraušanas
+    uint8_t refill_count;
+    unsigned long refill_at_ms[STOVE_SIM_MAX_REFILLS];
+    float refill_kg[STOVE_SIM_MAX_REFILLS];
+} stove_sim_config_t;
+
+typedef struct {
+    stove_sim_config_t config;
+
+    float fuel_kg;
+    float ignition;
+    float water_temp_c;
+    float sensor_temp_c;
+    double room_temp_c;             // double: soļa pieaugums ir zem float precizitātes
+    float heat_release_w;
+    float burned_kg;
+    uint8_t next_refill;
+    unsigned long last_ms;
+} stove_sim_t;
+
+// Noklusējuma parametri: ~13 kW krāsns, 8 kg krava, ~2.5 h degšana ar pilnu gaisu
+stove_sim_config_t stove_sim_default_config();
+
+void stove_sim_init(stove_sim_t* sim, const stove_sim_config_t* config, unsigned long now_ms);
+
+// Pavirza modeli līdz now_ms ar doto damper pozīciju (0..100 %)
+void stove_sim_step(stove_sim_t* sim, unsigned long now_ms, float damper_pct);
+
+// Nepieplānota malkas piekraušana (piem., "kurinātājs" reaģē uz FILL!)
+void stove_sim_add_fuel(stove_sim_t* sim, float kg);
+
+float stove_sim_sensor_temp(const stove_sim_t* sim);
+
+/**
+ * Slēgtas cilpas rādītāji
+ *
+ * stove_bench_observe() izsauc ar katru simulācijas soli. Rādītāji tiek
+ * rēķināti pret mērķa temperatūru, kāda tā bija novērošanas brīdī.
+ */
+
+#define STOVE_BENCH_BAND_C 2.0f            // ± josla ap mērķi
+#define STOVE_BENCH_SETTLE_HOLD_MS 600000   // Cik ilgi jāpaliek joslā, lai skaitītos "nostabilizējies"
+#define STOVE_BENCH_MOVE_GAP_MS 1000        // Pauze, pēc kuras nākamais servo solis ir jauna kustība
+
+typedef struct {
+    unsigned long start_ms;
+    unsigned long last_ms;
+    bool target_reached;
+    unsigned long target_reached_ms;     // Pirmoreiz sasniegts mērķis
+    unsigned long band_entry_ms;         // Pēdējā ieiešana joslā (0 = nav joslā)
+    bool settled;
+    unsigned long settling_ms;           // No sākuma līdz ieiešanai joslā, kurā nostāvēja SETTLE_HOLD
+    float max_overshoot_c;               // Lielākais pārsniegums virs mērķa
+    float abs_error_integral;            // ∫|e| dt (°C·s) pēc mērķa sasniegšanas
+    float damper_travel_pct;             // Kopējais servo ceļš
+    uint32_t damper_moves;               // Atsevišķu servo kustību skaits
+    uint32_t damper_reversals;           // Virziena maiņas (svārstību mērs)
+    int8_t last_damper_direction;        // +1 vaļā, -1 ciet, 0 vēl nav kustējies
+    float last_damper_pct;
+    unsigned long last_damper_change_ms;
+    unsigned long fill_ms;               // Laiks FILL! statusā
+    unsigned long end_ms;                // Laiks END! statusā
+} stove_bench_t;
+
+void stove_bench_init(stove_bench_t* bench, unsigned long now_ms, float damper_pct);
+void stove_bench_observe(stove_bench_t* bench, unsigned long now_ms, float temp_c, float target_c,
+                         float damper_pct, bool fill_active, bool end_active);
@@ -1,18 +1,56 @@
 #include "telnet.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include "damper_control.h"
+#include "logger.h"
+#include "recorder.h"
+#include "settings_storage.h"
+#include "temperature.h"
+#include "temperature_sensor.h"
 
 // Telnet instance
 TelnetClass Telnet;
 
+// "sensor <kanals> ..." - kanāla numurs pēc pirmā vārda, -1 ja tas nav kanāls
+static int sensorChannelFromArgs(String args) {
+    args.trim();
+    int space = args.indexOf(' ');
+    String label = space > 0 ? args.substring(0, space) : args;
+    for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+        if (label == temp_channel_label((temp_channel_t)ch)) {
+            return ch;
+        }
+    }
+    return -1;
+}
+
 void TelnetClass::begin(uint16_t port) {
     // Inicializējam telnet serveri
     server = WiFiServer(port);
     server.begin();
     server.setNoDelay(true);
     
-    // Inicializējam klientu masīvu
+    // Inicializējam klientu masīvu un izvades buferus
+    if (ringLock == NULL) {
+        ringLock = xSemaphoreCreateMutex();
+    }
     for (uint8_t i = 0; i < MAX_TELNET_CLIENTS; i++) {
         isConnected[i] = false;
+        outputs[i].attach(this, i);
+        if (rings[i].data == NULL) {
+            uint8_t* storage = NULL;
+#ifdef BOARD_HAS_PSRAM
+            if (psramFound()) {
+                storage = (uint8_t*)ps_malloc(TELNET_RING_SIZE);
+            }
+#endif
+            if (storage == NULL) {
+                storage = (uint8_t*)malloc(TELNET_RING_SIZE);
+            }
+            output_ring_init(&rings[i], storage, TELNET_RING_SIZE);
+        }
     }
+    resetStats();
 }
 
 void TelnetClass::handle() {
@@ -26,15 +64,20 @@ void TelnetClass::handle() {
                     clients[i].stop();
                 }
                 
-                // Pievienojam jauno klientu
+                // Pievienojam jauno klientu; iepriekšējā klienta nenosūtītais teksts vairs nav vajadzīgs
                 clients[i] = server.available();
                 clients[i].flush();
+                xSemaphoreTake(ringLock, portMAX_DELAY);
+                output_ring_clear(&rings[i]);
                 isConnected[i] = true;
+                dumping[i] = false;
+                hasClients = true;
+                xSemaphoreGive(ringLock);
                 
                 // Sutam sveiciena zinojumu
-                clients[i].println("Savienojums ar ESP32 telnet serveri izveidots.");
-                clients[i].println("Ievadiet 'help' lai redzetu pieejamas komandas.");
-                clients[i].println("----------------------------------------------");
+                outputs[i].println("Savienojums ar ESP32 telnet serveri izveidots.");
+                outputs[i].println("Ievadiet 'help' lai redzetu pieejamas komandas.");
+                outputs[i].println("----------------------------------------------");
                 break;
             }
         }            // Nav brivu vietu, noraidam klientu
@@ -54,69 +97,633 @@ void TelnetClass::handle() {
             
             // Apstradajam komandas
             if (command == "help") {
-                clients[i].println("Pieejamas komandas:");
-                clients[i].println("  help - Parada so palidzibu");
-                clients[i].println("  info - Parada sistemas informaciju");
-                clients[i].println("  exit - Aizver savienojumu");
-                clients[i].println("  reset - Restarte ESP32");
+                outputs[i].println("Pieejamas komandas:");
+                outputs[i].println("  help - Parada so palidzibu");
+                outputs[i].println("  info - Parada sistemas informaciju");
+                outputs[i].println("  jitter - Parada kontroles uzdevuma perioda statistiku");
+                outputs[i].println("  jitter reset - Nodzes perioda statistiku");
+                outputs[i].println("  sensor - Parada DS18B20 nolasisanas statistiku");
+                outputs[i].println("  sensor <biti> <mediana> <tau_ms> - Izskirtspeja 9-12 un filtrs");
+                outputs[i].println("  sensor reset - Nodzes sensora statistiku");
+                outputs[i].println("  sensor scan - Parskene OneWire kopni");
+                outputs[i].println("  sensor <dumi|istaba|udens> <nr|nav> - Piesaista kopnes sensoru kanalam");
+                outputs[i].println("  servo [deadband_% backlash_%] - Servo nolietojuma skaititaji un kompensacija");
+                outputs[i].println("  servo reset - Nodzes servo skaititajus");
+                outputs[i].println("  airflow [<plusma_%> <us>|del <plusma_%>|clear|butterfly] - Gaisa plusmas -> servo impulsa tabula");
+                outputs[i].println("  airflow kalib - Vadita kalibracija (airflow +N/-N us, ok, stop)");
+                outputs[i].println("  buzzer [mute|unmute|<parkarsana|sensors|izdegusi|malka> on|off] - Skanas raksti");
+                outputs[i].println("  wood [trenda_s bazes_s] - Kurinasanas detektora logi");
+                outputs[i].println("  autotune [start [lecien_%]|stop] - PID parametru noteiksana ar damper leciena eksperimentu");
+                outputs[i].println("  ff [trends boost tau_s] - Feed-forward (0 0 0 = izslegts)");
+                outputs[i].println("  gains [<temp_C> <kp_x> [tauI_x]|del <temp_C>|clear] - kP/tauI grafiks pec temperaturas");
+                outputs[i].println("  kaskade [on|off|<istaba_C> [kp tauI_s]] - Istabas temperaturas kaskade");
+                outputs[i].println("  telnet [reset] - Izvades buferu statistika");
+                outputs[i].println("  log [serial|telnet|flash] <off|error|warn|info|debug> - Zurnala limenis izejai");
+                outputs[i].println("  log show [rindas] | log erase - Flash zurnals (saglabajas pec restarta)");
+                outputs[i].println("  rec [on|off|erase] - Regulatora trase flash atmina");
+                outputs[i].println("  rec dump [sektori] - Trases bloki hex rindas (REC ...) dekoderim native_trace");
+                outputs[i].println("  exit - Aizver savienojumu");
+                outputs[i].println("  reset - Restarte ESP32");
             } 
             else if (command == "info") {
-                clients[i].println("ESP32 sistemas informacija:");
-                clients[i].print("  IP adrese: ");
-                clients[i].println(WiFi.localIP());
-                clients[i].print("  MAC adrese: ");
-                clients[i].println(WiFi.macAddress());
-                clients[i].print("  RSSI: ");
-                clients[i].println(WiFi.RSSI());
-                clients[i].print("  Briva atmina: ");
-                clients[i].println(ESP.getFreeHeap());
+                outputs[i].println("ESP32 sistemas informacija:");
+                outputs[i].print("  IP adrese: ");
+                outputs[i].println(WiFi.localIP());
+                outputs[i].print("  MAC adrese: ");
+                outputs[i].println(WiFi.macAddress());
+                outputs[i].print("  RSSI: ");
+                outputs[i].println(WiFi.RSSI());
+                outputs[i].print("  Briva atmina: ");
+                outputs[i].println(ESP.getFreeHeap());
+            }
+            else if (command == "jitter") {
+                damperControlPrintStats(outputs[i]);
+            }
+            else if (command == "jitter reset") {
+                damperControlResetStats();
+                outputs[i].println("Perioda statistika nodzesta.");
+            }
+            else if (command == "sensor") {
+                temperatureSensorPrintStats(outputs[i]);
+            }
+            else if (command == "sensor reset") {
+                temperatureSensorResetStats();
+                outputs[i].println("Sensora statistika nodzesta.");
+            }
+            else if (command == "sensor scan") {
+                temperatureSensorRequestScan();
+                outputs[i].println("Kopne tiks parskeneta nakamaja karta ('sensor' - rezultats).");
+            }
+            else if (command.startsWith("sensor ") && sensorChannelFromArgs(command.substring(7)) >= 0) {
+                String args = command.substring(7);
+                args.trim();
+                int space = args.indexOf(' ');
+                int channel = sensorChannelFromArgs(args);
+                String target = space > 0 ? args.substring(space + 1) : String("");
+                target.trim();
+                uint8_t address[8] = {0};
+                if (target == "nav") {
+                    memcpy(temperatureChannelAddress[channel], address, 8);
+                    saveTemperatureSettings();
+                    temperatureSensorChannelsChanged();
+                    outputs[i].println("Kanals atsaistits.");
+                } else if (target[0] >= '0' && target[0] <= '9' &&
+                           temperatureSensorDeviceAddress((uint8_t)target.toInt(), address)) {
+                    memcpy(temperatureChannelAddress[channel], address, 8);
+                    saveTemperatureSettings();
+                    temperatureSensorChannelsChanged();
+                    outputs[i].println("Kanals piesaistits (stasies speka nakamaja karta).");
+                } else {
+                    outputs[i].println("Nav tada sensora kopne - skatit 'sensor'.");
+                }
+            }
+            else if (command.startsWith("sensor ")) {
+                String args = command.substring(7);
+                args.trim();
+                int first = args.indexOf(' ');
+                int second = first > 0 ? args.indexOf(' ', first + 1) : -1;
+                if (second > 0) {
+                    long bits = args.substring(0, first).toInt();
+                    long median = args.substring(first + 1, second).toInt();
+                    long tauMs = args.substring(second + 1).toInt();
+                    if (bits >= 9 && bits <= 12 && median >= 1 && median <= 5 && tauMs >= 0) {
+                        temperatureResolutionBits = bits;
+                        temperatureMedianLength = median;
+                        temperatureFilterTauMs = tauMs;
+                        saveTemperatureSettings();
+                        outputs[i].println("Sensora iestatijumi saglabati (stasies speka nakamaja nolasijuma).");
+                    } else {
+                        outputs[i].println("Nederigi parametri: biti 9-12, mediana 1-5, tau_ms >= 0.");
+                    }
+                } else {
+                    outputs[i].println("Lietojums: sensor <biti> <mediana> <tau_ms>");
+                }
+            }
+            else if (command == "autotune" || command.startsWith("autotune ")) {
+                String args = command.substring(9);
+                args.trim();
+                if (args == "stop") {
+                    damperControlAbortAutotune();
+                    outputs[i].println("Autotune tiks partraukts.");
+                } else if (args == "start" || args.startsWith("start ")) {
+                    float stepPct = args.length() > 6 ? args.substring(6).toFloat() : 20.0f;
+                    if (stepPct >= 5 && stepPct <= 50 && damperControlRequestAutotune(stepPct)) {
+                        outputs[i].println("Autotune sakas (~15-90 min). Neaiztieciet varstu un malku.");
+                    } else {
+                        outputs[i].println("Nevar sakt: lecien 5-50 %, vajag AUTO rezimu.");
+                    }
+                } else {
+                    damperControlPrintAutotune(outputs[i]);
+                }
+            }
+            else if (command == "ff" || command.startsWith("ff ")) {
+                String args = command.substring(3);
+                args.trim();
+                int first = args.indexOf(' ');
+                int second = first > 0 ? args.indexOf(' ', first + 1) : -1;
+                if (second > 0) {
+                    float trend = args.substring(0, first).toFloat();
+                    float boost = args.substring(first + 1, second).toFloat();
+                    float tauS = args.substring(second + 1).toFloat();
+                    if (trend >= 0 && boost >= -1 && tauS >= 0) {
+                        ffTrendGain = trend;
+                        ffRefillBoost = boost;
+                        ffRefillTauS = tauS;
+                        saveControlSettings();
+                    } else {
+                        outputs[i].println("Nederigi parametri: trends >= 0, boost >= -1, tau_s >= 0.");
+                    }
+                } else if (args.length() > 0) {
+                    outputs[i].println("Lietojums: ff <trends> <boost> <tau_s>");
+                }
+                controller_state_t state;
+                controller_state_read(&state);
+                outputs[i].print("Feed-forward: ");
+                outputs[i].print(ffTrendGain);
+                outputs[i].print(" %/(C/min) virs kapuma sliekshna, pec piekrausanas x(1 + ");
+                outputs[i].print(ffRefillBoost);
+                outputs[i].print(" e^(-t/");
+                outputs[i].print(ffRefillTauS);
+                outputs[i].println(" s))");
+                outputs[i].print("  Pasreiz: ");
+                outputs[i].print(state.ffTerm);
+                outputs[i].print(" % (slipums ");
+                outputs[i].print(state.trendCPerMin);
+                outputs[i].println(" C/min)");
+            }
+            else if (command == "gains" || command.startsWith("gains ")) {
+                String args = command.substring(6);
+                args.trim();
+                int first = args.indexOf(' ');
+                int second = first > 0 ? args.indexOf(' ', first + 1) : -1;
+                // Labojam kopiju; kontroles uzdevums redz tikai pabeigtu tabulu
+                gain_schedule_t schedule = gainSchedule;
+                bool changed = false;
+                if (args == "clear") {
+                    gain_schedule_clear(&schedule);
+                    changed = true;
+                } else if (args.startsWith("del ")) {
+                    changed = gain_schedule_remove(&schedule, args.substring(4).toFloat());
+                    if (!changed) {
+                        outputs[i].println("Sada punkta nav.");
+                    }
+                } else if (first > 0) {
+                    float tempC = args.substring(0, first).toFloat();
+                    float kpScale = (second > 0 ? args.substring(first + 1, second) : args.substring(first + 1)).toFloat();
+                    float tauIScale = second > 0 ? args.substring(second + 1).toFloat() : 1.0f;
+                    changed = gain_schedule_set(&schedule, tempC, kpScale, tauIScale);
+                    if (!changed) {
+                        outputs[i].printf("Nederigi parametri: reizinataji 0.1-10, ne vairak ka %d punkti.\r\n",
+                                          GAIN_SCHEDULE_MAX_POINTS);
+                    }
+                } else if (args.length() > 0) {
+                    outputs[i].println("Lietojums: gains <temp_C> <kp_x> [tauI_x] | gains del <temp_C> | gains clear");
+                }
+                if (changed) {
+                    damperControlSetGainSchedule(&schedule);
+                    saveControlSettings();
+                }
+                damperControlPrintGainSchedule(outputs[i]);
+            }
+            else if (command == "kaskade" || command.startsWith("kaskade ")) {
+                String args = command.substring(8);
+                args.trim();
+                int first = args.indexOf(' ');
+                int second = first > 0 ? args.indexOf(' ', first + 1) : -1;
+                if (args == "on" || args == "off") {
+                    cascadeEnabled = args == "on";
+                    saveControlSettings();
+                } else if (args.length() > 0) {
+                    float room = (first > 0 ? args.substring(0, first) : args).toFloat();
+                    float kp = second > 0 ? args.substring(first + 1, second).toFloat() : cascadeKp;
+                    float tauIS = second > 0 ? args.substring(second + 1).toFloat() : cascadeTauI;
+                    if (room >= 10 && room <= 30 && kp > 0 && tauIS > 0) {
+                        roomTargetC = room;
+                        cascadeKp = kp;
+                        cascadeTauI = tauIS;
+                        saveControlSettings();
+                    } else {
+                        outputs[i].println("Nederigi parametri: istaba 10-30 C, kp > 0, tauI_s > 0.");
+                    }
+                }
+                controller_state_t state;
+                controller_state_read(&state);
+                outputs[i].print("Kaskade: ");
+                outputs[i].print(cascadeEnabled ? (state.cascadeActive ? "aktiva" : "ieslegta (gaida)") : "izslegta");
+                outputs[i].print(", istabas merkis ");
+                outputs[i].print(roomTargetC);
+                outputs[i].print(" C, kp ");
+                outputs[i].print(cascadeKp);
+                outputs[i].print(", tauI ");
+                outputs[i].print(cascadeTauI);
+                outputs[i].println(" s");
+                outputs[i].print("  Istaba: ");
+                if (state.channelValidMask & (1 << TEMP_CHANNEL_ROOM)) {
+                    outputs[i].print(state.channelC[TEMP_CHANNEL_ROOM]);
+                    outputs[i].print(" C");
+                } else {
+                    outputs[i].print("nav sensora ('sensor istaba <nr>')");
+                }
+                outputs[i].print(", dumgazu merkis ");
+                outputs[i].print(state.targetTemp);
+                outputs[i].println(" C");
+            }
+            else if (command == "servo reset") {
+                damperControlResetServoStats();
+                outputs[i].println("Servo skaititaji nodzesti.");
+            }
+            else if (command == "servo" || command.startsWith("servo ")) {
+                String args = command.substring(6);
+                args.trim();
+                int space = args.indexOf(' ');
+                if (space > 0) {
+                    long deadband = args.substring(0, space).toInt();
+                    float backlash = args.substring(space + 1).toFloat();
+                    if (deadband >= 0 && deadband <= 10 && backlash >= 0 && backlash <= 10) {
+                        servoDeadbandPct = deadband;
+                        servoBacklashPct = backlash;
+                        saveDamperSettings();
+                    } else {
+                        outputs[i].println("Nederigi parametri: deadband 0-10 %, backlash 0-10 %.");
+                    }
+                } else if (args.length() > 0) {
+                    outputs[i].println("Lietojums: servo <deadband_%> <backlash_%>");
+                }
+                damperControlPrintServoStats(outputs[i]);
+            }
+            else if (command == "airflow" || command.startsWith("airflow ")) {
+                String args = command.substring(8);
+                args.trim();
+                int space = args.indexOf(' ');
+                // Labojam kopiju; servo uzdevums redz tikai pabeigtu tabulu
+                airflow_map_t map = airflowMap;
+                bool changed = false;
+                if (args == "kalib") {
+                    damperControlStartAirflowCalibration();
+                    outputs[i].println("Kalibracija: ar 'airflow +N'/'-N' (us) iestatiet noradito plusmu, tad 'airflow ok'.");
+                } else if (args == "ok") {
+                    if (!damperControlAirflowCalibrationActive()) {
+                        outputs[i].println("Kalibracija nav sakta ('airflow kalib').");
+                    } else if (!damperControlAcceptAirflowCalibration()) {
+                        outputs[i].println("Impulsam jamainas viena virziena ar plusmu - pieregulejiet.");
+                    } else if (!damperControlAirflowCalibrationActive()) {
+                        outputs[i].println("Kalibracija pabeigta.");
+                        saveDamperSettings();
+                    }
+                } else if (args == "stop") {
+                    damperControlStopAirflowCalibration();
+                    outputs[i].println("Kalibracija atcelta, tabula nav mainita.");
+                } else if (args.startsWith("+") || args.startsWith("-")) {
+                    damperControlJogAirflowCalibration(args.toInt());
+                } else if (args == "clear") {
+                    airflow_map_clear(&map);
+                    changed = true;
+                } else if (args == "butterfly") {
+                    // Teorētiska līkne starp esošās ģeometrijas galapunktiem
+                    airflow_map_fill_butterfly(&map, damperOpeningToMicros(0), damperOpeningToMicros(100),
+                                               AIRFLOW_MAP_MAX_POINTS);
+                    changed = true;
+                } else if (args.startsWith("del ")) {
+                    changed = airflow_map_remove(&map, args.substring(4).toFloat());
+                    if (!changed) {
+                        outputs[i].println("Sada punkta nav.");
+                    }
+                } else if (space > 0) {
+                    float airflowPct = args.substring(0, space).toFloat();
+                    float micros = args.substring(space + 1).toFloat();
+                    changed = airflowPct >= 0 && airflowPct <= 100 && micros >= 500 && micros <= 2500 &&
+                              airflow_map_set(&map, airflowPct, micros);
+                    if (!changed) {
+                        outputs[i].printf("Nederigi parametri: plusma 0-100 %%, impulss 500-2500 us, monotons, ne vairak ka %d punkti.\r\n",
+                                          AIRFLOW_MAP_MAX_POINTS);
+                    }
+                } else if (args.length() > 0) {
+                    outputs[i].println("Lietojums: airflow <plusma_%> <us> | airflow del <plusma_%> | airflow clear | airflow butterfly | airflow kalib");
+                }
+                if (changed) {
+                    damperControlSetAirflowMap(&map);
+                    saveDamperSettings();
+                }
+                damperControlPrintAirflowMap(outputs[i]);
+            }
+            else if (command == "buzzer" || command.startsWith("buzzer ")) {
+                String args = command.substring(7);
+                args.trim();
+                int space = args.indexOf(' ');
+                buzzer_pattern_id_t pattern;
+                if (args == "mute" || args == "unmute") {
+                    buzzerMute(args == "mute");
+                } else if (space > 0 && buzzer_pattern_from_name(args.substring(0, space).c_str(), &pattern) &&
+                           (args.substring(space + 1) == "on" || args.substring(space + 1) == "off")) {
+                    buzzerSetPattern(pattern, args.substring(space + 1) == "on");
+                } else if (args.length() > 0) {
+                    outputs[i].println("Lietojums: buzzer mute | buzzer unmute | buzzer <parkarsana|sensors|izdegusi|malka> <on|off>");
+                }
+                buzzerPrintStatus(outputs[i]);
+            }
+            else if (command == "wood" || command.startsWith("wood ")) {
+                String args = command.substring(5);
+                args.trim();
+                int space = args.indexOf(' ');
+                if (space > 0) {
+                    long recentS = args.substring(0, space).toInt();
+                    long olderS = args.substring(space + 1).toInt();
+                    if (recentS > 0 && olderS > 0) {
+                        woodFillRecentS = recentS;
+                        woodFillOlderS = olderS;
+                        saveControlSettings();
+                    } else {
+                        outputs[i].println("Nederigi logi.");
+                    }
+                }
+                outputs[i].print("Detektora logi: trends ");
+                outputs[i].print(woodFillRecentS);
+                outputs[i].print(" s, baze ");
+                outputs[i].print(woodFillOlderS);
+                outputs[i].println(" s");
+            }
+            else if (command == "telnet" || command == "telnet reset") {
+                if (command == "telnet reset") {
+                    resetStats();
+                }
+                printStats(outputs[i]);
+            }
+            else if (command == "log" || command.startsWith("log ")) {
+                String args = command.substring(4);
+                args.trim();
+                int space = args.indexOf(' ');
+                String first = space > 0 ? args.substring(0, space) : args;
+                String second = space > 0 ? args.substring(space + 1) : String("");
+                second.trim();
+                int8_t level;
+                log_sink_t sink;
+                if (first == "show") {
+                    // Telnet buferī ietilpst ~100 rindas
+                    long lines = second.length() > 0 ? second.toInt() : 40;
+                    loggerPrintFlash(outputs[i], (uint16_t)constrain(lines, 1, 100));
+                } else if (args == "erase") {
+                    outputs[i].println(loggerEraseFlash() ? "Flash zurnals izdzests." : "Flash zurnals nav pieejams.");
+                } else if (space < 0 && loggerLevelFromName(args.c_str(), &level)) {
+                    loggerSetLevel(LOG_SINK_TELNET, level);
+                    saveLogSettings();
+                } else if (space > 0 && loggerSinkFromName(first.c_str(), &sink) &&
+                           loggerLevelFromName(second.c_str(), &level)) {
+                    loggerSetLevel(sink, level);
+                    saveLogSettings();
+                } else if (args.length() > 0) {
+                    outputs[i].println("Lietojums: log [serial|telnet|flash] <off|error|warn|info|debug> | log show [rindas] | log erase");
+                }
+                if (first != "show") {
+                    loggerPrintStatus(outputs[i]);
+                }
+            }
+            else if (command == "rec" || command.startsWith("rec ")) {
+                String args = command.substring(4);
+                args.trim();
+                if (args == "on" || args == "off") {
+                    recorderEnabled = args == "on";
+                    saveLogSettings();
+                } else if (args == "erase") {
+                    outputs[i].println(recorderErase() ? "Trase izdzesta." : "Trase nav pieejama.");
+                } else if (args == "dump" || args.startsWith("dump ")) {
+                    // Bloki tiek sūtīti pa daļām no handle(), kamēr buferī ir vieta
+                    long sectors = args.length() > 5 ? args.substring(5).toInt() : 0;
+                    if (recorderDumpBegin(&dumpCursors[i], sectors > 0 ? (uint16_t)(sectors - 1) : 0xFFFF)) {
+                        dumping[i] = true;
+                        dumpBlocks[i] = 0;
+                        outputs[i].println("REC BEGIN");
+                    } else {
+                        outputs[i].println("Trase nav pieejama.");
+                    }
+                } else if (args.length() > 0) {
+                    outputs[i].println("Lietojums: rec [on|off|erase] | rec dump [sektori]");
+                }
+                if (!args.startsWith("dump")) {
+                    recorderPrintStatus(outputs[i]);
+                }
             }
             else if (command == "exit") {
-                clients[i].println("Atvienojamies...");
+                outputs[i].println("Atvienojamies...");
+                flushClient(i);
                 clients[i].stop();
             }
             else if (command == "reset") {
-                clients[i].println("Restartejam ESP32...");
+                outputs[i].println("Restartejam ESP32...");
+                flushClient(i);
                 delay(500);
                 ESP.restart();
             }
             else if (command.length() > 0) {
-                clients[i].print("Nezinama komanda: ");
-                clients[i].println(command);
+                outputs[i].print("Nezinama komanda: ");
+                outputs[i].println(command);
             }
         }
     }
     
-    // Pārbaudam atvienotos klientus
+    // Pārbaudam atvienotos klientus, pārējiem sūtām uzkrāto izvadi
     for (uint8_t i = 0; i < MAX_TELNET_CLIENTS; i++) {
         if (isConnected[i] && !clients[i].connected()) {
             clients[i].stop();
+            xSemaphoreTake(ringLock, portMAX_DELAY);
             isConnected[i] = false;
+            output_ring_clear(&rings[i]);
+            hasClients = false;
+            for (uint8_t other = 0; other < MAX_TELNET_CLIENTS; other++) {
+                hasClients = hasClients || isConnected[other];
+            }
+            xSemaphoreGive(ringLock);
+        } else if (isConnected[i]) {
+            if (dumping[i]) {
+                continueDump(i);
+            }
+            flushClient(i);
         }
     }
 }
 
-// Write metodes
-size_t TelnetClass::write(uint8_t c) {
-    size_t n = 0;
-    for (uint8_t i = 0; i < MAX_TELNET_CLIENTS; i++) {
-        if (clients[i] && clients[i].connected()) {
-            n += clients[i].write(c);
+/**
+ * Sūta klienta bufera saturu lieliem gabaliem. Rakstītāji pievieno tikai aiz
+ * bufera beigām, tāpēc nosūtāmo apgabalu var rakstīt bez slēdzenes
+ */
+void TelnetClass::flushClient(uint8_t index) {
+    for (uint8_t chunk = 0; chunk < TELNET_FLUSH_MAX_CHUNKS; chunk++) {
+        const uint8_t* data;
+        xSemaphoreTake(ringLock, portMAX_DELAY);
+        uint32_t size = output_ring_peek(&rings[index], &data);
+        xSemaphoreGive(ringLock);
+        if (size == 0) {
+            return;
+        }
+        if (size > TELNET_FLUSH_CHUNK) {
+            size = TELNET_FLUSH_CHUNK;
+        }
+        size_t sent = clients[index].write(data, size);
+        stats.socketWrites++;
+        stats.sentBytes += sent;
+        xSemaphoreTake(ringLock, portMAX_DELAY);
+        output_ring_consume(&rings[index], sent);
+        xSemaphoreGive(ringLock);
+        if (sent < size) {
+            return;   // TCP sūtīšanas buferis pilns - turpināsim nākamajā handle()
         }
     }
+}
+
+/**
+ * "rec dump": nākamie trases bloki kā "REC <hex>" rindas. Rindu ieraksta
+ * vienā gabalā (žurnāla rindas no citiem uzdevumiem to nesadala) un tikai
+ * tad, ja tā klienta buferī ietilpst vesela - lēns klients palēnina
+ * izgūšanu, nevis zaudē blokus. Beigās "REC END <bloki>"
+ */
+void TelnetClass::continueDump(uint8_t index) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    static uint8_t block[TRACE_BLOCK_MAX];
+    static char line[4 + 2 * TRACE_BLOCK_MAX + 2];   // handle() izsauc tikai loop()
+
+    for (uint8_t n = 0; n < TELNET_DUMP_BLOCKS; n++) {
+        // Aptuvena pārbaude, lai velti nelasītu flash; izšķir enqueueWhole()
+        xSemaphoreTake(ringLock, portMAX_DELAY);
+        const bool room = output_ring_fits(&rings[index], sizeof(line));
+        xSemaphoreGive(ringLock);
+        if (!room) {
+            return;
+        }
+
+        const flash_ring_cursor_t cursor = dumpCursors[index];
+        uint16_t length = recorderDumpNext(&dumpCursors[index], block, sizeof(block));
+        if (length == 0) {
+            outputs[index].printf("REC END %lu\r\n", (unsigned long)dumpBlocks[index]);
+            dumping[index] = false;
+            return;
+        }
+        if (length > sizeof(block)) {
+            length = sizeof(block);
+        }
+        memcpy(line, "REC ", 4);
+        uint32_t used = 4;
+        for (uint16_t k = 0; k < length; k++) {
+            line[used++] = HEX_DIGITS[block[k] >> 4];
+            line[used++] = HEX_DIGITS[block[k] & 0x0F];
+        }
+        line[used++] = '\r';
+        line[used++] = '\n';
+        if (!enqueueWhole(index, (const uint8_t*)line, used)) {
+            // Vietu pa to laiku aizņēma žurnāla rindas - to pašu bloku nākamreiz
+            dumpCursors[index] = cursor;
+            return;
+        }
+        dumpBlocks[index]++;
+    }
+}
+
+// Kā enqueue(), bet gabals, kas neietilpst, netiek skaitīts kā izmests
+bool TelnetClass::enqueueWhole(uint8_t index, const uint8_t *buffer, size_t size) {
+    if (ringLock == NULL || !isConnected[index]) {
+        return false;
+    }
+    xSemaphoreTake(ringLock, portMAX_DELAY);
+    const bool fits = output_ring_fits(&rings[index], size);
+    if (fits) {
+        output_ring_write(&rings[index], buffer, size);
+        stats.queuedBytes += size;
+    }
+    xSemaphoreGive(ringLock);
+    return fits;
+}
+
+size_t TelnetClass::enqueue(uint8_t index, const uint8_t *buffer, size_t size) {
+    if (ringLock == NULL || !isConnected[index]) {
+        return 0;
+    }
+    xSemaphoreTake(ringLock, portMAX_DELAY);
+    const uint32_t droppedBefore = rings[index].droppedBytes;
+    size_t n = output_ring_write(&rings[index], buffer, size);
+    stats.queuedBytes += n;
+    if (rings[index].droppedBytes != droppedBefore) {
+        stats.droppedBytes += size;
+        stats.droppedWrites++;
+    }
+    xSemaphoreGive(ringLock);
     return n;
 }
 
+size_t TelnetClientOutput::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t TelnetClientOutput::write(const uint8_t *buffer, size_t size) {
+    return owner ? owner->enqueue(index, buffer, size) : 0;
+}
+
+telnet_stats_t TelnetClass::getStats() {
+    return stats;
+}
+
+void TelnetClass::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+    stats.sinceMs = millis();
+}
+
+void TelnetClass::printStats(Print &out) {
+    telnet_stats_t current = stats;
+    out.print("Telnet: ierakstiti ");
+    out.print(current.queuedBytes);
+    out.print(" B, nosutiti ");
+    out.print(current.sentBytes);
+    out.print(" B ar ");
+    out.print(current.socketWrites);
+    out.print(" write() (vid. ");
+    out.print(current.socketWrites ? current.sentBytes / current.socketWrites : 0);
+    out.println(" B)");
+    out.print("  Izmesti: ");
+    out.print(current.droppedBytes);
+    out.print(" B (");
+    out.print(current.droppedWrites);
+    out.println(" ierakstu)");
+    for (uint8_t i = 0; i < MAX_TELNET_CLIENTS; i++) {
+        if (isConnected[i]) {
+            out.print("  Klients ");
+            out.print(i);
+            out.print(": buferi ");
+            out.print(rings[i].count);
+            out.print(" / ");
+            out.print(rings[i].capacity);
+            out.println(" B");
+        }
+    }
+}
+
+// Write metodes: tikai ieraksta klientu buferos (drīkst izsaukt no jebkura uzdevuma)
+size_t TelnetClass::write(uint8_t c) {
+    return write(&c, 1);
+}
+
 size_t TelnetClass::write(const uint8_t *buffer, size_t size) {
     size_t n = 0;
     for (uint8_t i = 0; i < MAX_TELNET_CLIENTS; i++) {
-        if (clients[i] && clients[i].connected()) {
-            n += clients[i].write(buffer, size);
-        }
+        n += enqueue(i, buffer, size);
     }
     return n;
 }
 
+size_t TelnetClass::printf(const char* format, ...) {
+    char buffer[TELNET_PRINTF_MAX];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length <= 0) {
+        return 0;
+    }
+    // Garāku rindu nogriežam, bet rindas beigas saglabājam
+    if ((size_t)length >= sizeof(buffer)) {
+        length = sizeof(buffer) - 1;
+        buffer[length - 2] = '\r';
+        buffer[length - 1] = '\n';
+    }
+    return write((const uint8_t*)buffer, length);
+}
+
 // Print metodes
 size_t TelnetClass::print(const String &s) {
     return write((const uint8_t*)s.c_str(), s.length());
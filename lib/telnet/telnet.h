@@ -3,9 +3,47 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "output_ring.h"
+#include "flash_ring.h"
 
 #define MAX_TELNET_CLIENTS 2
 
+// Izvade tiek krāta katra klienta gredzenbuferī (PSRAM, ja ir) un sūtīta no
+// handle() lieliem gabaliem. Lēnam klientam buferis pārpildās un jaunais
+// teksts tiek izmests ar kopsavilkumu, nevis bloķēts rakstītājs
+#define TELNET_RING_SIZE       8192
+#define TELNET_FLUSH_CHUNK     1460   // Viens TCP segments (MSS)
+#define TELNET_FLUSH_MAX_CHUNKS 4     // Uz klientu vienā handle() izsaukumā
+
+#define TELNET_PRINTF_MAX 384   // Viena printf() rinda (steka buferis)
+#define TELNET_DUMP_BLOCKS 2     // "rec dump": trases bloki uz klientu vienā handle() izsaukumā
+
+typedef struct {
+    uint32_t queuedBytes;      // Ierakstīti buferos (visiem klientiem kopā)
+    uint32_t sentBytes;
+    uint32_t socketWrites;     // WiFiClient::write() izsaukumi (~ TCP segmenti)
+    uint32_t droppedBytes;
+    uint32_t droppedWrites;
+    unsigned long sinceMs;
+} telnet_stats_t;
+
+class TelnetClass;
+
+// Print viena klienta buferim (komandu atbildes, damperControlPrint*())
+class TelnetClientOutput : public Print {
+public:
+    void attach(TelnetClass* owner, uint8_t index) { this->owner = owner; this->index = index; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+private:
+    TelnetClass* owner = nullptr;
+    uint8_t index = 0;
+};
+
 class TelnetClass {
 public:
     // Inicializācija
@@ -39,10 +77,35 @@ public:
     size_t println(double n, int digits = 2);
     size_t println(void);
 
+    // Formatē steka buferī (bez String) un ieraksta klientu buferos vienā gabalā
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    // Vai ir kāds klients (logger bez tiem telnet rindas neformatē)
+    bool hasClient() const { return hasClients; }
+
+    // Buferu statistika (telnet komanda "telnet")
+    telnet_stats_t getStats();
+    void resetStats();
+    void printStats(Print &out);
+
 private:
+    friend class TelnetClientOutput;
+    size_t enqueue(uint8_t index, const uint8_t *buffer, size_t size);
+    bool enqueueWhole(uint8_t index, const uint8_t *buffer, size_t size);
+    void flushClient(uint8_t index);
+    void continueDump(uint8_t index);
+
     WiFiServer server;
     WiFiClient clients[MAX_TELNET_CLIENTS];
     bool isConnected[MAX_TELNET_CLIENTS];
+    output_ring_t rings[MAX_TELNET_CLIENTS];
+    TelnetClientOutput outputs[MAX_TELNET_CLIENTS];
+    bool dumping[MAX_TELNET_CLIENTS] = {false};   // "rec dump" turpinās
+    flash_ring_cursor_t dumpCursors[MAX_TELNET_CLIENTS];
+    uint32_t dumpBlocks[MAX_TELNET_CLIENTS] = {0};
+    SemaphoreHandle_t ringLock = NULL;
+    volatile bool hasClients = false;
+    telnet_stats_t stats = {0};
 };
 
 extern TelnetClass Telnet;
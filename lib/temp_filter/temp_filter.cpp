@@ -0,0 +1,72 @@
+#include "temp_filter.h"
+#include <string.h>
+
+static uint8_t clamp_median_length(uint8_t length) {
+    if (length < 1) {
+        return 1;
+    }
+    if (length > TEMP_FILTER_MAX_MEDIAN) {
+        length = TEMP_FILTER_MAX_MEDIAN;
+    }
+    // Pāra garumam nav viena vidējā elementa
+    return (length % 2 == 0) ? (uint8_t)(length - 1) : length;
+}
+
+void temp_filter_init(temp_filter_t* filter, uint8_t medianLength, uint32_t emaTauMs) {
+    memset(filter, 0, sizeof(*filter));
+    filter->medianLength = clamp_median_length(medianLength);
+    filter->emaTauMs = emaTauMs;
+}
+
+void temp_filter_configure(temp_filter_t* filter, uint8_t medianLength, uint32_t emaTauMs) {
+    const uint8_t length = clamp_median_length(medianLength);
+    if (length != filter->medianLength) {
+        temp_filter_init(filter, length, emaTauMs);
+        return;
+    }
+    filter->emaTauMs = emaTauMs;
+}
+
+void temp_filter_reset(temp_filter_t* filter) {
+    temp_filter_init(filter, filter->medianLength, filter->emaTauMs);
+}
+
+// Mediāna no pieejamajiem rādījumiem (kamēr logs pildās - no mazāka skaita)
+static int16_t window_median(const temp_filter_t* f) {
+    int16_t sorted[TEMP_FILTER_MAX_MEDIAN];
+    const uint8_t n = f->count;
+    for (uint8_t i = 0; i < n; i++) {
+        int16_t value = f->window[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+    // Pāra skaitam (tikai pildoties) ņemam apakšējo vidējo
+    return sorted[(n - 1) / 2];
+}
+
+int16_t temp_filter_update(temp_filter_t* filter, int16_t value, uint32_t dtMs) {
+    temp_filter_t* f = filter;
+
+    f->window[f->head] = value;
+    f->head = (uint8_t)((f->head + 1) % f->medianLength);
+    if (f->count < f->medianLength) {
+        f->count++;
+    }
+    const int32_t medianQ8 = (int32_t)window_median(f) * 256;
+
+    if (!f->primed || f->emaTauMs == 0) {
+        f->emaQ8 = medianQ8;
+        f->primed = true;
+    } else {
+        // alfa = dt / (tau + dt) ar 16 daļbitiem
+        const uint32_t alphaQ16 = (uint32_t)(((uint64_t)dtMs << 16) / ((uint64_t)f->emaTauMs + dtMs));
+        f->emaQ8 += (int32_t)(((int64_t)(medianQ8 - f->emaQ8) * alphaQ16) >> 16);
+    }
+
+    // Noapaļo uz tuvāko (aritmētiskā nobīde - arī negatīvām vērtībām)
+    return (int16_t)((f->emaQ8 + 128) >> 8);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Temp Filter - sensora rādījumu filtrs fiksētajā komatā
+ *
+ * Divas pakāpes pēc kārtas:
+ *   1. mediāna pār pēdējiem medianLength rādījumiem (1, 3 vai 5) - viens
+ *      kopnes traucējuma lēciens neiziet cauri;
+ *   2. eksponenciālais vidējais ar laika konstanti emaTauMs - alfa tiek
+ *      rēķināta no faktiskā dt, tāpēc nolasīšanas intervāla maiņa
+ *      nemaina filtra joslu. emaTauMs = 0 izslēdz šo pakāpi.
+ *
+ * Vērtības ir °C × 16 (DS18B20 12 bitu solis), EMA iekšēji glabā vēl
+ * 8 daļbitus, lai lēni kāpumi nenoslīkst noapaļošanā. Bez Arduino
+ * atkarībām, tāpat kā temp_history.
+ */
+
+#define TEMP_FILTER_MAX_MEDIAN 5
+
+typedef struct {
+    uint8_t medianLength;
+    uint32_t emaTauMs;
+
+    int16_t window[TEMP_FILTER_MAX_MEDIAN];
+    uint8_t head;
+    uint8_t count;
+    int32_t emaQ8;        // EMA × 256
+    bool primed;          // EMA jau ir sākuma vērtība
+} temp_filter_t;
+
+// medianLength tiek ierobežots līdz nepāra skaitlim 1..TEMP_FILTER_MAX_MEDIAN
+void temp_filter_init(temp_filter_t* filter, uint8_t medianLength, uint32_t emaTauMs);
+
+// Maina parametrus; vēsture saglabājas, ja mediānas garums nemainās
+void temp_filter_configure(temp_filter_t* filter, uint8_t medianLength, uint32_t emaTauMs);
+
+// Aizmirst vēsturi - nākamais rādījums iziet cauri nefiltrēts
+void temp_filter_reset(temp_filter_t* filter);
+
+// Jauns rādījums; dtMs - laiks kopš iepriekšējā. Atgriež filtrēto vērtību.
+int16_t temp_filter_update(temp_filter_t* filter, int16_t value, uint32_t dtMs);
@@ -0,0 +1,161 @@
+#include "temp_history.h"
+#include <string.h>
+
+static inline uint16_t ring_pos(uint32_t seq) {
+    return (uint16_t)(seq % TEMP_HISTORY_CAPACITY);
+}
+
+static inline uint16_t queue_at(uint16_t head, uint16_t index) {
+    return (uint16_t)((head + index) % TEMP_HISTORY_CAPACITY);
+}
+
+static void window_reset(temp_history_window_t* w) {
+    w->count = 0;
+    w->sum = 0;
+    w->sumIndexed = 0;
+    w->minHead = w->minSize = 0;
+    w->maxHead = w->maxSize = 0;
+}
+
+// Paraugs ienāk loga jaunākajā galā
+static void window_enter(temp_history_window_t* w, const int16_t* samples, uint16_t pos) {
+    const int16_t value = samples[pos];
+
+    w->sumIndexed += (int64_t)w->count * value;
+    w->sum += value;
+    w->count++;
+
+    while (w->minSize > 0 && samples[w->minQueue[queue_at(w->minHead, w->minSize - 1)]] >= value) {
+        w->minSize--;
+    }
+    w->minQueue[queue_at(w->minHead, w->minSize++)] = pos;
+
+    while (w->maxSize > 0 && samples[w->maxQueue[queue_at(w->maxHead, w->maxSize - 1)]] <= value) {
+        w->maxSize--;
+    }
+    w->maxQueue[queue_at(w->maxHead, w->maxSize++)] = pos;
+}
+
+// Vecākais paraugs iziet no loga; pārējo indeksi samazinās par 1
+static void window_leave(temp_history_window_t* w, const int16_t* samples, uint16_t pos) {
+    w->sum -= samples[pos];
+    w->sumIndexed -= w->sum;
+    w->count--;
+
+    if (w->minSize > 0 && w->minQueue[w->minHead] == pos) {
+        w->minHead = queue_at(w->minHead, 1);
+        w->minSize--;
+    }
+    if (w->maxSize > 0 && w->maxQueue[w->maxHead] == pos) {
+        w->maxHead = queue_at(w->maxHead, 1);
+        w->maxSize--;
+    }
+}
+
+// Aizpilda logu no jau esošajiem paraugiem
+static void window_rebuild(temp_history_t* history, temp_history_window_t* w) {
+    window_reset(w);
+    if (history->total <= w->offset) {
+        return;
+    }
+    const uint32_t newest = history->total - 1 - w->offset;
+    const uint32_t oldest = newest + 1 >= w->length ? newest + 1 - w->length : 0;
+    for (uint32_t seq = oldest; seq <= newest; seq++) {
+        window_enter(w, history->samples, ring_pos(seq));
+    }
+}
+
+void temp_history_init(temp_history_t* history, uint16_t samplePeriodMs) {
+    memset(history, 0, sizeof(*history));
+    history->samplePeriodMs = samplePeriodMs > 0 ? samplePeriodMs : 1;
+}
+
+void temp_history_clear(temp_history_t* history) {
+    history->total = 0;
+    for (uint8_t i = 0; i < history->windowCount; i++) {
+        window_reset(&history->windows[i]);
+    }
+}
+
+void temp_history_push(temp_history_t* history, int16_t value) {
+    history->samples[ring_pos(history->total)] = value;
+    history->total++;
+
+    for (uint8_t i = 0; i < history->windowCount; i++) {
+        temp_history_window_t* w = &history->windows[i];
+        if (history->total <= w->offset) {
+            continue;
+        }
+        const uint32_t entering = history->total - 1 - w->offset;
+        if (w->count == w->length) {
+            window_leave(w, history->samples, ring_pos(entering - w->length));
+        }
+        window_enter(w, history->samples, ring_pos(entering));
+    }
+}
+
+int temp_history_add_window(temp_history_t* history, uint16_t length, uint16_t offset) {
+    if (history->windowCount >= TEMP_HISTORY_MAX_WINDOWS) {
+        return -1;
+    }
+    const int index = history->windowCount;
+    history->windowCount++;
+    if (!temp_history_set_window(history, index, length, offset)) {
+        history->windowCount--;
+        return -1;
+    }
+    return index;
+}
+
+bool temp_history_set_window(temp_history_t* history, int window, uint16_t length, uint16_t offset) {
+    // Izejošajam paraugam jābūt vēl buferī: offset + length < CAPACITY
+    if (window < 0 || window >= history->windowCount || length == 0 ||
+        (uint32_t)offset + length >= TEMP_HISTORY_CAPACITY) {
+        return false;
+    }
+    temp_history_window_t* w = &history->windows[window];
+    w->length = length;
+    w->offset = offset;
+    window_rebuild(history, w);
+    return true;
+}
+
+bool temp_history_window_stats(const temp_history_t* history, int window, temp_window_stats_t* out) {
+    if (window < 0 || window >= history->windowCount) {
+        return false;
+    }
+    const temp_history_window_t* w = &history->windows[window];
+    if (w->count == 0) {
+        return false;
+    }
+
+    const float n = (float)w->count;
+    out->count = w->count;
+    out->mean = (float)w->sum / n;
+    out->min = history->samples[w->minQueue[w->minHead]];
+    out->max = history->samples[w->maxQueue[w->maxHead]];
+
+    // Mazāko kvadrātu slīpums ar x = 0..n-1:
+    // (nΣxy - ΣxΣy) / (nΣx² - (Σx)²), kur saucējs = n²(n²-1)/12
+    if (w->count > 1) {
+        const double sumX = (double)w->count * (w->count - 1) / 2.0;
+        const double numerator = (double)w->count * (double)w->sumIndexed - sumX * (double)w->sum;
+        const double denominator = (double)w->count * w->count * ((double)w->count * w->count - 1.0) / 12.0;
+        out->slopePerS = (float)(numerator / denominator * 1000.0 / history->samplePeriodMs);
+    } else {
+        out->slopePerS = 0.0f;
+    }
+
+    return w->count == w->length;
+}
+
+uint16_t temp_history_samples_for_ms(const temp_history_t* history, unsigned long ms) {
+    unsigned long samples = ms / history->samplePeriodMs;
+    if (samples < 1) {
+        samples = 1;
+    }
+    if (samples > TEMP_HISTORY_CAPACITY - 1) {
+        samples = TEMP_HISTORY_CAPACITY - 1;
+    }
+    return (uint16_t)samples;
+}
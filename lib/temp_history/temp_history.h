@@ -0,0 +1,68 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Temp History - temperatūras vēstures gredzenbuferis ar logu statistiku
+ *
+ * Paraugi tiek pievienoti ar fiksētu periodu (regulatora solis), tāpēc
+ * loga garums paraugos atbilst laikam. Katram reģistrētajam logam
+ * statistika (vidējais, slīpums, min/max) tiek uzturēta pie katra
+ * temp_history_push(), un vaicājums izmaksā O(1):
+ *   - summa un indeksētā summa -> vidējais un mazāko kvadrātu slīpums
+ *   - monotonas rindas -> min/max
+ *
+ * Logs ir paraugu josla [offset, offset + length) skaitot no jaunākā,
+ * piem., "pēdējās 2 minūtes" (offset 0) un "2 minūtes pirms tam"
+ * (offset = 2 minūšu paraugi). Vērtību mērvienību nosaka izsaucējs.
+ */
+
+#define TEMP_HISTORY_CAPACITY    512   // Paraugi (~8.5 min pie 1 s perioda)
+#define TEMP_HISTORY_MAX_WINDOWS 4
+
+typedef struct {
+    uint16_t length;      // Loga garums paraugos
+    uint16_t offset;      // Cik jaunāko paraugu logs izlaiž
+    uint16_t count;       // Paraugi logā (< length, kamēr vēsture pildās)
+    int32_t sum;          // Σy
+    int64_t sumIndexed;   // Σ i*y, i = 0 vecākajam paraugam logā
+
+    // Monotonas rindas ar paraugu pozīcijām buferī (priekšā - min/max)
+    uint16_t minQueue[TEMP_HISTORY_CAPACITY];
+    uint16_t maxQueue[TEMP_HISTORY_CAPACITY];
+    uint16_t minHead, minSize;
+    uint16_t maxHead, maxSize;
+} temp_history_window_t;
+
+typedef struct {
+    int16_t samples[TEMP_HISTORY_CAPACITY];
+    uint32_t total;              // Visu laiku pievienoto paraugu skaits
+    uint16_t samplePeriodMs;
+    uint8_t windowCount;
+    temp_history_window_t windows[TEMP_HISTORY_MAX_WINDOWS];
+} temp_history_t;
+
+typedef struct {
+    uint16_t count;
+    float mean;
+    float slopePerS;      // Vērtības vienības sekundē
+    int16_t min;
+    int16_t max;
+} temp_window_stats_t;
+
+void temp_history_init(temp_history_t* history, uint16_t samplePeriodMs);
+void temp_history_push(temp_history_t* history, int16_t value);
+void temp_history_clear(temp_history_t* history);
+
+// Atgriež loga indeksu vai -1, ja logu vairs nevar pievienot vai
+// offset + length nesatilpst buferī
+int temp_history_add_window(temp_history_t* history, uint16_t length, uint16_t offset);
+
+// Maina loga izmērus; statistiku pārrēķina no bufera (O(length))
+bool temp_history_set_window(temp_history_t* history, int window, uint16_t length, uint16_t offset);
+
+// Loga statistika. Atgriež false, ja logs vēl nav pilns (out tiek
+// aizpildīts, ja logā ir vismaz viens paraugs).
+bool temp_history_window_stats(const temp_history_t* history, int window, temp_window_stats_t* out);
+
+// Laiks (ms) -> paraugi pēc history->samplePeriodMs, ierobežots ar buferi
+uint16_t temp_history_samples_for_ms(const temp_history_t* history, unsigned long ms);
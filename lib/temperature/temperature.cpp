@@ -1,15 +1,12 @@
 #include "temperature.h"
-#include <OneWire.h>
-#include <DallasTemperature.h>
+#include "temperature_sensor.h"
 #include "damper_control.h"
 #include "display_manager.h"  // Add display manager
-#include "telnet.h"
+#include "logger.h"
+#include "controller_state.h"
 
 
 
-// Karogs, kas norāda, ka nepieciešams veikt damper aprēķinu, kad servo beidzis kustību
-static bool damperCalcPending = false;
-
 int temperature = 0;
 int targetTempC = 66;
 int maxTemp = 80; // Maximum temperature for the target
@@ -17,13 +14,15 @@ int temperatureMin = 46; // Minimum temperature to avoid negative values
 int temperaturemini2 = 64; // Maximum temperature for the sensor
 int warningTemperature = 85; // Brīdinājuma temperatūras slieksnis
 unsigned long tempReadIntervalMs = 4000; // Noklusējuma vērtība 4 sekundes (4000ms)
-static OneWire oneWire(6);
-static DallasTemperature ds(&oneWire);
-static DeviceAddress sensor1 = {0x28, 0xFC, 0x70, 0x96, 0xF0, 0x01, 0x3C, 0xC0};
-
-static unsigned long lastTempRead = 0;
-static unsigned long tempRequestTime = 0;
-static bool tempRequested = false;
+int temperatureResolutionBits = 12;           // 0.0625 °C solis, 750 ms konversija
+// Kanālu adreses; nulles adrese = kanāls nav piesaistīts
+uint8_t temperatureChannelAddress[TEMP_CHANNEL_COUNT][8] = {
+    {0x28, 0xFC, 0x70, 0x96, 0xF0, 0x01, 0x3C, 0xC0},   // Dūmgāzu sensors
+    {0},
+    {0},
+};
+int temperatureMedianLength = 3;
+unsigned long temperatureFilterTauMs = 8000;
 
 // Change detection variables
 static int lastDisplayedTemperature = -999;  // Force first update
@@ -31,28 +30,58 @@ static unsigned long lastChangeTime = 0;
 static bool temperatureChanged = false;
 
 void initTemperatureSensor() {
-    ds.begin();
-    ds.setResolution(sensor1, 9);
+    // Kopnes apmaiņa notiek SensorTask, loop() tikai saņem gatavus rādījumus
+    startTemperatureSensorTask();
 }
 
-void updateTemperature() {
-    if (!tempRequested && millis() - lastTempRead >= tempReadIntervalMs) {
-        ds.requestTemperaturesByAddress(sensor1);
-        tempRequestTime = millis();
-        tempRequested = true;
+// Statusa rinda ar pašreizējo PID sadalījumu (DEBUG - pēc noklusējuma tikai
+// telnet, lai nepārpildītu flash žurnālu). Vērtības ņem no regulatora
+// momentuzņēmuma, lai tās būtu no viena soļa
+static void printControlStatus(const char* tag) {
+    if (LOG_LEVEL_DEBUG > LOG_LEVEL || !loggerEnabled(LOG_LEVEL_DEBUG)) {
+        return;
     }
+    controller_state_t state;
+    controller_state_read(&state);
 
-    if (tempRequested && millis() - tempRequestTime >= 100) {
-        int newTemperature = ds.getTempC(sensor1);
-        if (newTemperature < 0) {
-            newTemperature = 5;
+    // Viena rinda steka buferī; daļas, kuru nav, paliek tukšas
+    char room[48] = "";
+    if (state.channelValidMask & (1 << TEMP_CHANNEL_ROOM)) {
+        int length = snprintf(room, sizeof(room), " | Room: %.2f°C", state.channelC[TEMP_CHANNEL_ROOM]);
+        if (state.cascadeActive && length > 0 && length < (int)sizeof(room)) {
+            snprintf(room + length, sizeof(room) - length, " -> %.2f°C", state.roomTargetC);
+        }
+    }
+
+    // Paradam aprekinu tikai ja tas ir veikts (ja temperature ir starp min un target)
+    char terms[96] = "";
+    if (state.temperature > temperatureMin && state.temperature < state.targetTemp) {
+        snprintf(terms, sizeof(terms), " = P(%.2f) + I(%.2f) + D(%.2f) + FF(%.2f) | errI(%.2f)",
+                 state.pTerm, state.iTerm, state.dTerm, state.ffTerm, state.errI);
+    }
+
+    LOG_DEBUG("status", "%s - Temp: %.2f°C | Target: %d°C | Min: %d°C | Mode: %s | Damper: %d%% | Read Interval: %lums"
+             " | Fire: %s (%.2f C/min)%s%s",
+             tag, state.temperature, state.targetTemp, temperatureMin, damper_mode_label(state.mode), state.damper,
+             tempReadIntervalMs, fire_phase_label(state.firePhase), state.trendCPerMin, room, terms);
+}
+
+void updateTemperature() {
+    temperature_sample_t sample;
+    if (temperatureSensorReceive(&sample)) {
+        // Kontroles uzdevums rādījumu jau saņēma no SensorTask, šeit tikai displejs.
+        // Vesels grāds mainās tikai ārpus histerēzes joslas, lai 12 bitu
+        // rādījums, kas svārstās ap x.5 °C, nepārzīmē ekrānu katrā nolasījumā
+        int16_t flueC16 = sample.channelC16[TEMP_CHANNEL_FLUE];
+        int newTemperature = lastDisplayedTemperature;
+        int offsetC16 = flueC16 - lastDisplayedTemperature * TEMP_C16_SCALE;
+        if (abs(offsetC16) >= TEMP_C16_SCALE / 2 + TEMP_DISPLAY_HYSTERESIS_C16) {
+            newTemperature = (flueC16 + TEMP_C16_SCALE / 2) / TEMP_C16_SCALE;
         }
-        
-        // Atjauninām temperatūru vienmēr
-        temperature = newTemperature;
         
         // Check if temperature actually changed
         if (newTemperature != lastDisplayedTemperature) {
+            temperature = newTemperature;
             lastDisplayedTemperature = temperature;
             lastChangeTime = millis();
             temperatureChanged = true;
@@ -60,132 +89,16 @@ void updateTemperature() {
             // Notify display manager that temperature changed
             display_manager_notify_temperature_changed();
             
-            // Ja temperatūra mainījusies un servo nav kustībā, izpildām damper aprēķinu uzreiz
-            if (!servoMoving) {
-                damperControlLoop();
-                
-                // Uzlabots Telnet izvads ar skaidraku informaciju
-                Telnet.print("TEMP_CHANGED - Temp: ");
-                Telnet.print(temperature);
-                Telnet.print("°C | Target: ");
-                Telnet.print(targetTempC);
-                Telnet.print("°C | Min: ");
-                Telnet.print(temperatureMin);
-                Telnet.print("°C | Mode: ");
-                Telnet.print(messageDamp);
-                Telnet.print(" | Damper: ");
-                Telnet.print(damper);
-                Telnet.print("%");
-                Telnet.print(" | Read Interval: ");
-                Telnet.print(tempReadIntervalMs);
-                Telnet.print("ms");
-
-
-                // Paradam aprekinu tikai ja tas ir veikts (ja temperature ir starp min un target)
-                if (temperature > temperatureMin && temperature < targetTempC) {
-                    Telnet.print(" = kP(");
-                    Telnet.print(kP);
-                    Telnet.print(") * errP(");
-                    Telnet.print(errP);
-                    Telnet.print(") + kI(");
-                    Telnet.print(kI, 5);
-                    Telnet.print(") * errI(");
-                    Telnet.print(errI);
-                    Telnet.print(") + kD(");
-                    Telnet.print(kD);
-                    Telnet.print(") * errD(");
-                    Telnet.print(errD);
-                    Telnet.print(")");
-                }
-                Telnet.println("");
-                
-                damperCalcPending = false; // Atiestatām gaidīšanas karogu, jo aprēķins ir veikts
-            } else {
-                // Ja servo ir kustībā, atzīmējam, ka aprēķins ir nepieciešams
-                damperCalcPending = true;
-            }
+            printControlStatus("TEMP_CHANGED");
         }
-        
-        lastTempRead = millis();
-        tempRequested = false;
     }
     
-    // ĀRPUS if bloka: Ja ir zemas temperatūras režīms, izpildam damper aprēķinu ik pēc 30 sekundēm
+    // Zemas temperatūras režīmā rādām statusu ik pēc 30 sekundēm
     static unsigned long lastLowTempUpdate = 0;
     if (lowTempCheckActive && millis() - lastLowTempUpdate >= 30000) {
-        damperControlLoop();
-        
-        Telnet.print("LOW_TEMP_30SEC - Temp: ");
-        Telnet.print(temperature);
-        Telnet.print("C | Target: ");
-        Telnet.print(targetTempC);
-        Telnet.print("C | Min: ");
-        Telnet.print(temperatureMin);
-        Telnet.print("C | Mode: ");
-        Telnet.print(messageDamp);
-        Telnet.print(" | Damper: ");
-        Telnet.print(damper);
-        Telnet.print("%");
-        Telnet.print(" | Read Interval: ");
-        Telnet.print(tempReadIntervalMs);
-        Telnet.print("ms");
-        
-        if (temperature > temperatureMin && temperature < targetTempC) {
-            Telnet.print(" = kP(");
-            Telnet.print(kP);
-            Telnet.print(") * errP(");
-            Telnet.print(errP);
-            Telnet.print(") + kI(");
-            Telnet.print(kI, 5);
-            Telnet.print(") * errI(");
-            Telnet.print(errI);
-            Telnet.print(") + kD(");
-            Telnet.print(kD);
-            Telnet.print(") * errD(");
-            Telnet.print(errD);
-            Telnet.print(")");
-        }
-        Telnet.println("");
-        
+        printControlStatus("LOW_TEMP_30SEC");
         lastLowTempUpdate = millis(); // Atiestatām 30 sekunžu timeri
     }
-    
-    // Apstrādām pending damper aprēķinus (kad servo beidz kustību)
-    if (damperCalcPending && !servoMoving) {
-        damperControlLoop();
-        
-        Telnet.print("SERVO_FINISHED - Temp: ");
-        Telnet.print(temperature);
-        Telnet.print("°C | Target: ");
-        Telnet.print(targetTempC);
-        Telnet.print("°C | Min: ");
-        Telnet.print(temperatureMin);
-        Telnet.print("°C | Mode: ");
-        Telnet.print(messageDamp);
-        Telnet.print(" | Damper: ");
-        Telnet.print(damper);
-        Telnet.print("%");
-        
-        if (temperature > temperatureMin && temperature < targetTempC) {
-            Telnet.print(" = kP(");
-            Telnet.print(kP);
-            Telnet.print(") * errP(");
-            Telnet.print(errP);
-            Telnet.print(") + kI(");
-            Telnet.print(kI, 5);
-            Telnet.print(") * errI(");
-            Telnet.print(errI);
-            Telnet.print(") + kD(");
-            Telnet.print(kD);
-            Telnet.print(") * errD(");
-            Telnet.print(errD);
-            Telnet.print(")");
-        }
-        Telnet.println("");
-        
-        damperCalcPending = false; // Atiestatām gaidīšanas karogu
-    }
-
 }
 
 // New function to check if temperature has changed
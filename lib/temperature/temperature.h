@@ -1,5 +1,6 @@
 #pragma once
 #include <Arduino.h>
+#include "controller_state.h"
 
 void initTemperatureSensor();
 void updateTemperature();
@@ -14,4 +15,14 @@ extern int temperatureMin;
 extern int temperaturemini2; // Maximum temperature for the sensor
 extern int maxTemp; // Maximum temperature for the target
 extern int warningTemperature; // Brīdinājuma temperatūras slieksnis
-extern unsigned long tempReadIntervalMs; // Read interval in milliseconds
\ No newline at end of file
+extern unsigned long tempReadIntervalMs; // Read interval in milliseconds
+
+// Sensora izšķirtspēja un filtrs (sk. temperature_sensor.h, temp_filter.h)
+extern int temperatureResolutionBits;        // 9..12 biti: 93.75..750 ms konversija
+extern int temperatureMedianLength;          // 1, 3 vai 5 rādījumi
+extern unsigned long temperatureFilterTauMs; // EMA laika konstante, 0 = izslēgts
+extern uint8_t temperatureChannelAddress[TEMP_CHANNEL_COUNT][8];  // OneWire adreses (NVS)
+
+// Displeja rādījums (vesels grāds) mainās tikai, ja filtrētā vērtība
+// iziet ārpus noapaļošanas robežas vēl par šo joslu (°C × 16)
+#define TEMP_DISPLAY_HYSTERESIS_C16 4
\ No newline at end of file
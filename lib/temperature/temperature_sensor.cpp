@@ -0,0 +1,493 @@
+#include "temperature_sensor.h"
+#include <OneWire.h>
+#include <DallasTemperature.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include "temperature.h"
+#include "temp_filter.h"
+
+static OneWire oneWire(6);
+static DallasTemperature ds(&oneWire);
+
+// Kanāla stāvoklis; pieder SensorTask
+typedef struct {
+    uint8_t address[8];
+    bool assigned;              // Adrese nav nulles
+    bool present;               // Adrese atrasta pēdējā skenēšanā
+    bool valid;                 // Ir derīgs rādījums
+    bool resolutionApplied;
+    uint8_t resolution;         // Sensorā iestatītā
+    temp_filter_t filter;
+    unsigned long lastFilteredMs;
+    int16_t rawC16;
+    int16_t filteredC16;
+} sensor_channel_t;
+
+typedef enum : uint8_t {
+    SENSOR_IDLE = 0,
+    SENSOR_CONVERTING,
+} sensor_state_t;
+
+static sensor_channel_t channels[TEMP_CHANNEL_COUNT];
+static uint8_t deviceAddresses[SENSOR_MAX_DEVICES][8];
+static uint8_t deviceCount = 0;
+static volatile bool scanRequested = false;
+static volatile bool channelsChanged = false;
+
+static sensor_state_t sensorState = SENSOR_IDLE;
+static unsigned long nextRequestMs = 0;
+static unsigned long conversionStartMs = 0;
+static temperature_sensor_stats_t sensorStats = {0};
+
+// Viena vieta: loop() vajag tikai jaunāko kārtu
+static QueueHandle_t loopSampleQueue = NULL;
+TaskHandle_t sensorTaskHandle = NULL;
+
+static bool addressIsZero(const uint8_t* address) {
+    for (int i = 0; i < 8; i++) {
+        if (address[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool deviceOnBus(const uint8_t* address) {
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        if (memcmp(deviceAddresses[i], address, 8) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void bindChannel(sensor_channel_t* channel, const uint8_t* address) {
+    if (memcmp(channel->address, address, 8) != 0) {
+        // Cits sensors - vecā vēsture uz to neattiecas
+        memcpy(channel->address, address, 8);
+        temp_filter_reset(&channel->filter);
+        channel->valid = false;
+        channel->resolution = 12;   // DS18B20 noklusējums pēc ieslēgšanas
+    }
+    channel->assigned = !addressIsZero(address);
+    channel->present = channel->assigned && deviceOnBus(address);
+    channel->resolutionApplied = false;
+}
+
+// Kanālu adreses no iestatījumiem -> SensorTask kopija
+static void resolveChannels() {
+    for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+        bindChannel(&channels[ch], temperatureChannelAddress[ch]);
+    }
+
+    // Dūmgāzu sensors nomainīts: vienīgais sensors kopnē, kas nav citam kanālam
+    sensor_channel_t* flue = &channels[TEMP_CHANNEL_FLUE];
+    if (!flue->present && deviceCount == 1) {
+        bool usedElsewhere = false;
+        for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+            if (ch != TEMP_CHANNEL_FLUE && memcmp(channels[ch].address, deviceAddresses[0], 8) == 0) {
+                usedElsewhere = true;
+            }
+        }
+        if (!usedElsewhere) {
+            bindChannel(flue, deviceAddresses[0]);
+        }
+    }
+}
+
+static void scanBus() {
+    ds.begin();
+    uint8_t count = ds.getDeviceCount();
+    deviceCount = 0;
+    for (uint8_t i = 0; i < count && deviceCount < SENSOR_MAX_DEVICES; i++) {
+        if (ds.getAddress(deviceAddresses[deviceCount], i)) {
+            deviceCount++;
+        }
+    }
+    sensorStats.scans++;
+    sensorStats.devicesFound = deviceCount;
+    resolveChannels();
+}
+
+// Izšķirtspēju un filtru var mainīt telnet vai iestatījumi; sensoros to
+// ierakstām tikai starp konversijām
+static void applySensorConfig() {
+    uint8_t bits = (uint8_t)constrain(temperatureResolutionBits, 9, 12);
+    for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+        sensor_channel_t* channel = &channels[ch];
+        temp_filter_configure(&channel->filter, (uint8_t)temperatureMedianLength, temperatureFilterTauMs);
+        if (!channel->present) {
+            continue;
+        }
+        if ((!channel->resolutionApplied || channel->resolution != bits) &&
+            ds.setResolution(channel->address, bits)) {
+            channel->resolution = bits;
+            channel->resolutionApplied = true;
+        }
+    }
+}
+
+static void publishRound(unsigned long timestampMs) {
+    temperature_sample_t sample;
+    memset(&sample, 0, sizeof(sample));
+    for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+        sample.channelC16[ch] = channels[ch].filteredC16;
+        sample.rawC16[ch] = channels[ch].rawC16;
+        if (channels[ch].valid) {
+            sample.validMask |= (uint8_t)(1 << ch);
+        } else if (channels[ch].assigned || ch == TEMP_CHANNEL_FLUE) {
+            sensorStats.channels[ch].failsafeSamples++;
+        }
+    }
+    sample.timestampMs = timestampMs;
+
+    damperControlPostSample(&sample);
+    if (loopSampleQueue != NULL) {
+        xQueueOverwrite(loopSampleQueue, &sample);
+    }
+    sensorStats.lastSampleMs = timestampMs;
+}
+
+static void channelFailure(int ch) {
+    sensor_channel_t* channel = &channels[ch];
+    temperature_channel_stats_t* stats = &sensorStats.channels[ch];
+    stats->consecutiveFailures++;
+    if (stats->consecutiveFailures < SENSOR_FAILSAFE_AFTER) {
+        return;   // Līdz tam paliek iepriekšējais rādījums
+    }
+
+    channel->valid = false;
+    temp_filter_reset(&channel->filter);
+    if (ch == TEMP_CHANNEL_FLUE) {
+        // Tāpat kā agrāk pie DEVICE_DISCONNECTED_C - regulators redz aukstu krāsni
+        channel->rawC16 = SENSOR_FAILSAFE_TEMP * TEMP_C16_SCALE;
+        channel->filteredC16 = channel->rawC16;
+    }
+}
+
+static void readChannel(int ch, unsigned long nowMs) {
+    sensor_channel_t* channel = &channels[ch];
+    temperature_channel_stats_t* stats = &sensorStats.channels[ch];
+
+    ScratchPad scratch;
+    if (!channel->present || !ds.readScratchPad(channel->address, scratch)) {
+        stats->presenceErrors++;
+        channelFailure(ch);
+        return;
+    }
+    if (OneWire::crc8(scratch, 8) != scratch[8]) {
+        stats->crcErrors++;
+        channelFailure(ch);
+        return;
+    }
+
+    // Neapstrādātā vērtība jau ir °C × 16; zemākas izšķirtspējas
+    // nenoteiktos bitus nodzēšam, kā to dara DallasTemperature
+    int16_t rawC16 = (int16_t)(scratch[0] | (scratch[1] << 8));
+    rawC16 &= (int16_t)~((1 << (12 - channel->resolution)) - 1);
+    if (rawC16 < 0 && ch == TEMP_CHANNEL_FLUE) {
+        rawC16 = 5 * TEMP_C16_SCALE;
+    }
+
+    uint32_t dtMs = nowMs - channel->lastFilteredMs;
+    channel->lastFilteredMs = nowMs;
+    channel->rawC16 = rawC16;
+    channel->filteredC16 = temp_filter_update(&channel->filter, rawC16, dtMs);
+    channel->valid = true;
+
+    stats->conversions++;
+    stats->consecutiveFailures = 0;
+}
+
+static void startConversion(unsigned long nowMs) {
+    // Visi sensori konvertē vienlaicīgi (SKIP ROM + CONVERT T)
+    unsigned long busStartUs = micros();
+    ds.requestTemperatures();
+    uint32_t busUs = micros() - busStartUs;
+    sensorStats.lastRequestBusUs = busUs;
+    if (busUs > sensorStats.maxRequestBusUs) {
+        sensorStats.maxRequestBusUs = busUs;
+    }
+    sensorStats.rounds++;
+    conversionStartMs = nowMs;
+    sensorState = SENSOR_CONVERTING;
+}
+
+static void finishRound(unsigned long nowMs, bool converted) {
+    if (converted) {
+        uint32_t conversionMs = nowMs - conversionStartMs;
+        sensorStats.lastConversionMs = conversionMs;
+        if (sensorStats.minConversionMs == 0 || conversionMs < sensorStats.minConversionMs) {
+            sensorStats.minConversionMs = conversionMs;
+        }
+        if (conversionMs > sensorStats.maxConversionMs) {
+            sensorStats.maxConversionMs = conversionMs;
+        }
+    }
+
+    unsigned long busStartUs = micros();
+    for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+        // Dūmgāzes vienmēr - bez sensora regulatoram jāsaņem drošā vērtība
+        if (!channels[ch].assigned && ch != TEMP_CHANNEL_FLUE) {
+            continue;
+        }
+        if (converted) {
+            readChannel(ch, nowMs);
+        } else {
+            channelFailure(ch);
+        }
+    }
+    uint32_t busUs = micros() - busStartUs;
+    sensorStats.lastReadBusUs = busUs;
+    if (busUs > sensorStats.maxReadBusUs) {
+        sensorStats.maxReadBusUs = busUs;
+    }
+
+    publishRound(nowMs);
+
+    // Dūmgāzu kļūda: ātrāks atkārtojums, bet pēc drošās vērtības - pārskenējam
+    // kopni (sensors varēja būt nomainīts) un gaidām parasto intervālu
+    uint32_t flueFailures = sensorStats.channels[TEMP_CHANNEL_FLUE].consecutiveFailures;
+    if (flueFailures == 0) {
+        nextRequestMs = conversionStartMs + tempReadIntervalMs;
+    } else if (flueFailures < SENSOR_FAILSAFE_AFTER) {
+        nextRequestMs = nowMs + SENSOR_RETRY_MS;
+    } else {
+        scanRequested = true;
+        nextRequestMs = nowMs + tempReadIntervalMs;
+    }
+    sensorState = SENSOR_IDLE;
+}
+
+uint32_t temperatureSensorTaskStep() {
+    unsigned long nowMs = millis();
+
+    switch (sensorState) {
+        case SENSOR_IDLE: {
+            // Skenēšana un kanālu piesaiste - uzreiz pēc pieprasījuma (kopne brīva),
+            // tukšas kopnes pārskenēšana - ar kārtas ritmu
+            const bool due = (long)(nowMs - nextRequestMs) >= 0;
+            if (scanRequested || (due && deviceCount == 0)) {
+                scanRequested = false;
+                channelsChanged = false;
+                scanBus();
+            } else if (channelsChanged) {
+                channelsChanged = false;
+                resolveChannels();
+            }
+            if (due) {
+                applySensorConfig();
+                startConversion(nowMs);
+            }
+            break;
+        }
+
+        case SENSOR_CONVERTING: {
+            uint8_t bits = (uint8_t)constrain(temperatureResolutionBits, 9, 12);
+            if (ds.isConversionComplete()) {
+                finishRound(nowMs, true);
+            } else if (nowMs - conversionStartMs > 2UL * ds.millisToWaitForConversion(bits)) {
+                sensorStats.timeouts++;
+                finishRound(nowMs, false);
+            }
+            break;
+        }
+    }
+
+    if (sensorState == SENSOR_CONVERTING) {
+        return SENSOR_TASK_PERIOD_MS;
+    }
+    const long waitMs = (long)(nextRequestMs - millis());
+    return waitMs > 0 ? (uint32_t)waitMs : SENSOR_TASK_PERIOD_MS;
+}
+
+/**
+ * FreeRTOS sensora uzdevums: kopnes apmaiņa notiek šeit, nevis loop()
+ * Prioritāte zem ControlTask, lai regulatora periods paliek precīzs.
+ * Konversijas laikā pārbauda ik pēc SENSOR_TASK_PERIOD_MS, starp kārtām
+ * guļ līdz nākamajai (skenēšanas pieprasījums pamodina agrāk)
+ */
+void SensorTask(void *pvParameters) {
+    while (1) {
+        const uint32_t waitMs = temperatureSensorTaskStep();
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+    }
+}
+
+void startTemperatureSensorTask() {
+    // requestTemperatures() atgriežas uzreiz, beigas pārbaudām paši
+    ds.setWaitForConversion(false);
+
+    memset(channels, 0, sizeof(channels));
+    for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+        temp_filter_init(&channels[ch].filter, (uint8_t)temperatureMedianLength, temperatureFilterTauMs);
+        channels[ch].resolution = 12;
+    }
+    scanBus();
+    applySensorConfig();
+
+    loopSampleQueue = xQueueCreate(1, sizeof(temperature_sample_t));
+    sensorState = SENSOR_IDLE;
+    nextRequestMs = millis();
+
+    xTaskCreatePinnedToCore(
+        SensorTask,          // Uzdevuma funkcija
+        "SensorTask",        // Uzdevuma nosaukums
+        3072,                // Steka izmērs
+        NULL,                // Parametri (nav)
+        2,                   // Prioritāte (starp loop() un ControlTask)
+        &sensorTaskHandle,   // Uzdevuma rokturis
+        1                    // Kodola numurs (1 = otrs kodols)
+    );
+}
+
+bool temperatureSensorReceive(temperature_sample_t* sample) {
+    if (loopSampleQueue == NULL) {
+        return false;
+    }
+    return xQueueReceive(loopSampleQueue, sample, 0) == pdTRUE;
+}
+
+void temperatureSensorRequestScan() {
+    scanRequested = true;
+    if (sensorTaskHandle != NULL) {
+        xTaskNotifyGive(sensorTaskHandle);
+    }
+}
+
+void temperatureSensorChannelsChanged() {
+    channelsChanged = true;
+    if (sensorTaskHandle != NULL) {
+        xTaskNotifyGive(sensorTaskHandle);
+    }
+}
+
+uint8_t temperatureSensorDeviceCount() {
+    return deviceCount;
+}
+
+bool temperatureSensorDeviceAddress(uint8_t index, uint8_t address[8]) {
+    if (index >= deviceCount) {
+        return false;
+    }
+    memcpy(address, deviceAddresses[index], 8);
+    return true;
+}
+
+temperature_sensor_stats_t temperatureSensorGetStats() {
+    return sensorStats;
+}
+
+void temperatureSensorResetStats() {
+    temperature_sensor_stats_t fresh;
+    memset(&fresh, 0, sizeof(fresh));
+    // Stāvoklis, nevis statistika - paliek
+    fresh.devicesFound = sensorStats.devicesFound;
+    fresh.lastSampleMs = sensorStats.lastSampleMs;
+    for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+        fresh.channels[ch].consecutiveFailures = sensorStats.channels[ch].consecutiveFailures;
+    }
+    sensorStats = fresh;
+}
+
+static void printAddress(Print &out, const uint8_t* address) {
+    for (int i = 0; i < 8; i++) {
+        if (address[i] < 0x10) {
+            out.print("0");
+        }
+        out.print(address[i], HEX);
+    }
+}
+
+void temperatureSensorPrintStats(Print &out) {
+    temperature_sensor_stats_t stats = temperatureSensorGetStats();
+    uint8_t bits = (uint8_t)constrain(temperatureResolutionBits, 9, 12);
+    out.println("DS18B20 sensoru statistika:");
+    out.print("  Izskirtspeja: ");
+    out.print(bits);
+    out.print(" biti (");
+    out.print(ds.millisToWaitForConversion(bits));
+    out.print(" ms konversija), intervals ");
+    out.print(tempReadIntervalMs);
+    out.println(" ms");
+    out.print("  Filtrs: mediana ");
+    out.print(channels[TEMP_CHANNEL_FLUE].filter.medianLength);
+    out.print(", EMA tau ");
+    out.print(temperatureFilterTauMs);
+    out.println(" ms");
+
+    out.print("  Kopne: ");
+    out.print(stats.devicesFound);
+    out.print(" sensori (skenesanas: ");
+    out.print(stats.scans);
+    out.println(")");
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        out.print("    [");
+        out.print(i);
+        out.print("] ");
+        printAddress(out, deviceAddresses[i]);
+        for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+            if (channels[ch].assigned && memcmp(channels[ch].address, deviceAddresses[i], 8) == 0) {
+                out.print(" -> ");
+                out.print(temp_channel_label((temp_channel_t)ch));
+            }
+        }
+        out.println("");
+    }
+
+    for (int ch = 0; ch < TEMP_CHANNEL_COUNT; ch++) {
+        const sensor_channel_t* channel = &channels[ch];
+        const temperature_channel_stats_t* cs = &stats.channels[ch];
+        out.print("  ");
+        out.print(temp_channel_label((temp_channel_t)ch));
+        out.print(": ");
+        if (!channel->assigned) {
+            out.println("nav piesaistits");
+            continue;
+        }
+        if (channel->valid) {
+            out.print(channel->filteredC16 / (float)TEMP_C16_SCALE);
+            out.print(" C (neapstradats ");
+            out.print(channel->rawC16 / (float)TEMP_C16_SCALE);
+            out.print(" C)");
+        } else {
+            out.print(channel->present ? "nav deriga radijuma" : "nav atrasts kopne");
+        }
+        out.print(" | ok ");
+        out.print(cs->conversions);
+        out.print(", CRC ");
+        out.print(cs->crcErrors);
+        out.print(", neatbild ");
+        out.print(cs->presenceErrors);
+        out.print(", nederigi ");
+        out.print(cs->failsafeSamples);
+        out.print(", pec kartas ");
+        out.println(cs->consecutiveFailures);
+    }
+
+    out.print("  Kartas: ");
+    out.print(stats.rounds);
+    out.print(", taimauts: ");
+    out.println(stats.timeouts);
+    out.print("  Konversija pedeja/min/max: ");
+    out.print(stats.lastConversionMs);
+    out.print(" / ");
+    out.print(stats.minConversionMs);
+    out.print(" / ");
+    out.print(stats.maxConversionMs);
+    out.println(" ms");
+    out.print("  Kopne CONVERT T pedejais/max: ");
+    out.print(stats.lastRequestBusUs);
+    out.print(" / ");
+    out.print(stats.maxRequestBusUs);
+    out.println(" us");
+    out.print("  Kopne nolasisana (visi kanali) pedeja/max: ");
+    out.print(stats.lastReadBusUs);
+    out.print(" / ");
+    out.print(stats.maxReadBusUs);
+    out.println(" us");
+    out.print("  Pedeja karta pirms: ");
+    out.print(millis() - stats.lastSampleMs);
+    out.println(" ms");
+}
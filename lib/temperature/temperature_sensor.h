@@ -0,0 +1,83 @@
+#pragma once
+#include <Arduino.h>
+#include "damper_control.h"
+
+/**
+ * Temperature Sensor - DS18B20 kopnes nolasīšana atsevišķā FreeRTOS uzdevumā
+ *
+ * Uz OneWire kopnes var būt vairāki sensori (dūmgāzes, istaba, ūdens
+ * apvalks). Viena kārta, bez bloķējošām gaidīšanām:
+ *   IDLE --tempReadIntervalMs--> CONVERT T visiem (SKIP ROM)
+ *        --isConversionComplete()--> READ katram piesaistītajam kanālam
+ * Konversija notiek visos sensoros vienlaicīgi, tāpēc papildu sensors
+ * pievieno tikai vienu scratchpad nolasījumu (~12 ms), nevis vēl 750 ms.
+ *
+ * READ pārbauda CRC, izlaiž katra kanāla rādījumu caur savu temp_filter
+ * (mediāna + EMA) un publicē visu kārtu °C × 16 ar laika zīmogu gan
+ * kontroles uzdevumam (damperControlPostSample), gan loop() rindā, no
+ * kuras updateTemperature() ņem bez gaidīšanas. OneWire kopne nekad
+ * neaiztur loop() (LVGL, telnet, OTA).
+ *
+ * Kanālu adreses glabājas NVS (temperatureChannelAddress). Ja dūmgāzu
+ * adrese uz kopnes nav atrasta, bet kopnē ir tieši viens sensors, to
+ * izmanto dūmgāzēm (sensora nomaiņa bez telnet).
+ *
+ * Pēc SENSOR_FAILSAFE_AFTER neveiksmēm pēc kārtas kanāls kļūst nederīgs;
+ * dūmgāzēm tiek publicēta SENSOR_FAILSAFE_TEMP (agrākā -127 -> 5 °C
+ * uzvedība), lai regulators pārietu zemas temperatūras režīmā.
+ */
+
+#define SENSOR_TASK_PERIOD_MS    10    // Konversijas beigu pārbaudes periods
+#define SENSOR_RETRY_MS          250   // Atkārtots mēģinājums pēc dūmgāzu kļūdas
+#define SENSOR_FAILSAFE_AFTER    3     // Neveiksmes pēc kārtas līdz nederīgam kanālam
+#define SENSOR_FAILSAFE_TEMP     5
+#define SENSOR_MAX_DEVICES       8     // Skenēšanā atrastās adreses
+
+typedef struct {
+    uint32_t conversions;          // Veiksmīgi nolasījumi
+    uint32_t crcErrors;            // Scratchpad CRC nesakrīt
+    uint32_t presenceErrors;       // Kopnē neviens neatbild vai adrese nav atrasta
+    uint32_t failsafeSamples;      // Kārtas, kurās kanāls publicēts kā nederīgs
+    uint32_t consecutiveFailures;
+} temperature_channel_stats_t;
+
+typedef struct {
+    uint32_t rounds;               // CONVERT T kārtas
+    uint32_t timeouts;             // Konversija nebeidzās 2x datu lapas laikā
+    uint32_t scans;
+    uint8_t devicesFound;          // Pēdējā skenēšanā
+    uint32_t lastConversionMs;     // CONVERT T -> isConversionComplete()
+    uint32_t minConversionMs;
+    uint32_t maxConversionMs;
+    uint32_t lastRequestBusUs;     // Kopnes aizņemtība CONVERT T
+    uint32_t maxRequestBusUs;
+    uint32_t lastReadBusUs;        // ... un visu kanālu nolasīšanai
+    uint32_t maxReadBusUs;
+    unsigned long lastSampleMs;
+    temperature_channel_stats_t channels[TEMP_CHANNEL_COUNT];
+} temperature_sensor_stats_t;
+
+extern TaskHandle_t sensorTaskHandle;   // Paziņojums: skenēšana / kanālu maiņa
+
+// Inicializē kopni, skenē sensorus un palaiž SensorTask
+void startTemperatureSensorTask();
+
+// Viena uzdevuma iterācija. Atgriež, pēc cik ms vajadzīga nākamā:
+// konversijas laikā SENSOR_TASK_PERIOD_MS, citādi līdz nākamajai kārtai
+uint32_t temperatureSensorTaskStep();
+
+// Jaunākā kārta loop() vajadzībām; false, ja kopš pēdējā izsaukuma jaunas nav
+bool temperatureSensorReceive(temperature_sample_t* sample);
+
+// Kopni pārskenē un kanālus piesaista SensorTask (pamodina to, ja guļ)
+void temperatureSensorRequestScan();
+void temperatureSensorChannelsChanged();   // temperatureChannelAddress mainīts
+
+// Pēdējās skenēšanas rezultāts
+uint8_t temperatureSensorDeviceCount();
+bool temperatureSensorDeviceAddress(uint8_t index, uint8_t address[8]);
+
+// Sensora statistika (telnet komanda "sensor")
+temperature_sensor_stats_t temperatureSensorGetStats();
+void temperatureSensorResetStats();
+void temperatureSensorPrintStats(Print &out);
@@ -0,0 +1,195 @@
+#include "trace_codec.h"
+#include <string.h>
+
+#define VARINT_MAX 5                                          // u32 LEB128
+#define SAMPLE_MAX (2 * VARINT_MAX + TRACE_FIELD_COUNT * VARINT_MAX)   // Maska + periods + lauki
+
+static const char* const fieldNames[TRACE_FIELD_COUNT] = {
+    "flue_raw", "flue", "err_p", "err_i", "err_d", "damper", "room_raw", "mode", "target", "valid"
+};
+
+static uint32_t zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static uint8_t putVarint(uint8_t* out, uint32_t value) {
+    uint8_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+static bool getVarint(trace_reader_t* reader, uint32_t* value) {
+    uint32_t result = 0;
+    for (uint8_t shift = 0; shift < 7 * VARINT_MAX; shift += 7) {
+        if (reader->position >= reader->length) {
+            return false;
+        }
+        const uint8_t byte = reader->data[reader->position++];
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void putU16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void putU32(uint8_t* out, uint32_t value) {
+    putU16(out, (uint16_t)value);
+    putU16(out + 2, (uint16_t)(value >> 16));
+}
+
+static uint16_t getU16(const uint8_t* in) {
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t* in) {
+    return getU16(in) | ((uint32_t)getU16(in + 2) << 16);
+}
+
+void trace_block_begin(trace_block_t* block, uint32_t startUnix) {
+    memset(block, 0, sizeof(*block));
+    block->data[0] = TRACE_BLOCK_VERSION;
+    block->data[1] = startUnix != 0 ? TRACE_FLAG_WALL_CLOCK : 0;
+    putU32(&block->data[6], startUnix);
+    block->length = TRACE_BLOCK_HEADER;
+}
+
+bool trace_block_add(trace_block_t* block, const trace_sample_t* sample) {
+    if (block->count == 0xFFFF) {
+        return false;
+    }
+
+    uint8_t encoded[SAMPLE_MAX];
+    uint8_t n = 0;
+    int32_t period = 0;
+    if (block->count == 0) {
+        // Pirmais paraugs - absolūts; laiks ir galvenē
+        putU32(&block->data[2], sample->timeMs);
+        for (uint8_t i = 0; i < TRACE_FIELD_COUNT; i++) {
+            n += putVarint(&encoded[n], zigzag(sample->fields[i]));
+        }
+    } else {
+        period = (int32_t)(sample->timeMs - block->previous.timeMs);
+        uint32_t mask = period != block->previousPeriodMs ? TRACE_MASK_TIME : 0;
+        for (uint8_t i = 0; i < TRACE_FIELD_COUNT; i++) {
+            if (sample->fields[i] != block->previous.fields[i]) {
+                mask |= TRACE_MASK_FIELD(i);
+            }
+        }
+        n += putVarint(&encoded[n], mask);
+        if (mask & TRACE_MASK_TIME) {
+            n += putVarint(&encoded[n], zigzag(period - block->previousPeriodMs));
+        }
+        for (uint8_t i = 0; i < TRACE_FIELD_COUNT; i++) {
+            if (mask & TRACE_MASK_FIELD(i)) {
+                n += putVarint(&encoded[n], zigzag(sample->fields[i] - block->previous.fields[i]));
+            }
+        }
+    }
+
+    // Neder - bloks paliek kā bija (pirmais paraugs vienmēr der)
+    if (block->length + n > TRACE_BLOCK_MAX) {
+        return false;
+    }
+    memcpy(&block->data[block->length], encoded, n);
+    block->length += n;
+    block->count++;
+    putU16(&block->data[10], block->count);
+    block->previous = *sample;
+    block->previousPeriodMs = period;
+    return true;
+}
+
+uint16_t trace_block_count(const uint8_t* data, uint16_t length) {
+    if (length < TRACE_BLOCK_HEADER || data[0] != TRACE_BLOCK_VERSION) {
+        return 0;
+    }
+    return getU16(&data[10]);
+}
+
+bool trace_reader_init(trace_reader_t* reader, const uint8_t* data, uint16_t length) {
+    memset(reader, 0, sizeof(*reader));
+    if (length < TRACE_BLOCK_HEADER || data[0] != TRACE_BLOCK_VERSION) {
+        return false;
+    }
+    reader->data = data;
+    reader->length = length;
+    reader->position = TRACE_BLOCK_HEADER;
+    reader->flags = data[1];
+    reader->startMs = getU32(&data[2]);
+    reader->startUnix = getU32(&data[6]);
+    reader->remaining = getU16(&data[10]);
+    reader->first = true;
+    return reader->remaining > 0;
+}
+
+bool trace_reader_next(trace_reader_t* reader, trace_sample_t* sample) {
+    if (reader->remaining == 0) {
+        return false;
+    }
+
+    uint32_t value = 0;
+    if (reader->first) {
+        sample->timeMs = reader->startMs;
+        for (uint8_t i = 0; i < TRACE_FIELD_COUNT; i++) {
+            if (!getVarint(reader, &value)) {
+                return false;
+            }
+            sample->fields[i] = unzigzag(value);
+        }
+        reader->previousPeriodMs = 0;
+        reader->first = false;
+    } else {
+        uint32_t mask = 0;
+        if (!getVarint(reader, &mask)) {
+            return false;
+        }
+        int32_t period = reader->previousPeriodMs;
+        if (mask & TRACE_MASK_TIME) {
+            if (!getVarint(reader, &value)) {
+                return false;
+            }
+            period += unzigzag(value);
+        }
+        sample->timeMs = reader->previous.timeMs + (uint32_t)period;
+        for (uint8_t i = 0; i < TRACE_FIELD_COUNT; i++) {
+            sample->fields[i] = reader->previous.fields[i];
+            if (mask & TRACE_MASK_FIELD(i)) {
+                if (!getVarint(reader, &value)) {
+                    return false;
+                }
+                sample->fields[i] += unzigzag(value);
+            }
+        }
+        reader->previousPeriodMs = period;
+    }
+
+    reader->previous = *sample;
+    reader->remaining--;
+    return true;
+}
+
+uint32_t trace_reader_unix_time(const trace_reader_t* reader, const trace_sample_t* sample) {
+    if (!(reader->flags & TRACE_FLAG_WALL_CLOCK)) {
+        return 0;
+    }
+    return reader->startUnix + (sample->timeMs - reader->startMs) / 1000;
+}
+
+const char* trace_field_name(trace_field_t field) {
+    return field < TRACE_FIELD_COUNT ? fieldNames[field] : "?";
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Trace Codec - kompakts regulatora trases ieraksts (temperatūra, damper,
+ * errP/errI/errD, režīms) flash ierakstītājam un host dekoderim
+ *
+ * Paraugi tiek krāti blokos; katrs bloks ir patstāvīgs (var atkodēt bez
+ * iepriekšējiem), tāpēc, dzēšot vecāko flash sektoru, pazūd tikai tā bloki.
+ *
+ *   galvene: versija u8, karogi u8, startMs u32, startUnix u32, skaits u16
+ *   1. paraugs: visi lauki zigzag varint
+ *   tālāk:  maska (varint, bits = lauks mainījās) + mainīto lauku deltas
+ *
+ * Laikam glabā delta no iepriekšējā perioda (otrās kārtas), tāpēc
+ * vienmērīgā nolasīšanas ritmā tas aizņem 0 baitus. Tipisks paraugs ir
+ * 5-8 baiti.
+ *
+ * Bez Arduino atkarībām - to pašu kodu izmanto firmware un host rīki.
+ */
+
+#define TRACE_BLOCK_VERSION   1
+#define TRACE_BLOCK_MAX       1020   // 4 bloki + garuma lauki = flash_ring sektors bez galvenes
+#define TRACE_BLOCK_HEADER    12
+#define TRACE_FLAG_WALL_CLOCK 0x01   // startUnix ir derīgs (pēc NTP)
+#define TRACE_FLASH_MAGIC     0x43455254u   // "TREC" - flash_ring apgabals ar trases blokiem
+
+// Lauku secība nosaka maskas bitus: biežāk mainīgie pirmie, lai kopā ar
+// laika bitu maska parasti ir 1 baits
+typedef enum {
+    TRACE_FIELD_FLUE_RAW = 0,   // Dūmgāzes no scratchpad, °C × 16 (atkārtošanas ieeja)
+    TRACE_FIELD_FLUE,           // Regulatora filtrētais rādījums, °C × 16
+    TRACE_FIELD_ERR_P,          // errP × 16
+    TRACE_FIELD_ERR_I,          // errI, noapaļots
+    TRACE_FIELD_ERR_D,          // errD × 100
+    TRACE_FIELD_DAMPER,         // %
+    TRACE_FIELD_ROOM_RAW,       // Istaba no scratchpad, °C × 16 (kaskādei)
+    TRACE_FIELD_MODE,           // damper_mode_t
+    TRACE_FIELD_TARGET,         // targetTempC
+    TRACE_FIELD_VALID,          // Derīgo kanālu maska
+    TRACE_FIELD_COUNT
+} trace_field_t;
+
+#define TRACE_MASK_TIME        0x01u                   // Periods mainījās
+#define TRACE_MASK_FIELD(i)    (1u << ((i) + 1))
+
+typedef struct {
+    uint32_t timeMs;                     // millis() nolasīšanas brīdī
+    int32_t fields[TRACE_FIELD_COUNT];
+} trace_sample_t;
+
+typedef struct {
+    uint8_t data[TRACE_BLOCK_MAX];
+    uint16_t length;
+    uint16_t count;
+    trace_sample_t previous;
+    int32_t previousPeriodMs;
+} trace_block_t;
+
+typedef struct {
+    const uint8_t* data;
+    uint16_t length;
+    uint16_t position;
+    uint16_t remaining;
+    uint8_t flags;
+    uint32_t startMs;
+    uint32_t startUnix;
+    trace_sample_t previous;
+    int32_t previousPeriodMs;
+    bool first;
+} trace_reader_t;
+
+// Jauns tukšs bloks. startUnix = 0, ja reālais laiks nav zināms
+void trace_block_begin(trace_block_t* block, uint32_t startUnix);
+
+// Pievieno paraugu; false, ja blokā vairs nav vietas (tad jāsāk jauns)
+bool trace_block_add(trace_block_t* block, const trace_sample_t* sample);
+
+// Paraugu skaits pabeigtā blokā (no galvenes); 0 = nav trases bloks
+uint16_t trace_block_count(const uint8_t* data, uint16_t length);
+
+// Pārbauda galveni un sagatavo lasīšanu. false = nav trases bloks
+bool trace_reader_init(trace_reader_t* reader, const uint8_t* data, uint16_t length);
+
+// Nākamais paraugs; false = bloka beigas vai bojāti dati
+bool trace_reader_next(trace_reader_t* reader, trace_sample_t* sample);
+
+// Parauga reālais laiks (unix s) vai 0, ja blokam tā nav
+uint32_t trace_reader_unix_time(const trace_reader_t* reader, const trace_sample_t* sample);
+
+const char* trace_field_name(trace_field_t field);
@@ -0,0 +1,136 @@
+#include "trace_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flash_ring.h"
+#include "trace_codec.h"
+
+typedef struct {
+    uint8_t* data;
+    uint32_t size;
+} file_buffer_t;
+
+static bool bufferRead(void* ctx, uint32_t offset, void* data, uint32_t size) {
+    const file_buffer_t* image = (const file_buffer_t*)ctx;
+    if ((uint64_t)offset + size > image->size) {
+        return false;
+    }
+    memcpy(data, image->data + offset, size);
+    return true;
+}
+
+// Tikai lasīšana: apgabalu bez trases sektoriem mount nevar "noformatēt",
+// tāpēc svešs fails tiek atraidīts, nevis izlasīts kā tukša trase
+static bool bufferWrite(void* ctx, uint32_t offset, const void* data, uint32_t size) {
+    (void)ctx;
+    (void)offset;
+    (void)data;
+    (void)size;
+    return false;
+}
+
+static bool bufferErase(void* ctx, uint32_t offset, uint32_t size) {
+    (void)ctx;
+    (void)offset;
+    (void)size;
+    return false;
+}
+
+static bool readFile(const char* path, file_buffer_t* file) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    const long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    file->data = (uint8_t*)malloc(size > 0 ? (size_t)size : 1);
+    file->size = file->data != NULL && size > 0 ? (uint32_t)fread(file->data, 1, (size_t)size, f) : 0;
+    fclose(f);
+    return file->data != NULL;
+}
+
+static int hexValue(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool isDump(const file_buffer_t* file) {
+    for (uint32_t i = 0; i + 4 <= file->size; i++) {
+        if ((i == 0 || file->data[i - 1] == '\n') && memcmp(&file->data[i], "REC ", 4) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Ņemam tikai pilnas "REC <hex>" rindas ("REC BEGIN"/"REC END" nav hex)
+static int blocksFromDump(const file_buffer_t* file, trace_file_block_fn callback, void* ctx) {
+    uint8_t block[TRACE_BLOCK_MAX];
+    int blocks = 0;
+    uint32_t pos = 0;
+    while (pos < file->size) {
+        uint32_t end = pos;
+        while (end < file->size && file->data[end] != '\n') {
+            end++;
+        }
+        uint32_t last = end;
+        while (last > pos && (file->data[last - 1] == '\r' || file->data[last - 1] == ' ')) {
+            last--;
+        }
+        const uint32_t digits = last - pos > 4 ? last - pos - 4 : 0;
+        if (digits > 0 && digits % 2 == 0 && digits / 2 <= sizeof(block) &&
+            memcmp(&file->data[pos], "REC ", 4) == 0) {
+            bool ok = true;
+            for (uint32_t i = 0; i < digits / 2 && ok; i++) {
+                const int hi = hexValue(file->data[pos + 4 + 2 * i]);
+                const int lo = hexValue(file->data[pos + 5 + 2 * i]);
+                ok = hi >= 0 && lo >= 0;
+                block[i] = (uint8_t)(hi << 4 | lo);
+            }
+            if (ok) {
+                callback(block, (uint16_t)(digits / 2), ctx);
+                blocks++;
+            }
+        }
+        pos = end + 1;
+    }
+    return blocks;
+}
+
+static int blocksFromImage(const file_buffer_t* file, trace_file_block_fn callback, void* ctx) {
+    const uint32_t offset = file->size >= TRACE_FILE_SPIFFS_SIZE ? TRACE_FILE_REGION_OFFSET : 0;
+    const uint32_t sectors = (file->size - offset) / FLASH_RING_SECTOR_SIZE;
+    if (sectors < 2) {
+        return -1;
+    }
+    const flash_ring_io_t io = {bufferRead, bufferWrite, bufferErase, (void*)file};
+    static flash_ring_t ring;
+    flash_ring_init(&ring, &io, offset, (uint16_t)sectors, TRACE_FLASH_MAGIC);
+    if (!flash_ring_mount(&ring)) {
+        return -1;
+    }
+
+    static uint8_t data[FLASH_RING_RECORD_MAX];
+    flash_ring_cursor_t cursor;
+    flash_ring_cursor_init(&ring, &cursor, 0xFFFF);
+    int blocks = 0;
+    uint16_t length;
+    while ((length = flash_ring_next(&ring, &cursor, data, sizeof(data))) > 0) {
+        callback(data, length, ctx);
+        blocks++;
+    }
+    return blocks;
+}
+
+int trace_file_read(const char* path, trace_file_block_fn callback, void* ctx) {
+    file_buffer_t file = {NULL, 0};
+    if (!readFile(path, &file)) {
+        return -1;
+    }
+    const int blocks = isDump(&file) ? blocksFromDump(&file, callback, ctx) : blocksFromImage(&file, callback, ctx);
+    free(file.data);
+    return blocks;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <stdint.h>
+#include "flash_ring.h"
+
+/**
+ * Trace File - regulatora trases bloku nolasīšana host rīkiem
+ * (native_trace, native_replay)
+ *
+ * Fails var būt "spiffs" nodalījuma attēls (esptool read_flash vai
+ * native_sim --flash), tikai trases apgabals vai telnet "rec dump" izvads
+ * (rindas "REC <hex>", starp tām drīkst būt žurnāla rindas). Bloki tiek
+ * atdoti pa vienam no vecākā uz jaunāko; atkodē trace_codec.h.
+ *
+ * Tikai host: lasa failu ar stdio.
+ */
+
+#define TRACE_FILE_SPIFFS_SIZE   0x220000   // partitions_16MB.csv
+#define TRACE_FILE_LOG_SECTORS   64         // logger.h LOG_FLASH_SECTORS (host rīki logger nelinko)
+#define TRACE_FILE_REGION_OFFSET ((uint32_t)TRACE_FILE_LOG_SECTORS * FLASH_RING_SECTOR_SIZE)
+
+typedef void (*trace_file_block_fn)(const uint8_t* data, uint16_t length, void* ctx);
+
+// Bloku skaits; -1 = failu nevar atvērt vai tajā nav trases
+int trace_file_read(const char* path, trace_file_block_fn callback, void* ctx);
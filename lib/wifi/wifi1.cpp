@@ -7,6 +7,8 @@
 #include "lvgl_display.h"  // For time display functions
 #include "display_manager.h"  // For display manager notifications
 #include "display_config.h"   // For PSRAM optimization settings
+#include "controller_state.h" // Regulatora stāvokļa momentuzņēmums
+#include "logger.h"           // Žurnāls (Serial, telnet, flash)
 
 #include <ArduinoOTA.h>
 #include <AsyncTelegram2.h>
@@ -17,7 +19,6 @@ extern int temperature;
 extern int targetTempC;
 extern int kP;
 extern int temperatureMin;
-extern String messageDamp;
 
 // PSRAM-optimized string allocation for Telegram
 char* allocate_telegram_string(size_t size) {
@@ -94,7 +95,7 @@ const long gmtOffset_sec = 2 * 3600;    // Latvija: GMT+2
 const int daylightOffset_sec = 3600;    // Vasaras laiks
 
 void wifi_connect() {
-    Serial.printf("Connecting to WiFi: %s\n", ssid);
+    LOG_INFO("wifi", "Connecting to WiFi: %s", ssid);
     WiFi.begin(ssid, password);
     
     int attempts = 0;
@@ -102,16 +103,15 @@ void wifi_connect() {
         delay(500);
         attempts++;
         if (attempts % 10 == 0) {
-            Serial.printf("WiFi connecting... (%d seconds)\n", attempts / 2);
+            LOG_INFO("wifi", "WiFi connecting... (%d seconds)", attempts / 2);
         }
     }
     
-    Serial.println("WiFi connected successfully!");
-    Serial.printf("IP address: %s\n", WiFi.localIP().toString().c_str());
+    LOG_INFO("wifi", "WiFi connected, IP address: %s", WiFi.localIP().toString().c_str());
 }
 
 void sync_time() {
-    Serial.println("Starting NTP time synchronization...");
+    LOG_INFO("wifi", "Starting NTP time synchronization...");
     configTime(gmtOffset_sec, daylightOffset_sec, ntpServer);
     
     // Wait for NTP sync with timeout
@@ -121,13 +121,12 @@ void sync_time() {
     while (attempts < max_attempts) {
         struct tm timeinfo;
         if (getLocalTime(&timeinfo)) {
-            Serial.println("NTP time synchronized successfully!");
+            loggerTimeSynced();   // Turpmāk žurnālā datums un laiks
             
             // Notify display manager and force immediate time update
             display_manager_notify_time_synced();  // Notify display manager
             show_time_reset_cache();               // Clear time cache
             show_time_on_display();                // Force immediate update
-            Serial.println("Time display updated after NTP sync");
             
             return; // Success
         }
@@ -135,11 +134,11 @@ void sync_time() {
         delay(500);
         attempts++;
         if (attempts % 4 == 0) {
-            Serial.printf("Waiting for NTP sync... (%d/%d)\n", attempts, max_attempts);
+            LOG_DEBUG("wifi", "Waiting for NTP sync... (%d/%d)", attempts, max_attempts);
         }
     }
     
-    Serial.println("Warning: NTP synchronization timeout!");
+    LOG_WARN("wifi", "NTP synchronization timeout!");
 }
 
 String get_time_str() {
@@ -237,15 +236,17 @@ void handleTelegramMessages(AsyncTelegram2 &myBot) {
 
             if (callback_data == "refresh") {
                 // Simple status message with only furnace parameters
+                controller_state_t state;
+                controller_state_read(&state);
                 String status_msg = build_telegram_message_psram(
                     "🔥 KRĀSNS STATUS 🔥\n\n"
-                    "🌡️ Temperatūra: %d °C\n"
+                    "🌡️ Temperatūra: %.1f °C\n"
                     "🎯 Mērķis: %d °C\n"
                     "⚙️ kP vērtība: %d\n"
                     "❄️ Minimālā: %d °C\n"
                     "🎚️ Damper: %s",
-                    temperature, targetTempC, kP, temperatureMin,
-                    messageDamp.c_str()
+                    state.temperature, state.targetTemp, kP, temperatureMin,
+                    damper_mode_label(state.mode)
                 );
                 myBot.sendMessage(msg, status_msg);
             }
@@ -11,12 +11,16 @@
 #include <WiFi.h>  
 #include "settings_storage.h" // Iestatījumu saglabāšanas bibliotēka
 #include "telnet.h" // Telnet servera bibliotēka
+#include "logger.h" // Žurnāls: Serial, telnet un flash
+#include "recorder.h" // Regulatora trase flash atmiņā
 
 int relay = 17;
 
 void setup() {
     Serial.begin(115200);
-    Serial.println("Sistēmas inicializācija.v..");
+    loggerBegin(); // Pirms visa pārējā, lai flash žurnālā nonāk arī starta ziņojumi
+    recorderBegin(); // Trase "spiffs" nodalījumā aiz žurnāla
+    LOG_INFO("main", "Sistemas inicializacija");
     
     // Inicializējam iestatījumu saglabāšanas sistēmu un ielādējam iepriekšējos iestatījumus
     initSettingsStorage();
@@ -35,8 +39,7 @@ void setup() {
     initTemperatureSensor();
     ota_setup();
 
-    Serial.print("Mana IP adrese: ");
-    Serial.println(WiFi.localIP());
+    LOG_INFO("main", "Mana IP adrese: %s", WiFi.localIP().toString().c_str());
 
     // Inicializējam Telnet serveri
     Telnet.begin(23);
@@ -74,6 +77,7 @@ void loop() {
     handleTelegramMessages(); // Apstrādā Telegram ziņojumus
     // Sensor updates
     updateTemperature();
+    damperControlApplyAutotune(); // Autotune rezultāts -> kP/tauI un NVS
 
     touchButtonHandle();
 
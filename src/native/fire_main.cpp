@@ -0,0 +1,341 @@
+// Kurināšanas notikumu detektora (lib/fire_detector) pārbaude uz host.
+//
+//   pio run -e native_fire && .pio/build/native_fire/program [opcijas]
+//
+// Sintētiskās trases (noklusējums): stove_sim ar PID tādu pašu kā firmware,
+// nejaušām malkas piekraušanām, sensora troksni un noapaļošanu. Katrai trasei
+// zināms, kad malka piekrauta un kad krāsns izdegusi, tāpēc var saskaitīt
+// trāpījumus, kļūdainus notikumus un aizturi.
+//
+//   --runs N           Sintētisko trašu skaits (noklusējums 50)
+//   --seed N           Pirmā trase (katrai nākamajai seed + 1)
+//   --quant C          Sensora solis, °C (1 = pašreizējais int, 0.0625 = 12 bitu)
+//   --noise C          Sensora trokšņa amplitūda, °C
+//   --trend S          trendWindowS
+//   --baseline S       baselineWindowS
+//   --rise C/MIN       riseSlopeCPerMin
+//   --fall C/MIN       fallSlopeCPerMin
+//   --decay-confirm S  decayConfirmMs / 1000
+//   --confirm S        confirmMs / 1000
+//   --hold S           burnoutHoldMs / 1000
+//   --trace FILE       Ierakstīta CSV trase (laiks sekundēs, temperatūra)
+//   --time-col N       Laika kolonna trasē (noklusējums 0)
+//   --temp-col N       Temperatūras kolonna trasē (noklusējums 1)
+//   --refill-at MIN    Zināma piekraušana ierakstītajā trasē (var atkārtot)
+//   -v                 Izdrukā katru notikumu
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "fire_detector.h"
+#include "pid_controller.h"
+#include "stove_sim.h"
+
+#define SAMPLE_PERIOD_MS     1000
+#define TARGET_TEMP_C        66.0f
+#define MIN_TEMP_C           40.0f
+#define REFUEL_MATCH_MS      (15UL * 60000UL)   // REFUEL jāparādās 15 min laikā pēc piekraušanas
+#define BURNOUT_FUEL_KG      0.3f               // Zem šī malka uzskatāma par izdegušu
+#define MAX_RUN_MS           (10UL * 3600000UL)
+#define AFTER_BURNOUT_MS     (40UL * 60000UL)
+#define STARTUP_MS           (30UL * 60000UL)   // Trases sākumā krāsns tikko iekurta
+
+typedef struct {
+    unsigned long refuelHits;
+    unsigned long refuelMissed;
+    unsigned long refuelFalse;
+    double refuelLatencyS;
+    unsigned long burnoutHits;
+    unsigned long burnoutFalse;
+    unsigned long burnoutMissed;
+    double burnoutLatencyS;
+    unsigned long events[FIRE_EVENT_COUNT];
+    double hours;
+} fire_score_t;
+
+static bool verbose = false;
+
+// Notikumi salīdzināšanai ar zināmajām piekraušanām
+static void score_events(const std::vector<fire_event_t>& events, const std::vector<unsigned long>& refills,
+                         long burnoutMs, fire_score_t* score) {
+    std::vector<bool> matched(refills.size(), false);
+    bool burnoutSeen = false;
+    bool startSeen = false;
+
+    for (const fire_event_t& e : events) {
+        score->events[e.type]++;
+        if (e.type == FIRE_EVENT_REFUEL || e.type == FIRE_EVENT_IGNITION) {
+            bool hit = false;
+            for (size_t i = 0; i < refills.size(); i++) {
+                if (!matched[i] && e.timestampMs >= refills[i] && e.timestampMs - refills[i] <= REFUEL_MATCH_MS) {
+                    matched[i] = true;
+                    hit = true;
+                    score->refuelHits++;
+                    score->refuelLatencyS += (e.timestampMs - refills[i]) / 1000.0;
+                    break;
+                }
+            }
+            // Pirmais kāpums trases sākumā ir pati iekuršana, nevis kļūda
+            const bool startup = !startSeen && e.timestampMs <= STARTUP_MS;
+            startSeen = true;
+            if (!hit && !startup) {
+                score->refuelFalse++;
+            }
+        } else if (e.type == FIRE_EVENT_BURNOUT && !burnoutSeen) {
+            burnoutSeen = true;
+            if (burnoutMs >= 0 && (long)e.timestampMs >= burnoutMs) {
+                score->burnoutHits++;
+                score->burnoutLatencyS += (e.timestampMs - burnoutMs) / 1000.0;
+            } else {
+                score->burnoutFalse++;
+            }
+        }
+    }
+    for (size_t i = 0; i < refills.size(); i++) {
+        if (!matched[i]) score->refuelMissed++;
+    }
+    if (burnoutMs >= 0 && !burnoutSeen) {
+        score->burnoutMissed++;
+    }
+}
+
+static void collect(fire_detector_t* detector, unsigned long nowMs, float temp, std::vector<fire_event_t>& events) {
+    if (fire_detector_update(detector, nowMs, temp) != FIRE_EVENT_NONE) {
+        fire_event_t e;
+        fire_detector_event(detector, 0, &e);
+        events.push_back(e);
+        if (verbose) {
+            printf("  %7.1f min  %-8s %6.2f C  %+5.2f C/min\n", e.timestampMs / 60000.0,
+                   fire_event_label(e.type), e.temperatureC, e.slopeCPerMin);
+        }
+    }
+}
+
+static void run_synthetic(uint32_t seed, float quant, float noise, const fire_detector_config_t* config,
+                          fire_score_t* score) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> uni(0.0f, 1.0f);
+
+    stove_sim_config_t simConfig = stove_sim_default_config();
+    simConfig.initial_temp_c = 20.0f + 40.0f * uni(rng);
+    simConfig.initial_fuel_kg = 4.0f + 4.0f * uni(rng);
+    stove_sim_t sim;
+    stove_sim_init(&sim, &simConfig, 0);
+
+    // Kurinātājs piekrauj, kad malka beidzas; dažreiz nepiekrauj vispār
+    const int plannedRefills = (int)(uni(rng) * 4.0f);
+    int refillsDone = 0;
+    long refillDueMs = -1;
+
+    PidController pid(0, 100);
+    pid.setTunings(25, 1000, 5);
+
+    static fire_detector_t detector;
+    fire_detector_init(&detector, config);
+
+    std::vector<fire_event_t> events;
+    std::vector<unsigned long> refills;
+    long burnoutMs = -1;
+    int damper = 100;
+
+    if (verbose) {
+        printf("seed %u: %.1f C, %.1f kg, %d piekrausanas\n", seed, simConfig.initial_temp_c,
+               simConfig.initial_fuel_kg, plannedRefills);
+    }
+
+    for (unsigned long now = SAMPLE_PERIOD_MS; now <= MAX_RUN_MS; now += SAMPLE_PERIOD_MS) {
+        stove_sim_step(&sim, now, (float)damper);
+
+        float measured = sim.sensor_temp_c + noise * (2.0f * uni(rng) - 1.0f);
+        if (quant > 0.0f) {
+            measured = floorf(measured / quant) * quant;   // DS18B20 nogriež uz leju
+        }
+
+        // Tie paši apgabali kā damperControlLoop()
+        if (measured >= TARGET_TEMP_C) {
+            damper = 0;
+            pid.track(TARGET_TEMP_C, measured, damper);
+        } else if (measured <= MIN_TEMP_C) {
+            damper = 100;
+            pid.track(TARGET_TEMP_C, measured, damper);
+        } else {
+            damper = (int)lroundf(pid.update(TARGET_TEMP_C, measured, SAMPLE_PERIOD_MS / 1000.0f));
+        }
+
+        collect(&detector, now, measured, events);
+
+        if (refillsDone < plannedRefills && refillDueMs < 0 && sim.fuel_kg < 1.5f) {
+            refillDueMs = (long)(now + (unsigned long)(uni(rng) * 30.0f * 60000.0f));
+        }
+        if (refillDueMs >= 0 && (long)now >= refillDueMs) {
+            stove_sim_add_fuel(&sim, 3.0f + 4.0f * uni(rng));
+            refills.push_back(now);
+            refillsDone++;
+            refillDueMs = -1;
+        }
+
+        if (burnoutMs < 0 && refillDueMs < 0 && refillsDone >= plannedRefills &&
+            sim.fuel_kg < BURNOUT_FUEL_KG && sim.sensor_temp_c <= MIN_TEMP_C) {
+            burnoutMs = (long)now;
+        }
+        if (burnoutMs >= 0 && now - (unsigned long)burnoutMs > AFTER_BURNOUT_MS) {
+            break;
+        }
+        score->hours += SAMPLE_PERIOD_MS / 3600000.0;
+    }
+
+    score_events(events, refills, burnoutMs, score);
+}
+
+static int run_trace(const char* path, int timeCol, int tempCol, const std::vector<unsigned long>& refills,
+                     fire_detector_config_t config, fire_score_t* score) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Nevar atvert %s\n", path);
+        return 1;
+    }
+
+    std::vector<unsigned long> times;
+    std::vector<float> temps;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        double cols[32];
+        int n = 0;
+        char* p = line;
+        while (n < 32) {
+            char* end;
+            cols[n] = strtod(p, &end);
+            if (end == p) break;
+            n++;
+            p = end;
+            if (*p != ',') break;
+            p++;
+        }
+        // Galvene vai nepilna rinda
+        if (n <= timeCol || n <= tempCol) continue;
+        times.push_back((unsigned long)llround(cols[timeCol] * 1000.0));
+        temps.push_back((float)cols[tempCol]);
+    }
+    fclose(f);
+
+    if (times.size() < 2) {
+        fprintf(stderr, "Trase %s: par maz rindu\n", path);
+        return 1;
+    }
+
+    // Detektors strādā ar fiksētu periodu - ņemam to no trases
+    config.samplePeriodMs = (uint16_t)std::min<unsigned long>(times[1] - times[0], 60000UL);
+    static fire_detector_t detector;
+    fire_detector_init(&detector, &config);
+
+    std::vector<fire_event_t> events;
+    for (size_t i = 0; i < times.size(); i++) {
+        collect(&detector, times[i], temps[i], events);
+    }
+    score->hours += (times.back() - times.front()) / 3600000.0;
+    score_events(events, refills, -1, score);
+    return 0;
+}
+
+static void print_score(const fire_score_t& s, bool synthetic) {
+    printf("Trases stundas:            %.1f h\n", s.hours);
+    printf("REFUEL/IGNITION trapijumi: %lu, palaisti garam %lu, kludaini %lu (%.2f / h)\n",
+           s.refuelHits, s.refuelMissed, s.refuelFalse, s.hours > 0 ? s.refuelFalse / s.hours : 0.0);
+    if (s.refuelHits > 0) {
+        printf("REFUEL videja aizture:     %.1f min\n", s.refuelLatencyS / s.refuelHits / 60.0);
+    }
+    if (synthetic) {
+        printf("BURNOUT trapijumi:         %lu, palaisti garam %lu, kludaini %lu\n",
+               s.burnoutHits, s.burnoutMissed, s.burnoutFalse);
+        if (s.burnoutHits > 0) {
+            printf("BURNOUT videja aizture:    %.1f min\n", s.burnoutLatencyS / s.burnoutHits / 60.0);
+        }
+    }
+    printf("Notikumi:                 ");
+    for (int t = 1; t < FIRE_EVENT_COUNT; t++) {
+        printf(" %s=%lu", fire_event_label((fire_event_type_t)t), s.events[t]);
+    }
+    printf("\n");
+    printf("PEAK+DECAY stunda:         %.2f\n",
+           s.hours > 0 ? (s.events[FIRE_EVENT_PEAK] + s.events[FIRE_EVENT_DECAY]) / s.hours : 0.0);
+}
+
+int main(int argc, char** argv) {
+    int runs = 50;
+    uint32_t seed = 1;
+    float quant = 1.0f;
+    float noise = 0.0f;
+    const char* trace = nullptr;
+    int timeCol = 0;
+    int tempCol = 1;
+    std::vector<unsigned long> traceRefills;
+
+    fire_detector_config_t config = fire_detector_default_config(SAMPLE_PERIOD_MS);
+    config.coldTempC = MIN_TEMP_C;
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--runs") == 0 && hasValue) {
+            runs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--quant") == 0 && hasValue) {
+            quant = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--noise") == 0 && hasValue) {
+            noise = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--trend") == 0 && hasValue) {
+            config.trendWindowS = (uint16_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--baseline") == 0 && hasValue) {
+            config.baselineWindowS = (uint16_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rise") == 0 && hasValue) {
+            config.riseSlopeCPerMin = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--fall") == 0 && hasValue) {
+            config.fallSlopeCPerMin = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--decay-confirm") == 0 && hasValue) {
+            config.decayConfirmMs = strtoul(argv[++i], nullptr, 10) * 1000UL;
+        } else if (strcmp(argv[i], "--confirm") == 0 && hasValue) {
+            config.confirmMs = strtoul(argv[++i], nullptr, 10) * 1000UL;
+        } else if (strcmp(argv[i], "--hold") == 0 && hasValue) {
+            config.burnoutHoldMs = strtoul(argv[++i], nullptr, 10) * 1000UL;
+        } else if (strcmp(argv[i], "--trace") == 0 && hasValue) {
+            trace = argv[++i];
+        } else if (strcmp(argv[i], "--time-col") == 0 && hasValue) {
+            timeCol = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--temp-col") == 0 && hasValue) {
+            tempCol = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--refill-at") == 0 && hasValue) {
+            traceRefills.push_back((unsigned long)(strtof(argv[++i], nullptr) * 60000.0f));
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "Nezinama opcija: %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    printf("==== Fire detector: trend=%us baseline=%us rise=%.2f fall=%.2f C/min confirm=%lus ====\n",
+           config.trendWindowS, config.baselineWindowS, config.riseSlopeCPerMin, config.fallSlopeCPerMin,
+           config.confirmMs / 1000UL);
+
+    fire_score_t score;
+    memset(&score, 0, sizeof(score));
+
+    if (trace) {
+        if (run_trace(trace, timeCol, tempCol, traceRefills, config, &score) != 0) {
+            return 1;
+        }
+        print_score(score, false);
+        return 0;
+    }
+
+    printf("Sintetiskas trases: %d, sensora solis %.4f C, troksnis %.2f C\n", runs, quant, noise);
+    for (int r = 0; r < runs; r++) {
+        run_synthetic(seed + (uint32_t)r, quant, noise, &config, &score);
+    }
+    print_score(score, true);
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Host (Linux) palaidējs: darbina vadības cilpu ar virtuālo pulksteni un
+// konstantu sensora temperatūru, un izmēra loop() izpildes laiku.
+//
+//   pio run -e native && .pio/build/native/program [stundas] [temperatūra] [-v]
+
+#include <Arduino.h>
+#include <stdio.h>
+#include "native_harness.h"
+#include "native_hw.h"
+#include "damper_control.h"
+#include "temperature.h"
+#include "temperature_sensor.h"
+
+int main(int argc, char** argv) {
+    float hours = 1.0f;
+    float sensorTemp = 60.0f;
+    bool verbose = false;
+
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if (positional == 0) {
+            hours = strtof(argv[i], nullptr);
+            positional++;
+        } else if (positional == 1) {
+            sensorTemp = strtof(argv[i], nullptr);
+            positional++;
+        }
+    }
+
+    native_console_enabled = verbose;
+    if (verbose) {
+        native_telnet_connect_client(); // Telnet izvads uz stdout
+    }
+    native_sensor_set_temp_c(sensorTemp);
+
+    native_firmware_setup();
+    bool awake = native_firmware_run_for((unsigned long)(hours * 3600000.0f));
+
+    native_console_enabled = true;
+    const native_run_stats_t& stats = native_firmware_stats();
+
+    printf("Simulets laiks:      %.2f h%s\n", millis() / 3600000.0,
+           awake ? "" : " (deep sleep)");
+    printf("loop() iteracijas:   %llu\n", (unsigned long long)stats.loop_iterations);
+    printf("loop() videji:       %.0f ns (max %llu ns)\n",
+           stats.loop_iterations ? (double)stats.loop_host_ns / stats.loop_iterations : 0.0,
+           (unsigned long long)stats.loop_host_max_ns);
+    printf("loop() OneWire:      %llu us\n", (unsigned long long)stats.loop_onewire_us);
+    printf("DamperTask iteracijas: %llu\n", (unsigned long long)stats.damper_task_iterations);
+    printf("SensorTask iteracijas: %llu (OneWire %llu us)\n",
+           (unsigned long long)stats.sensor_task_iterations,
+           (unsigned long long)stats.sensor_onewire_us);
+    printf("ControlTask iteracijas: %llu\n", (unsigned long long)stats.control_task_iterations);
+    printf("Temperatura: %d C, damper: %d %%, rezims: %s\n",
+           temperature, damper, damper_mode_label(damperMode));
+    damperControlPrintStats(Serial);
+    temperatureSensorPrintStats(Serial);
+    return 0;
+}
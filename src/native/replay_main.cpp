@@ -0,0 +1,545 @@
+// Ierakstītas kurināšanas atkārtošana: trases dūmgāzu (un istabas) temperatūra
+// baro DS18B20 aizstājēju, un visa firmware vadības daļa (SensorTask, ControlTask,
+// damperControlLoop, režīmi, deep sleep) darbojas ar virtuālo pulksteni.
+// Atkārtojuma paša trase (lib/recorder) tiek salīdzināta ar ierakstīto.
+//
+//   pio run -e native_replay && .pio/build/native_replay/program [opcijas] FAILS
+//
+// FAILS ir native_trace CSV vai tas pats, ko lasa native_trace (flash attēls,
+// "rec dump" izvads). CSV vajag time_s un flue_raw_c (vai flue_c); pārējās
+// kolonnas (damper_pct, mode, err_i, ...) tiek salīdzinātas, ja tās ir.
+//
+//   --session N        Kuru sesiju atkārtot (noklusējums 1)
+//   --kp N             PID kP (citādi noklusējums / NVS, kā iekārtā)
+//   --taui S           PID tauI
+//   --taud S           PID tauD
+//   --target C         Mērķa temperatūra (citādi - no trases, ieskaitot maiņas)
+//   --loop-ms MS       loop() periods (noklusējums 100; 5 = kā iekārtā, lēnāk)
+//   --csv              Izvada ierakstīto un atkārtoto katram paraugam CSV formātā
+//                      (divu regulatora versiju salīdzināšanai ar diff)
+//   -v                 Firmware Serial izvads uz stdout
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "native_harness.h"
+#include "native_hw.h"
+#include "native_ui.h"
+#include "native_clock.h"
+#include "damper_control.h"
+#include "temperature.h"
+#include "controller_state.h"
+#include "logger.h"
+#include "recorder.h"
+#include "trace_codec.h"
+#include "trace_file.h"
+
+// Host dekoderis un firmware trasi meklē vienā vietā
+static_assert(TRACE_FILE_REGION_OFFSET == RECORDER_FLASH_OFFSET, "trace_file.h nesakrit ar recorder.h");
+static_assert(TRACE_FILE_LOG_SECTORS == LOG_FLASH_SECTORS, "trace_file.h nesakrit ar logger.h");
+
+#define REPLAY_LOOP_PERIOD_MS 100
+#define REPLAY_DEFAULT_PERIOD_MS 4000
+#define REPLAY_MAX_TRANSITIONS 30
+#define CSV_LINE_MAX 512
+#define CSV_COLUMN_MAX 32
+
+typedef struct {
+    std::vector<trace_sample_t> samples;
+    bool hasDamper;
+    bool hasMode;
+    bool hasErrors;
+    bool hasTarget;
+    bool hasRoom;
+} replay_trace_t;
+
+typedef struct {
+    const replay_trace_t* trace;
+    size_t next;               // Pirmais paraugs, kura laiks vēl nav pienācis
+    int roomSensor;
+    bool followTarget;
+} replay_context_t;
+
+// ---- Ievade ----
+
+static bool isCsv(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+    char line[16] = {0};
+    const bool csv = fgets(line, sizeof(line), f) != NULL && strncmp(line, "time_s,", 7) == 0;
+    fclose(f);
+    return csv;
+}
+
+static int splitCsv(char* line, char** columns) {
+    int count = 0;
+    char* p = line;
+    while (count < CSV_COLUMN_MAX) {
+        columns[count++] = p;
+        p = strchr(p, ',');
+        if (!p) {
+            break;
+        }
+        *p++ = '\0';
+    }
+    return count;
+}
+
+static int columnIndex(char** names, int count, const char* name) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int32_t scaled(char** columns, int count, int index, float scale, int32_t fallback) {
+    if (index < 0 || index >= count) {
+        return fallback;
+    }
+    return (int32_t)lroundf(strtof(columns[index], NULL) * scale);
+}
+
+static bool readCsv(const char* path, long session, replay_trace_t* trace) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+    char header[CSV_LINE_MAX];
+    char* names[CSV_COLUMN_MAX];
+    if (!fgets(header, sizeof(header), f)) {
+        fclose(f);
+        return false;
+    }
+    header[strcspn(header, "\r\n")] = '\0';
+    const int nameCount = splitCsv(header, names);
+
+    const int colTime = columnIndex(names, nameCount, "time_s");
+    int colFlue = columnIndex(names, nameCount, "flue_raw_c");
+    if (colFlue < 0) {
+        colFlue = columnIndex(names, nameCount, "flue_c");
+    }
+    const int colFiltered = columnIndex(names, nameCount, "flue_c");
+    const int colRoom = columnIndex(names, nameCount, "room_raw_c");
+    const int colTarget = columnIndex(names, nameCount, "target_c");
+    const int colDamper = columnIndex(names, nameCount, "damper_pct");
+    const int colErrP = columnIndex(names, nameCount, "err_p");
+    const int colErrI = columnIndex(names, nameCount, "err_i");
+    const int colErrD = columnIndex(names, nameCount, "err_d");
+    const int colMode = columnIndex(names, nameCount, "mode");
+    const int colValid = columnIndex(names, nameCount, "valid");
+    const int colSession = columnIndex(names, nameCount, "session");
+    if (colTime < 0 || colFlue < 0) {
+        fclose(f);
+        fprintf(stderr, "%s: vajag kolonnas time_s un flue_raw_c (vai flue_c)\n", path);
+        return false;
+    }
+
+    trace->hasDamper = colDamper >= 0;
+    trace->hasMode = colMode >= 0;
+    trace->hasErrors = colErrI >= 0 && colErrP >= 0;
+    trace->hasTarget = colTarget >= 0;
+    trace->hasRoom = false;
+
+    char line[CSV_LINE_MAX];
+    char* columns[CSV_COLUMN_MAX];
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        const int count = splitCsv(line, columns);
+        if (count <= colTime || count <= colFlue) {
+            continue;
+        }
+        if (colSession >= 0 && colSession < count && atol(columns[colSession]) != session) {
+            continue;
+        }
+        trace_sample_t sample;
+        memset(&sample, 0, sizeof(sample));
+        sample.timeMs = (uint32_t)llround(strtod(columns[colTime], NULL) * 1000.0);
+        int32_t* s = sample.fields;
+        s[TRACE_FIELD_FLUE_RAW] = scaled(columns, count, colFlue, TEMP_C16_SCALE, 0);
+        s[TRACE_FIELD_FLUE] = scaled(columns, count, colFiltered, TEMP_C16_SCALE, s[TRACE_FIELD_FLUE_RAW]);
+        s[TRACE_FIELD_ROOM_RAW] = scaled(columns, count, colRoom, TEMP_C16_SCALE, 0);
+        s[TRACE_FIELD_TARGET] = scaled(columns, count, colTarget, 1.0f, 0);
+        s[TRACE_FIELD_DAMPER] = scaled(columns, count, colDamper, 1.0f, 0);
+        s[TRACE_FIELD_ERR_P] = scaled(columns, count, colErrP, TEMP_C16_SCALE, 0);
+        s[TRACE_FIELD_ERR_I] = scaled(columns, count, colErrI, 1.0f, 0);
+        s[TRACE_FIELD_ERR_D] = scaled(columns, count, colErrD, 100.0f, 0);
+        s[TRACE_FIELD_MODE] = scaled(columns, count, colMode, 1.0f, DAMPER_MODE_AUTO);
+        s[TRACE_FIELD_VALID] = scaled(columns, count, colValid, 1.0f, 1 << TEMP_CHANNEL_FLUE);
+        trace->samples.push_back(sample);
+    }
+    fclose(f);
+    return true;
+}
+
+typedef struct {
+    std::vector<trace_sample_t>* samples;
+    long session;
+    long current;
+    uint32_t endMs;
+} block_filter_t;
+
+// Sesiju dala tāpat kā native_trace: millis() atgriežas atpakaļ - jauns starts
+static void appendBlock(const uint8_t* data, uint16_t length, void* ctx) {
+    block_filter_t* filter = (block_filter_t*)ctx;
+    trace_reader_t reader;
+    if (!trace_reader_init(&reader, data, length)) {
+        return;
+    }
+    if (filter->current == 0 || reader.startMs < filter->endMs) {
+        filter->current++;
+    }
+    trace_sample_t sample;
+    while (trace_reader_next(&reader, &sample)) {
+        filter->endMs = sample.timeMs;
+        if (filter->current == filter->session) {
+            filter->samples->push_back(sample);
+        }
+    }
+}
+
+static bool readBinary(const char* path, long session, replay_trace_t* trace) {
+    block_filter_t filter = {&trace->samples, session, 0, 0};
+    if (trace_file_read(path, appendBlock, &filter) < 0) {
+        return false;
+    }
+    trace->hasDamper = true;
+    trace->hasMode = true;
+    trace->hasErrors = true;
+    trace->hasTarget = true;
+    trace->hasRoom = false;
+    return true;
+}
+
+// Nolasīšanas intervāls = paraugu intervālu mediāna (retry un izlaidumi to nemaina)
+static uint32_t medianPeriodMs(const std::vector<trace_sample_t>& samples) {
+    std::vector<uint32_t> periods;
+    for (size_t i = 1; i < samples.size(); i++) {
+        periods.push_back(samples[i].timeMs - samples[i - 1].timeMs);
+    }
+    if (periods.empty()) {
+        return REPLAY_DEFAULT_PERIOD_MS;
+    }
+    std::nth_element(periods.begin(), periods.begin() + periods.size() / 2, periods.end());
+    return periods[periods.size() / 2];
+}
+
+// ---- Atkārtošana ----
+
+// Konversija sākas pirms parauga publicēšanas, tāpēc sensoram dodam nākamo
+// paraugu, kura laiks vēl nav pienācis - nolasījuma fāzei nav jāsakrīt ar ierakstu
+static void replay_tick(unsigned long now_ms, void* arg) {
+    replay_context_t* c = (replay_context_t*)arg;
+    const std::vector<trace_sample_t>& samples = c->trace->samples;
+    while (c->next < samples.size() && samples[c->next].timeMs <= now_ms) {
+        c->next++;
+    }
+    if (c->next >= samples.size()) {
+        return;
+    }
+    const int32_t* s = samples[c->next].fields;
+
+    const bool flueValid = (s[TRACE_FIELD_VALID] & (1 << TEMP_CHANNEL_FLUE)) != 0;
+    native_sensor_set_present(flueValid, 0);
+    if (flueValid) {
+        native_sensor_set_temp_c(s[TRACE_FIELD_FLUE_RAW] / (float)TEMP_C16_SCALE);
+    }
+    if (c->roomSensor >= 0) {
+        const bool roomValid = (s[TRACE_FIELD_VALID] & (1 << TEMP_CHANNEL_ROOM)) != 0;
+        native_sensor_set_present(roomValid, c->roomSensor);
+        if (roomValid) {
+            native_sensor_set_device_temp_c(c->roomSensor, s[TRACE_FIELD_ROOM_RAW] / (float)TEMP_C16_SCALE);
+        }
+    }
+
+    // Lietotāja darbības no ieraksta: manuālais režīms un mērķa maiņa
+    if (c->trace->hasMode) {
+        native_ui_set_manual_mode(s[TRACE_FIELD_MODE] == DAMPER_MODE_MANUAL);
+    }
+    if (c->followTarget && s[TRACE_FIELD_TARGET] > 0) {
+        targetTempC = s[TRACE_FIELD_TARGET];
+    }
+}
+
+static void collectOwnBlock(std::vector<trace_sample_t>* samples, const uint8_t* data, uint16_t length) {
+    trace_reader_t reader;
+    if (!trace_reader_init(&reader, data, length)) {
+        return;
+    }
+    trace_sample_t sample;
+    while (trace_reader_next(&reader, &sample)) {
+        samples->push_back(sample);
+    }
+}
+
+// Atkārtojuma paša trase no recorder flash (šajā procesā tā sākas tukša)
+static void readOwnTrace(std::vector<trace_sample_t>* samples) {
+    static uint8_t data[FLASH_RING_RECORD_MAX];
+    flash_ring_cursor_t cursor;
+    if (!recorderDumpBegin(&cursor, 0xFFFF)) {
+        return;
+    }
+    uint16_t length;
+    while ((length = recorderDumpNext(&cursor, data, sizeof(data))) > 0) {
+        collectOwnBlock(samples, data, length);
+    }
+}
+
+// ---- Salīdzināšana ----
+
+typedef struct {
+    size_t recorded;
+    size_t replayed;
+} sample_pair_t;
+
+static std::vector<sample_pair_t> alignSamples(const std::vector<trace_sample_t>& recorded,
+                                               const std::vector<trace_sample_t>& replayed, uint32_t periodMs) {
+    std::vector<sample_pair_t> pairs;
+    size_t i = 0;
+    for (size_t j = 0; j < replayed.size(); j++) {
+        const uint32_t t = replayed[j].timeMs;
+        while (i < recorded.size() && recorded[i].timeMs + periodMs / 2 < t) {
+            i++;
+        }
+        if (i < recorded.size() && recorded[i].timeMs <= t + periodMs / 2) {
+            pairs.push_back({i, j});
+        }
+    }
+    return pairs;
+}
+
+static uint32_t damperChanges(const std::vector<trace_sample_t>& samples) {
+    uint32_t changes = 0;
+    for (size_t i = 1; i < samples.size(); i++) {
+        if (samples[i].fields[TRACE_FIELD_DAMPER] != samples[i - 1].fields[TRACE_FIELD_DAMPER]) {
+            changes++;
+        }
+    }
+    return changes;
+}
+
+static uint32_t modeTransitions(const std::vector<trace_sample_t>& samples) {
+    uint32_t transitions = 0;
+    for (size_t i = 1; i < samples.size(); i++) {
+        if (samples[i].fields[TRACE_FIELD_MODE] != samples[i - 1].fields[TRACE_FIELD_MODE]) {
+            transitions++;
+        }
+    }
+    return transitions;
+}
+
+static void printTransitions(const char* label, const std::vector<trace_sample_t>& samples) {
+    uint32_t printed = 0;
+    for (size_t i = 1; i < samples.size(); i++) {
+        const int32_t from = samples[i - 1].fields[TRACE_FIELD_MODE];
+        const int32_t to = samples[i].fields[TRACE_FIELD_MODE];
+        if (from == to) {
+            continue;
+        }
+        if (printed++ == REPLAY_MAX_TRANSITIONS) {
+            printf("  %-12s ...\n", label);
+            return;
+        }
+        printf("  %-12s %7.1f min  %s -> %s\n", label, samples[i].timeMs / 60000.0,
+               damper_mode_label((damper_mode_t)from), damper_mode_label((damper_mode_t)to));
+    }
+}
+
+static void print_minutes(const char* label, unsigned long ms) {
+    printf("%-26s %.1f min\n", label, ms / 60000.0);
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    long session = 1;
+    bool verbose = false;
+    bool csv = false;
+    int gainKp = -1;
+    float gainTauI = -1.0f;
+    float gainTauD = -1.0f;
+    int target = -1;
+    long loopMs = REPLAY_LOOP_PERIOD_MS;
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--session") == 0 && hasValue) {
+            session = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--kp") == 0 && hasValue) {
+            gainKp = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--taui") == 0 && hasValue) {
+            gainTauI = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--taud") == 0 && hasValue) {
+            gainTauD = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--target") == 0 && hasValue) {
+            target = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--loop-ms") == 0 && hasValue) {
+            loopMs = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if (argv[i][0] != '-' && path == nullptr) {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "Nezinama opcija: %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (path == nullptr) {
+        fprintf(stderr, "Lietojums: %s [--session N] [--kp N] [--taui S] [--taud S] [--target C] "
+                        "[--loop-ms MS] [--csv] [-v] FAILS\n", argv[0]);
+        return 2;
+    }
+
+    static replay_trace_t trace;
+    const bool ok = isCsv(path) ? readCsv(path, session, &trace) : readBinary(path, session, &trace);
+    if (!ok) {
+        fprintf(stderr, "%s: nav ne CSV, ne flash attels, ne 'rec dump' izvads\n", path);
+        return 1;
+    }
+    const std::vector<trace_sample_t>& recorded = trace.samples;
+    if (recorded.size() < 2) {
+        fprintf(stderr, "%s: sesija %ld nav atrasta vai tajā ir mazāk par 2 paraugiem\n", path, session);
+        return 1;
+    }
+    for (const trace_sample_t& s : recorded) {
+        if (s.fields[TRACE_FIELD_VALID] & (1 << TEMP_CHANNEL_ROOM)) {
+            trace.hasRoom = true;
+            break;
+        }
+    }
+    const uint32_t periodMs = medianPeriodMs(recorded);
+    const int32_t* first = recorded[0].fields;
+
+    native_console_enabled = verbose;
+    native_firmware_set_loop_period_ms((unsigned long)loopMs);
+
+    // Trase, kas nesākas ar startu (vecākie bloki pārrakstīti), sākas
+    // pusperiodu pirms pirmā parauga ar tā errI
+    const bool midSession = recorded[0].timeMs > periodMs;
+    if (midSession) {
+        native_clock_advance_ms(recorded[0].timeMs - periodMs / 2);
+    }
+
+    // Sensori jau pirms setup() rāda pirmo paraugu
+    static replay_context_t ctx;
+    ctx.trace = &trace;
+    ctx.roomSensor = -1;
+    ctx.followTarget = target <= 0 && trace.hasTarget;
+    native_sensor_set_temp_c(first[TRACE_FIELD_FLUE_RAW] / (float)TEMP_C16_SCALE);
+    if (trace.hasRoom) {
+        ctx.roomSensor = native_sensor_add(first[TRACE_FIELD_ROOM_RAW] / (float)TEMP_C16_SCALE);
+        native_sensor_address(ctx.roomSensor, temperatureChannelAddress[TEMP_CHANNEL_ROOM]);
+    }
+    native_firmware_setup();
+
+    // Tāpat kā settings_screen.cpp / loadAllSettings()
+    if (gainKp > 0) kP = gainKp;
+    if (gainTauI > 0.0f) tauI = gainTauI;
+    if (gainTauD > 0.0f) tauD = gainTauD;
+    kI = kP / tauI;
+    kD = kP * tauD;
+    tempReadIntervalMs = periodMs;
+    if (target > 0) {
+        targetTempC = target;
+    } else if (trace.hasTarget && first[TRACE_FIELD_TARGET] > 0) {
+        targetTempC = first[TRACE_FIELD_TARGET];
+    }
+    if (midSession && trace.hasErrors) {
+        errI = first[TRACE_FIELD_ERR_I];
+    }
+
+    const unsigned long endMs = recorded.back().timeMs + periodMs;
+    const auto start = std::chrono::steady_clock::now();
+    const bool awake = native_firmware_run_for(endMs - millis(), replay_tick, &ctx);
+    const double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    native_console_enabled = true;
+    recorderFlush();
+    loggerFlush();
+
+    std::vector<trace_sample_t> replayed;
+    readOwnTrace(&replayed);
+    const std::vector<sample_pair_t> pairs = alignSamples(recorded, replayed, periodMs);
+
+    if (csv) {
+        printf("time_s,flue_raw_c,rec_damper,damper,rec_mode,mode,rec_err_i,err_i,rec_err_p,err_p\n");
+        for (const sample_pair_t& p : pairs) {
+            const int32_t* r = recorded[p.recorded].fields;
+            const int32_t* s = replayed[p.replayed].fields;
+            printf("%.3f,%.4f,%d,%d,%d,%d,%d,%d,%.4f,%.4f\n",
+                   recorded[p.recorded].timeMs / 1000.0, r[TRACE_FIELD_FLUE_RAW] / (double)TEMP_C16_SCALE,
+                   r[TRACE_FIELD_DAMPER], s[TRACE_FIELD_DAMPER], r[TRACE_FIELD_MODE], s[TRACE_FIELD_MODE],
+                   r[TRACE_FIELD_ERR_I], s[TRACE_FIELD_ERR_I],
+                   r[TRACE_FIELD_ERR_P] / (double)TEMP_C16_SCALE, s[TRACE_FIELD_ERR_P] / (double)TEMP_C16_SCALE);
+        }
+        return 0;
+    }
+
+    uint32_t damperMismatches = 0;
+    uint32_t modeMismatches = 0;
+    double damperAbsSum = 0.0;
+    int32_t damperAbsMax = 0;
+    int32_t errIAbsMax = 0;
+    for (const sample_pair_t& p : pairs) {
+        const int32_t* r = recorded[p.recorded].fields;
+        const int32_t* s = replayed[p.replayed].fields;
+        const int32_t damperDiff = abs(r[TRACE_FIELD_DAMPER] - s[TRACE_FIELD_DAMPER]);
+        damperMismatches += damperDiff != 0;
+        damperAbsSum += damperDiff;
+        damperAbsMax = std::max(damperAbsMax, damperDiff);
+        modeMismatches += r[TRACE_FIELD_MODE] != s[TRACE_FIELD_MODE];
+        errIAbsMax = std::max(errIAbsMax, abs(r[TRACE_FIELD_ERR_I] - s[TRACE_FIELD_ERR_I]));
+    }
+
+    const native_run_stats_t& stats = native_firmware_stats();
+    const int32_t lastMode = recorded.back().fields[TRACE_FIELD_MODE];
+
+    printf("==== Atkartojums: %s, sesija %ld, kP=%d tauI=%.1f tauD=%.1f target=%d C ====\n",
+           path, session, kP, tauI, tauD, targetTempC);
+    printf("%-26s %zu (intervals %lu ms%s%s)\n", "Ierakstiti paraugi:", recorded.size(),
+           (unsigned long)periodMs, trace.hasRoom ? ", ar istabu" : "",
+           midSession ? ", sakas sesijas vidu" : "");
+    printf("%-26s %zu, salidzinati %zu\n", "Atkartoti paraugi:", replayed.size(), pairs.size());
+    print_minutes("Atkartots laiks:", millis() - (midSession ? recorded[0].timeMs - periodMs / 2 : 0));
+    if (trace.hasDamper && !pairs.empty()) {
+        printf("%-26s %u no %zu (%.1f %%), vid. |delta| %.2f %%, max %d %%\n", "Damper atskiras:",
+               damperMismatches, pairs.size(), 100.0 * damperMismatches / pairs.size(),
+               damperAbsSum / pairs.size(), damperAbsMax);
+        printf("%-26s ieraksta %u, atkartojuma %u\n", "Damper izmainas:", damperChanges(recorded),
+               damperChanges(replayed));
+    }
+    if (trace.hasErrors && !pairs.empty()) {
+        printf("%-26s %d\n", "errI max |delta|:", errIAbsMax);
+    }
+    if (trace.hasMode) {
+        printf("%-26s ieraksta %u, atkartojuma %u, atskiras %u paraugos\n", "Rezima mainas:",
+               modeTransitions(recorded), modeTransitions(replayed), modeMismatches);
+        printTransitions("ieraksts", recorded);
+        printTransitions("atkartojums", replayed);
+        printf("%-26s %.1f min, rezims %s\n", "Ieraksts beidzas:", recorded.back().timeMs / 60000.0,
+               damper_mode_label((damper_mode_t)lastMode));
+    }
+    if (!awake) {
+        print_minutes("Deep sleep pec:", stats.deep_sleep_ms);
+    } else {
+        printf("%-26s nav\n", "Deep sleep:");
+    }
+
+    // ControlTask CPU uz host: cik kurināšanas stundu var izskaitīt minūtē
+    const double simulatedH = (millis() - (midSession ? recorded[0].timeMs - periodMs / 2 : 0)) / 3600000.0;
+    printf("%-26s %.2f s, %.0f simuletas h/min (loop %ld ms)\n", "Atkartosanas laiks:",
+           wallS, wallS > 0.0 ? simulatedH * 60.0 / wallS : 0.0, loopMs);
+    printf("%-26s %llu soli, vid. %.0f ns, max %llu ns\n", "ControlTask:",
+           (unsigned long long)stats.control_task_iterations,
+           stats.control_task_iterations ? (double)stats.control_host_ns / stats.control_task_iterations : 0.0,
+           (unsigned long long)stats.control_host_max_ns);
+    return 0;
+}
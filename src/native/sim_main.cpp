@@ -0,0 +1,427 @@
+// Slēgtas cilpas krāsns simulācija: stove_sim modelis baro DS18B20 aizstājēju,
+// firmware vadības cilpa kustina servo, un servo pozīcija atgriežas modelī.
+//
+//   pio run -e native_sim && .pio/build/native_sim/program [opcijas]
+//
+//   --hours H          Simulācijas ilgums (noklusējums 8)
+//   --kp N             PID kP
+//   --taui S           PID tauI
+//   --taud S           PID tauD
+//   --target C         Mērķa temperatūra (targetTempC)
+//   --read-interval MS DS18B20 nolasīšanas intervāls (tempReadIntervalMs)
+//   --servo-step MS    Servo maksimālais ātrums, ms uz 1 % (servoStepInterval)
+//   --deadband PCT     Servo deadband (servoDeadbandPct, 0 = katra izmaiņa)
+//   --butterfly        Nelineārs tauriņvārsts; modelis ņem atvērumu no servo impulsa
+//   --airflow-map      Teorētiskā tauriņvārsta tabula firmware (telnet "airflow butterfly")
+//   --start-temp C     Krāsns temperatūra simulācijas sākumā
+//   --fuel KG          Sākuma malkas krava
+//   --refill MIN:KG    Plānota malkas piekraušana (var atkārtot)
+//   --auto-refill KG   Piekrauj KG malkas 10 min pēc tam, kad parādās FILL!
+//   --cascade C        Kaskāde: targetTempC nosaka istabas mērķis C
+//   --autotune MIN[:STEP] Sāk autotune eksperimentu MIN minūtē (lēciens STEP %)
+//   --gains T:KP[:TI]  Pastiprinājumu grafika punkts: T °C, kP un tauI reizinātāji (var atkārtot)
+//   --ff G:B:T         Feed-forward: ffTrendGain:ffRefillBoost:ffRefillTauS (0:0:0 = izslēgts)
+//   --outdoor C        Āra temperatūra (istabas modelim)
+//   --telnet           Pieslēdz telnet klientu (bez izvada) un skaita TCP write()
+//   --csv              Izvada trasi (ik 30 s) CSV formātā
+//   --flash FILE       Flash attēls: ielādē pirms starta (ja ir) un saglabā beigās
+//                      ("restarts" ar to pašu failu turpina žurnālu un trasi;
+//                      trasi atkodē native_trace)
+//   --log-show N       Beigās izdrukā pēdējās N flash žurnāla rindas
+//   -v                 Firmware Serial/telnet izvads uz stdout
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include "native_harness.h"
+#include "native_hw.h"
+#include "stove_sim.h"
+#include "damper_control.h"
+#include "temperature.h"
+#include "controller_state.h"
+#include "logger.h"
+#include "recorder.h"
+
+// Kaudzes alokācijas (String, std::string u.c.) simulācijas laikā
+static uint64_t heap_allocations = 0;
+
+void* operator new(size_t size) {
+    heap_allocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t size) noexcept {
+    (void)size;
+    free(p);
+}
+
+#define AUTO_REFILL_DELAY_MS 600000   // Kurinātāja reakcijas laiks uz FILL!
+#define CSV_PERIOD_MS 30000
+#define ROOM_STATS_AFTER_MS 3600000
+
+typedef struct {
+    stove_sim_t sim;
+    stove_bench_t bench;
+    float auto_refill_kg;
+    unsigned long fill_seen_ms;
+    bool fill_pending;
+    uint8_t auto_refills;
+    bool csv;
+    unsigned long last_csv_ms;
+    int water_sensor;               // Ūdens apvalka sensors uz tās pašas kopnes
+    int room_sensor;
+    unsigned long autotune_at_ms;   // 0 = bez autotune
+    float autotune_step_pct;
+    double room_sum_c;              // Istabas vidējā un |kļūda| pret roomTargetC
+    double room_abs_error_sum_c;
+    uint32_t room_samples;
+    float room_min_c;
+    float room_max_c;
+    int servo_request;              // Pēdējais regulatora damper mērķis
+    unsigned long servo_request_ms; // Kad tas publicēts
+    bool servo_pending;             // Servo vēl nav tajā
+    double servo_latency_sum_ms;    // Mērķis -> servo pozīcijā
+    uint32_t servo_latency_count;
+    unsigned long servo_latency_max_ms;
+    bool butterfly;                 // Modelis redz fizisko atvērumu, nevis firmware %
+    unsigned long buzzer_on_ms;     // Buzzer izeja HIGH (nolasīta katrā loop() solī)
+    uint32_t buzzer_beeps;
+    bool buzzer_level;
+    unsigned long last_tick_ms;
+} sim_context_t;
+
+// Vārsta atvērums: ar tauriņvārstu - no impulsa pēc lineārās ģeometrijas
+// (firmware % ar gaisa plūsmas tabulu vairs nav leņķis)
+static float damper_opening_pct(const sim_context_t* c) {
+    if (c->butterfly && native_servo_microseconds() > 0) {
+        return constrain(damperMicrosToOpening((float)native_servo_microseconds()), 0.0f, 100.0f);
+    }
+    return (float)getCurrentDamperPosition();
+}
+
+static void sim_tick(unsigned long now_ms, void* ctx) {
+    sim_context_t* c = (sim_context_t*)ctx;
+
+    const float damper_pos = (float)getCurrentDamperPosition();
+    stove_sim_step(&c->sim, now_ms, damper_opening_pct(c));
+    native_sensor_set_temp_c(stove_sim_sensor_temp(&c->sim));
+    native_sensor_set_device_temp_c(c->water_sensor, c->sim.water_temp_c);
+    native_sensor_set_device_temp_c(c->room_sensor, c->sim.room_temp_c);
+
+    if (c->autotune_at_ms != 0 && now_ms >= c->autotune_at_ms) {
+        c->autotune_at_ms = 0;
+        damperControlRequestAutotune(c->autotune_step_pct);
+    }
+
+    // Istabas rādītāji pēc pirmās stundas (iekuršanās)
+    if (now_ms >= ROOM_STATS_AFTER_MS) {
+        const float room = c->sim.room_temp_c;
+        if (c->room_samples == 0 || room < c->room_min_c) c->room_min_c = room;
+        if (c->room_samples == 0 || room > c->room_max_c) c->room_max_c = room;
+        c->room_sum_c += room;
+        c->room_abs_error_sum_c += fabsf(room - roomTargetC);
+        c->room_samples++;
+    }
+
+    // Buzzer raksti: skanēšanas laiks un pīkstienu skaits no GPIO
+    const bool buzzer_level = digitalRead(buzzer) == HIGH;
+    if (c->buzzer_level) {
+        c->buzzer_on_ms += now_ms - c->last_tick_ms;
+    }
+    if (buzzer_level && !c->buzzer_level) {
+        c->buzzer_beeps++;
+    }
+    c->buzzer_level = buzzer_level;
+    c->last_tick_ms = now_ms;
+
+    controller_state_t state;
+    controller_state_read(&state);
+
+    // Servo aizture: katram jaunam mērķim laiks, līdz servo ir tajā
+    // (ja mērķis mainās pa ceļam, iepriekšējais netiek skaitīts)
+    if (state.damper != c->servo_request) {
+        c->servo_request = state.damper;
+        c->servo_request_ms = now_ms;
+        c->servo_pending = true;
+    }
+    if (c->servo_pending && getCurrentDamperPosition() == c->servo_request && !controller_state_servo_moving()) {
+        const unsigned long latency_ms = now_ms - c->servo_request_ms;
+        c->servo_latency_sum_ms += latency_ms;
+        c->servo_latency_count++;
+        if (latency_ms > c->servo_latency_max_ms) {
+            c->servo_latency_max_ms = latency_ms;
+        }
+        c->servo_pending = false;
+    }
+
+    const bool fill = state.mode == DAMPER_MODE_FILL;
+    const bool end = state.mode == DAMPER_MODE_END;
+    stove_bench_observe(&c->bench, now_ms, c->sim.sensor_temp_c, (float)targetTempC,
+                        damper_pos, fill, end);
+
+    // Kurinātājs pamana FILL! un pēc kāda laika piekrauj malku
+    if (c->auto_refill_kg > 0.0f) {
+        if (fill && !c->fill_pending) {
+            c->fill_pending = true;
+            c->fill_seen_ms = now_ms;
+        }
+        if (c->fill_pending && now_ms - c->fill_seen_ms >= AUTO_REFILL_DELAY_MS) {
+            stove_sim_add_fuel(&c->sim, c->auto_refill_kg);
+            c->auto_refills++;
+            c->fill_pending = false;
+        }
+    }
+
+    if (c->csv && now_ms - c->last_csv_ms >= CSV_PERIOD_MS) {
+        c->last_csv_ms = now_ms;
+        printf("%.1f,%.2f,%.2f,%.2f,%d,%d,%d,%.2f,%.0f,%.1f,%s\n",
+               now_ms / 1000.0, c->sim.sensor_temp_c, c->sim.water_temp_c, c->sim.room_temp_c,
+               temperature, state.targetTemp, getCurrentDamperPosition(), c->sim.fuel_kg,
+               c->sim.heat_release_w, state.errI, damper_mode_label(state.mode));
+    }
+}
+
+static void print_minutes(const char* label, unsigned long ms) {
+    printf("%-26s %.1f min\n", label, ms / 60000.0);
+}
+
+int main(int argc, char** argv) {
+    float hours = 8.0f;
+    bool verbose = false;
+    int gainKp = -1;
+    float gainTauI = -1.0f;
+    float gainTauD = -1.0f;
+    int target = -1;
+    long readInterval = -1;
+    int servoStep = -1;
+    int deadband = -1;
+    bool butterflyMap = false;
+    gain_schedule_t gains = {0};   // --gains punkti; publicē pēc setup()
+    bool telnetClient = false;
+    const char* flashImage = nullptr;
+    int logShowLines = 0;
+    float cascadeRoom = -1.0f;
+    float ff[3] = {-1.0f, -1.0f, -1.0f};
+
+    static sim_context_t ctx;
+    stove_sim_config_t config = stove_sim_default_config();
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--hours") == 0 && hasValue) {
+            hours = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--kp") == 0 && hasValue) {
+            gainKp = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--taui") == 0 && hasValue) {
+            gainTauI = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--taud") == 0 && hasValue) {
+            gainTauD = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--target") == 0 && hasValue) {
+            target = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--read-interval") == 0 && hasValue) {
+            readInterval = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--servo-step") == 0 && hasValue) {
+            servoStep = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--deadband") == 0 && hasValue) {
+            deadband = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--butterfly") == 0) {
+            config.butterfly_damper = true;
+            ctx.butterfly = true;
+        } else if (strcmp(argv[i], "--airflow-map") == 0) {
+            butterflyMap = true;
+        } else if (strcmp(argv[i], "--start-temp") == 0 && hasValue) {
+            config.initial_temp_c = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--fuel") == 0 && hasValue) {
+            config.initial_fuel_kg = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--refill") == 0 && hasValue) {
+            float minutes = 0.0f;
+            float kg = 0.0f;
+            if (sscanf(argv[++i], "%f:%f", &minutes, &kg) == 2 && config.refill_count < STOVE_SIM_MAX_REFILLS) {
+                config.refill_at_ms[config.refill_count] = (unsigned long)(minutes * 60000.0f);
+                config.refill_kg[config.refill_count] = kg;
+                config.refill_count++;
+            }
+        } else if (strcmp(argv[i], "--auto-refill") == 0 && hasValue) {
+            ctx.auto_refill_kg = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--cascade") == 0 && hasValue) {
+            cascadeRoom = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--autotune") == 0 && hasValue) {
+            float minutes = 0.0f;
+            ctx.autotune_step_pct = 20.0f;
+            sscanf(argv[++i], "%f:%f", &minutes, &ctx.autotune_step_pct);
+            ctx.autotune_at_ms = (unsigned long)(minutes * 60000.0f);
+        } else if (strcmp(argv[i], "--gains") == 0 && hasValue) {
+            float tempC = 0.0f;
+            float kpScale = 1.0f;
+            float tauIScale = 1.0f;
+            if (sscanf(argv[++i], "%f:%f:%f", &tempC, &kpScale, &tauIScale) < 2 ||
+                !gain_schedule_set(&gains, tempC, kpScale, tauIScale)) {
+                fprintf(stderr, "Nederigs grafika punkts: %s\n", argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--ff") == 0 && hasValue) {
+            sscanf(argv[++i], "%f:%f:%f", &ff[0], &ff[1], &ff[2]);
+        } else if (strcmp(argv[i], "--outdoor") == 0 && hasValue) {
+            config.outdoor_c = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--telnet") == 0) {
+            telnetClient = true;
+        } else if (strcmp(argv[i], "--flash") == 0 && hasValue) {
+            flashImage = argv[++i];
+        } else if (strcmp(argv[i], "--log-show") == 0 && hasValue) {
+            logShowLines = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            ctx.csv = true;
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "Nezinama opcija: %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    native_console_enabled = verbose;
+    if (flashImage) {
+        native_flash_load(flashImage);
+    }
+    if (verbose || telnetClient) {
+        native_telnet_connect_client();
+    }
+
+    // Sensors jau pirms setup() rāda sākuma temperatūru
+    native_sensor_set_temp_c(config.initial_temp_c);
+    ctx.water_sensor = native_sensor_add(config.initial_temp_c);
+    native_sensor_address(ctx.water_sensor, temperatureChannelAddress[TEMP_CHANNEL_WATER]);
+    ctx.room_sensor = native_sensor_add(config.ambient_c);
+    native_sensor_address(ctx.room_sensor, temperatureChannelAddress[TEMP_CHANNEL_ROOM]);
+    native_firmware_setup();
+
+    // Tāpat kā settings_screen.cpp / loadAllSettings()
+    if (gainKp > 0) kP = gainKp;
+    if (gainTauI > 0.0f) tauI = gainTauI;
+    if (gainTauD > 0.0f) tauD = gainTauD;
+    kI = kP / tauI;
+    kD = kP * tauD;
+    if (target > 0) targetTempC = target;
+    if (readInterval > 0) tempReadIntervalMs = readInterval;
+    if (servoStep > 0) servoStepInterval = servoStep;
+    if (deadband >= 0) servoDeadbandPct = deadband;
+    if (ff[0] >= 0.0f) ffTrendGain = ff[0];
+    if (ff[1] >= 0.0f) ffRefillBoost = ff[1];
+    if (ff[2] >= 0.0f) ffRefillTauS = ff[2];
+    if (gains.count > 0) {
+        damperControlSetGainSchedule(&gains);
+    }
+    if (butterflyMap) {
+        airflow_map_t map = {0};
+        airflow_map_fill_butterfly(&map, damperOpeningToMicros(0), damperOpeningToMicros(100),
+                                   AIRFLOW_MAP_MAX_POINTS);
+        damperControlSetAirflowMap(&map);
+    }
+    if (cascadeRoom > 0.0f) {
+        cascadeEnabled = true;
+        roomTargetC = cascadeRoom;
+    }
+
+    stove_sim_init(&ctx.sim, &config, millis());
+    stove_bench_init(&ctx.bench, millis(), (float)getCurrentDamperPosition());
+
+    if (ctx.csv) {
+        printf("time_s,sensor_c,water_c,room_c,temperature,target_c,damper_pct,fuel_kg,heat_w,errI,mode\n");
+    }
+
+    const bool autotuneRequested = ctx.autotune_at_ms != 0;
+    const uint64_t allocations_before = heap_allocations;
+    const bool awake = native_firmware_run_for((unsigned long)(hours * 3600000.0f), sim_tick, &ctx);
+
+    const uint64_t run_allocations = heap_allocations - allocations_before;
+    native_console_enabled = true;
+    recorderFlush();
+    loggerFlush();
+    if (flashImage && !native_flash_save(flashImage)) {
+        fprintf(stderr, "Nevar saglabat %s\n", flashImage);
+    }
+    if (ctx.csv) {
+        return 0;
+    }
+
+    const stove_bench_t& b = ctx.bench;
+    const native_run_stats_t& stats = native_firmware_stats();
+
+    printf("==== Krasns simulacija: kP=%d tauI=%.1f tauD=%.1f target=%d C ff=%.0f:%.1f:%.0f%s%s%s ====\n",
+           kP, tauI, tauD, targetTempC, ffTrendGain, ffRefillBoost, ffRefillTauS,
+           cascadeEnabled ? " (kaskade)" : "", ctx.butterfly ? " taurinvarsts" : "",
+           airflowMap.count >= 2 ? " +plusmas tabula" : "");
+    for (uint8_t i = 0; i < gainSchedule.count; i++) {
+        printf("%-26s %.1f C: kP x%.2f, tauI x%.2f\n", i == 0 ? "Pastiprinajumu grafiks:" : "",
+               gainSchedule.points[i].tempC, gainSchedule.points[i].kpScale, gainSchedule.points[i].tauIScale);
+    }
+    print_minutes("Simulets laiks:", millis());
+    if (!awake) {
+        print_minutes("Deep sleep pec:", stats.deep_sleep_ms);
+    }
+    if (b.target_reached) {
+        print_minutes("Merkis sasniegts pec:", b.target_reached_ms - b.start_ms);
+    } else {
+        printf("%-26s nav sasniegts\n", "Merkis:");
+    }
+    if (b.settled) {
+        print_minutes("Nostabilizejas pec:", b.settling_ms);
+    } else {
+        printf("%-26s nav nostabilizejies (+-%.1f C)\n", "Nostabilizesanas:", STOVE_BENCH_BAND_C);
+    }
+    printf("%-26s %.2f C\n", "Max parsniegums:", b.max_overshoot_c);
+    printf("%-26s %.0f C*s\n", "Integrala |kluda|:", b.abs_error_integral);
+    printf("%-26s %.0f %% (%u kustibas, %u servo pieslegsanas)\n", "Damper celsh:",
+           b.damper_travel_pct, b.damper_moves, native_servo_attach_count());
+    printf("%-26s %u\n", "Damper virziena mainas:", b.damper_reversals);
+    printf("%-26s vid. %.0f ms, max %lu ms (%u merki)\n", "Servo aizture:",
+           ctx.servo_latency_count ? ctx.servo_latency_sum_ms / ctx.servo_latency_count : 0.0,
+           ctx.servo_latency_max_ms, ctx.servo_latency_count);
+    print_minutes("Laiks FILL! statusa:", b.fill_ms);
+    print_minutes("Laiks END! statusa:", b.end_ms);
+    if (ctx.room_samples > 0) {
+        printf("%-26s %.2f C (min %.2f, max %.2f), vid. |kluda| pret %.1f C: %.2f C\n", "Istaba pec 1 h:",
+               ctx.room_sum_c / ctx.room_samples, ctx.room_min_c, ctx.room_max_c, roomTargetC,
+               ctx.room_abs_error_sum_c / ctx.room_samples);
+    }
+    printf("%-26s %.2f kg (atlikums %.2f kg, piekrausanas %u)\n", "Sadedzinats:",
+           ctx.sim.burned_kg, ctx.sim.fuel_kg, ctx.sim.next_refill + ctx.auto_refills);
+    if (autotuneRequested) {
+        damperControlPrintAutotune(Serial);
+    }
+    const servo_actuator_stats_t servo = damperControlGetServoStats();
+    printf("%-26s %u kustibas, %.0f %% cels, %u pieslegsanas (apvienoti %u, deadband %u)\n",
+           "Servo (firmware):", servo.moves, servo.travelPct, servo.attachCycles,
+           servo.coalesced, servo.suppressed);
+    if (verbose || telnetClient) {
+        const uint32_t lines = native_telnet_lines();
+        printf("%-26s %u rindas, %u B, %u write() (%.2f uz rindu)\n", "Telnet:",
+               lines, native_telnet_bytes(), native_telnet_writes(),
+               lines ? (double)native_telnet_writes() / lines : 0.0);
+    }
+    printf("%-26s %llu (%.0f stunda)\n", "Kaudzes alokacijas:", (unsigned long long)run_allocations,
+           millis() ? run_allocations * 3600000.0 / millis() : 0.0);
+    const native_flash_stats_t flash = native_flash_stats();
+    printf("%-26s %llu B, %u write(), %u sektoru dzesanas, %u parrakstisanas\n", "Flash:",
+           (unsigned long long)flash.bytes_written, flash.writes, flash.sector_erases, flash.overwrites);
+    recorderPrintStatus(Serial);
+    printf("%-26s %u pikstieni, %.1f s skanejis\n", "Buzzer:", ctx.buzzer_beeps, ctx.buzzer_on_ms / 1000.0);
+    printf("%-26s %.1f pamosanas/s\n", "DamperTask:",
+           millis() ? stats.damper_task_iterations * 1000.0 / millis() : 0.0);
+    printf("%-26s %.0f ns\n", "loop() videji:",
+           stats.loop_iterations ? (double)stats.loop_host_ns / stats.loop_iterations : 0.0);
+    if (logShowLines > 0) {
+        printf("---- Flash zurnals ----\n");
+        loggerPrintFlash(Serial, (uint16_t)logShowLines);
+    }
+    return 0;
+}
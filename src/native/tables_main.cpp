@@ -0,0 +1,121 @@
+// Telnet/NVS tabulu (lib/gain_schedule, lib/airflow_map) pārbaude uz host.
+//
+//   pio run -e native_tables && .pio/build/native_tables/program [-v]
+//
+// Tabulas labo telnet "gains"/"airflow" un saglabā NVS; nederīgu tabulu
+// nākamais starts izmet, tāpēc kļūda iekārtā paliktu nepamanīta. Katrs
+// gadījums izsauc set/remove secību un salīdzina rezultātu. Izejas kods 1,
+// ja kāds gadījums neizdodas.
+//
+//   -v   Izdrukā arī izdevušos gadījumus
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "gain_schedule.h"
+#include "airflow_map.h"
+
+static bool verbose = false;
+static int failures = 0;
+
+static void check(const char* name, bool ok) {
+    if (!ok) {
+        failures++;
+        printf("KLUDA  %s\n", name);
+    } else if (verbose) {
+        printf("OK     %s\n", name);
+    }
+}
+
+// Aizstāšana ±0.5 °C robežās nedrīkst izjaukt secību un aizstāj tuvāko punktu
+static void checkGainScheduleReplace() {
+    gain_schedule_t schedule;
+    gain_schedule_clear(&schedule);
+    gain_schedule_set(&schedule, 10.0f, 1.0f, 1.0f);
+    gain_schedule_set(&schedule, 11.0f, 1.0f, 1.0f);
+    gain_schedule_set(&schedule, 10.5f, 1.0f, 1.0f);
+    gain_schedule_set(&schedule, 11.0f, 2.0f, 1.0f);
+    gain_schedule_set(&schedule, 11.4f, 3.0f, 1.0f);
+    check("gain_schedule_set: aizstasana saglaba secibu",
+          gain_schedule_valid(&schedule) && schedule.count == 2 &&
+          schedule.points[0].tempC == 10.0f && schedule.points[1].tempC == 11.0f &&
+          schedule.points[1].kpScale == 3.0f);
+}
+
+// Noraidīts punkts tabulu nemaina
+static void checkGainScheduleReject() {
+    gain_schedule_t schedule;
+    gain_schedule_clear(&schedule);
+    for (uint8_t i = 0; i < GAIN_SCHEDULE_MAX_POINTS; i++) {
+        gain_schedule_set(&schedule, 40.0f + 10.0f * i, 1.0f, 1.0f);
+    }
+    gain_schedule_t before = schedule;
+    check("gain_schedule_set: pilna tabula noraida jaunu punktu",
+          !gain_schedule_set(&schedule, 35.0f, 1.0f, 1.0f) &&
+          memcmp(&before, &schedule, sizeof(schedule)) == 0);
+    check("gain_schedule_set: reizinatajs arpus robezam",
+          !gain_schedule_set(&schedule, 40.0f, GAIN_SCHEDULE_MAX_SCALE * 2, 1.0f) &&
+          memcmp(&before, &schedule, sizeof(schedule)) == 0);
+    check("gain_schedule_remove: punkts ±0.5 C",
+          gain_schedule_remove(&schedule, 50.4f) && schedule.count == GAIN_SCHEDULE_MAX_POINTS - 1 &&
+          gain_schedule_valid(&schedule) && !gain_schedule_remove(&schedule, 50.0f));
+}
+
+// Divi punkti ±0.5 % robežās: aizstāj tuvāko, tā plūsma paliek
+static void checkAirflowMapReplace() {
+    airflow_map_t map;
+    airflow_map_clear(&map);
+    airflow_map_set(&map, 10.0f, 1000.0f);
+    airflow_map_set(&map, 10.9f, 1100.0f);
+    const bool ok = airflow_map_set(&map, 10.5f, 1200.0f);
+    check("airflow_map_set: aizstaj tuvako punktu",
+          ok && airflow_map_valid(&map) && map.count == 2 &&
+          map.points[0].airflowPct == 10.0f && map.points[0].micros == 1000.0f &&
+          map.points[1].airflowPct == 10.9f && map.points[1].micros == 1200.0f);
+}
+
+// Impulsam jāpaliek monotonam; noraidīts punkts tabulu nemaina
+static void checkAirflowMapReject() {
+    airflow_map_t map;
+    airflow_map_clear(&map);
+    airflow_map_set(&map, 0.0f, 1000.0f);
+    airflow_map_set(&map, 50.0f, 1500.0f);
+    airflow_map_set(&map, 100.0f, 2000.0f);
+    airflow_map_t before = map;
+    check("airflow_map_set: nemonotons impulss noraidits",
+          !airflow_map_set(&map, 75.0f, 1400.0f) && memcmp(&before, &map, sizeof(map)) == 0);
+    check("airflow_map_set: aizstasana nemonotona noraidita",
+          !airflow_map_set(&map, 50.2f, 2100.0f) && memcmp(&before, &map, sizeof(map)) == 0);
+    check("airflow_map_remove: punkts ±0.5 %",
+          airflow_map_remove(&map, 49.6f) && map.count == 2 && !airflow_map_remove(&map, 50.0f));
+}
+
+// Tauriņvārsta līkne: derīga, galapunkti sakrīt ar ģeometriju
+static void checkAirflowMapButterfly() {
+    airflow_map_t map;
+    airflow_map_fill_butterfly(&map, 2000.0f, 1000.0f, AIRFLOW_MAP_MAX_POINTS);
+    check("airflow_map_fill_butterfly: deriga tabula",
+          airflow_map_valid(&map) && map.count == AIRFLOW_MAP_MAX_POINTS &&
+          fabsf(airflow_map_micros(&map, 0.0f) - 2000.0f) < 1.0f &&
+          fabsf(airflow_map_micros(&map, 100.0f) - 1000.0f) < 1.0f);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "Nezinama opcija: %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    checkGainScheduleReplace();
+    checkGainScheduleReject();
+    checkAirflowMapReplace();
+    checkAirflowMapReject();
+    checkAirflowMapButterfly();
+
+    printf("Tabulu parbaudes: %d kludas\n", failures);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+// Regulatora trases (lib/recorder) dekoderis: flash attēls vai telnet izvads -> CSV.
+//
+//   pio run -e native_trace && .pio/build/native_trace/program [opcijas] FAILS
+//
+// FAILS ir viens no:
+//   - "spiffs" nodalījuma attēls: esptool.py read_flash 0xDE0000 0x220000 spiffs.bin
+//     vai native_sim --flash fails (arī tikai trases apgabals bez žurnāla)
+//   - telnet "rec dump" izvads (rindas "REC <hex>"), piem. nc <ip> 23 > rec.txt
+//
+//   --list             Tikai sesiju saraksts (sākums, ilgums, paraugi, B/paraugs)
+//   --session N        Tikai N-tā sesija (no 1). Sesija = viens starts līdz deep
+//                      sleep vai restartam (millis() sāk no jauna)
+//
+// CSV kolonnas (visas skaitliskas, mode = damper_mode_t):
+//   time_s,flue_c,flue_raw_c,room_raw_c,target_c,damper_pct,err_p,err_i,err_d,mode,valid,session,unix_time
+// time_s un flue_c ir pirmās, tāpēc native_fire --trace to lasa bez kolonnu opcijām.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include "trace_codec.h"
+#include "trace_file.h"
+
+#define TEMP_C16_SCALE        16
+
+typedef struct {
+    uint32_t samples;
+    uint32_t bytes;          // Bloku baiti (bez flash_ring garuma lauka)
+    uint32_t blocks;
+    uint32_t startMs;
+    uint32_t endMs;
+    uint32_t startUnix;      // 0 = pirms NTP
+} session_t;
+
+static void collectBlock(const uint8_t* data, uint16_t length, void* ctx) {
+    ((std::vector<std::vector<uint8_t>>*)ctx)->push_back(std::vector<uint8_t>(data, data + length));
+}
+
+static void formatUnix(uint32_t unixTime, char* out, size_t size) {
+    if (unixTime == 0) {
+        snprintf(out, size, "-");
+        return;
+    }
+    const time_t t = (time_t)unixTime;
+    struct tm local;
+    localtime_r(&t, &local);
+    strftime(out, size, "%Y-%m-%d %H:%M", &local);
+}
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    bool list = false;
+    long onlySession = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else if (strcmp(argv[i], "--session") == 0 && i + 1 < argc) {
+            onlySession = atol(argv[++i]);
+        } else if (argv[i][0] != '-' && path == NULL) {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "Nezinama opcija: %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (path == NULL) {
+        fprintf(stderr, "Lietojums: %s [--list] [--session N] FAILS\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<std::vector<uint8_t>> blocks;
+    if (trace_file_read(path, collectBlock, &blocks) < 0) {
+        fprintf(stderr, "%s: nav ne flash attels, ne 'rec dump' izvads\n", path);
+        return 1;
+    }
+
+    if (!list) {
+        printf("time_s,flue_c,flue_raw_c,room_raw_c,target_c,damper_pct,err_p,err_i,err_d,mode,valid,session,unix_time\n");
+    }
+
+    std::vector<session_t> sessions;
+    uint32_t badBlocks = 0;
+    for (const std::vector<uint8_t>& block : blocks) {
+        trace_reader_t reader;
+        if (block.size() > TRACE_BLOCK_MAX || !trace_reader_init(&reader, block.data(), (uint16_t)block.size())) {
+            badBlocks++;
+            continue;
+        }
+        // millis() atgriezās atpakaļ - jauns starts
+        if (sessions.empty() || reader.startMs < sessions.back().endMs) {
+            session_t session = {0};
+            session.startMs = reader.startMs;
+            sessions.push_back(session);
+        }
+        session_t& session = sessions.back();
+        session.blocks++;
+        session.bytes += (uint32_t)block.size();
+
+        trace_sample_t sample;
+        while (trace_reader_next(&reader, &sample)) {
+            const uint32_t unixTime = trace_reader_unix_time(&reader, &sample);
+            if (session.startUnix == 0 && unixTime != 0) {
+                session.startUnix = unixTime - (sample.timeMs - session.startMs) / 1000;
+            }
+            session.samples++;
+            session.endMs = sample.timeMs;
+
+            if (list || (onlySession > 0 && (long)sessions.size() != onlySession)) {
+                continue;
+            }
+            const int32_t* f = sample.fields;
+            printf("%.3f,%.4f,%.4f,%.4f,%d,%d,%.4f,%d,%.2f,%d,%d,%u,%u\n",
+                   sample.timeMs / 1000.0,
+                   f[TRACE_FIELD_FLUE] / (double)TEMP_C16_SCALE,
+                   f[TRACE_FIELD_FLUE_RAW] / (double)TEMP_C16_SCALE,
+                   f[TRACE_FIELD_ROOM_RAW] / (double)TEMP_C16_SCALE,
+                   f[TRACE_FIELD_TARGET], f[TRACE_FIELD_DAMPER],
+                   f[TRACE_FIELD_ERR_P] / (double)TEMP_C16_SCALE,
+                   f[TRACE_FIELD_ERR_I],
+                   f[TRACE_FIELD_ERR_D] / 100.0,
+                   f[TRACE_FIELD_MODE], f[TRACE_FIELD_VALID],
+                   (unsigned)sessions.size(), unixTime);
+        }
+        if (reader.remaining != 0) {
+            badBlocks++;
+        }
+    }
+
+    uint32_t totalSamples = 0;
+    uint32_t totalBytes = 0;
+    for (size_t i = 0; i < sessions.size(); i++) {
+        const session_t& s = sessions[i];
+        totalSamples += s.samples;
+        totalBytes += s.bytes;
+        if (list) {
+            char start[32];
+            formatUnix(s.startUnix, start, sizeof(start));
+            printf("Sesija %2zu: %s, no +%.0f s, %.2f h, %u paraugi, %u bloki, %.2f B/paraugs\n",
+                   i + 1, start, s.startMs / 1000.0, (s.endMs - s.startMs) / 3600000.0,
+                   s.samples, s.blocks, s.samples ? (double)s.bytes / s.samples : 0.0);
+        }
+    }
+    fprintf(stderr, "Trase: %zu bloki, %zu sesijas, %u paraugi, %u B (%.2f B/paraugs), %u bojati bloki\n",
+            blocks.size(), sessions.size(), totalSamples, totalBytes,
+            totalSamples ? (double)totalBytes / totalSamples : 0.0, badBlocks);
+    return badBlocks > 0 && totalSamples == 0 ? 1 : 0;
+}